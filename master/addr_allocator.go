@@ -64,16 +64,22 @@ func (allocator *AddrAllocator) HandleRequest(ctx *Context) LeaseResult {
 	}
 
 	switch ctx.RequestType {
-	case ContextMsg_Discover:
+	case ContextMsg_Discover, ContextMsg_RapidCommit:
 		return allocator.planLease(ctx)
 	case ContextMsg_Request:
 		return allocator.allocateLease(ctx)
+	case ContextMsg_CommitOffer:
+		return allocator.commitOfferedLease(ctx)
 	case ContextMsg_Release:
 		return allocator.releaseLease(ctx)
 	case ContextMsg_Decline:
 		return allocator.declineLease(ctx)
 	case ContextMsg_ConflictIP:
 		return allocator.declineConflictIP(ctx)
+	case ContextMsg_AcquireBlock:
+		return allocator.grantBlock(ctx)
+	case ContextMsg_ReleaseBlock:
+		return allocator.releaseBlock(ctx)
 	default:
 		panic("Context request type is invalid")
 	}
@@ -82,7 +88,7 @@ func (allocator *AddrAllocator) HandleRequest(ctx *Context) LeaseResult {
 func (allocator *AddrAllocator) planLease(ctx *Context) LeaseResult {
 	if lease, err := allocator.planLeaseInSubnet(ctx); err == nil {
 		util.Logger().Debug("discover addr %s for client with mac %v in subnet %v", lease.Address.String(), lease.Mac, lease.SubnetId)
-		return ToLeaseResult(lease)
+		return allocator.planCandidates(ctx, lease)
 	} else {
 		util.Logger().Warn("discover lease in subnet %v failed:%s", ctx.SubnetID, err.Error())
 	}
@@ -92,7 +98,7 @@ func (allocator *AddrAllocator) planLease(ctx *Context) LeaseResult {
 		ctx.SubnetID = subnetID
 		if lease, _ := allocator.planLeaseInSubnet(ctx); lease != nil {
 			util.Logger().Debug("discover addr %s for client with mac %v in shared subnet %v", lease.Address.String(), lease.Mac, lease.SubnetId)
-			return ToLeaseResult(lease)
+			return allocator.planCandidates(ctx, lease)
 		}
 	}
 
@@ -107,6 +113,20 @@ func (allocator *AddrAllocator) planLeaseInSubnet(ctx *Context) (*Lease, error)
 	return allocator.engines[ctx.SubnetID].PlanLease(ctx)
 }
 
+//a rapid commit stores every lease it plans, so it never gets candidates
+func (allocator *AddrAllocator) planCandidates(ctx *Context, lease *Lease) LeaseResult {
+	if ctx.CandidateCount <= 1 || ctx.RequestType != ContextMsg_Discover {
+		return ToLeaseResult(lease)
+	}
+
+	engineLock := allocator.engineLocks[lease.SubnetId]
+	engineLock.Lock()
+	defer engineLock.Unlock()
+	candidates := allocator.engines[lease.SubnetId].PlanCandidates(ctx, lease)
+	util.Logger().Debug("discover %v candidate addrs for client with mac %v in subnet %v", len(candidates), ctx.Mac, lease.SubnetId)
+	return ToCandidateResult(candidates)
+}
+
 func (allocator *AddrAllocator) allocateLease(ctx *Context) LeaseResult {
 	if lease, err := allocator.allocateLeaseInSubnet(ctx); err == nil {
 		util.Logger().Debug("allocate addr %s for client with mac %v in subnet %v", lease.Address.String(), lease.Mac, lease.SubnetId)
@@ -139,6 +159,20 @@ func (allocator *AddrAllocator) allocateLeaseInSubnet(ctx *Context) (*Lease, err
 	return allocator.engines[ctx.SubnetID].AllocateLease(ctx)
 }
 
+func (allocator *AddrAllocator) commitOfferedLease(ctx *Context) LeaseResult {
+	engineLock := allocator.engineLocks[ctx.SubnetID]
+	engineLock.Lock()
+	defer engineLock.Unlock()
+	lease, err := allocator.engines[ctx.SubnetID].CommitOfferedLease(ctx)
+	if err != nil {
+		util.Logger().Warn("commit offered addr %v in subnet %v failed:%s", ctx.RequestAddr, ctx.SubnetID, err.Error())
+		return ToLeaseResult(nil)
+	}
+
+	util.Logger().Debug("commit offered addr %s for client with mac %v in subnet %v", lease.Address.String(), lease.Mac, lease.SubnetId)
+	return ToLeaseResult(lease)
+}
+
 func (allocator *AddrAllocator) releaseLease(ctx *Context) LeaseResult {
 	if err := allocator.releaseLeaseInSubnet(ctx); err == nil {
 		util.Logger().Debug("release addr %v for subnet %v successed", ctx.RequestAddr, ctx.SubnetID)
@@ -207,6 +241,29 @@ func (allocator *AddrAllocator) declineConflictIP(ctx *Context) LeaseResult {
 	return LeaseResult{Succeed: true}
 }
 
+func (allocator *AddrAllocator) grantBlock(ctx *Context) LeaseResult {
+	engineLock := allocator.engineLocks[ctx.SubnetID]
+	engineLock.Lock()
+	defer engineLock.Unlock()
+	leases, err := allocator.engines[ctx.SubnetID].GrantBlock(ctx)
+	if err != nil {
+		util.Logger().Warn("grant block in subnet %v failed:%s", ctx.SubnetID, err.Error())
+		return ToLeaseResult(nil)
+	}
+
+	util.Logger().Debug("grant %v addrs in subnet %v", len(leases), ctx.SubnetID)
+	return ToBlockResult(leases)
+}
+
+func (allocator *AddrAllocator) releaseBlock(ctx *Context) LeaseResult {
+	engineLock := allocator.engineLocks[ctx.SubnetID]
+	engineLock.Lock()
+	defer engineLock.Unlock()
+	allocator.engines[ctx.SubnetID].ReleaseBlock(ctx)
+	util.Logger().Debug("release %v granted addrs in subnet %v", len(ctx.BlockAddrs), ctx.SubnetID)
+	return LeaseResult{Succeed: true}
+}
+
 func (allocator *AddrAllocator) Stop() {
 	LeaseDBPoolInstance().Stop()
 }
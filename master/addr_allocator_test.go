@@ -0,0 +1,45 @@
+package kea
+
+import (
+	"kea/util"
+	"sync"
+	"testing"
+
+	ut "cement/unittest"
+)
+
+type planOnlyEngine struct {
+	Engine
+	candidatePlans int
+}
+
+func (e *planOnlyEngine) PlanLease(ctx *Context) (*Lease, error) {
+	return &Lease{Address: util.IPv4FromString("10.0.0.1"), SubnetId: ctx.SubnetID}, nil
+}
+
+func (e *planOnlyEngine) PlanCandidates(ctx *Context, planned *Lease) []*Lease {
+	e.candidatePlans += 1
+	return []*Lease{planned, &Lease{Address: util.IPv4FromString("10.0.0.2"), SubnetId: planned.SubnetId}}
+}
+
+func TestRapidCommitConflictRetry(t *testing.T) {
+	engine := &planOnlyEngine{}
+	allocator := &AddrAllocator{
+		engines:         map[SubnetID]Engine{SubnetID(1): engine},
+		engineLocks:     map[SubnetID]*sync.Mutex{SubnetID(1): &sync.Mutex{}},
+		sharedSubnetMgr: newSharedSubnetMgr(),
+	}
+
+	//the retry after a ping conflict asks for candidates, a rapid commit
+	//must not store leases for them
+	ctx := &Context{RequestType: ContextMsg_RapidCommit, SubnetID: SubnetID(1), CandidateCount: 4}
+	result := allocator.HandleRequest(ctx)
+	ut.Equal(t, result.Succeed, true)
+	ut.Equal(t, engine.candidatePlans, 0)
+	ut.Equal(t, len(result.Addrs), 0)
+
+	ctx.RequestType = ContextMsg_Discover
+	result = allocator.HandleRequest(ctx)
+	ut.Equal(t, engine.candidatePlans, 1)
+	ut.Equal(t, len(result.Addrs), 2)
+}
@@ -31,11 +31,15 @@ const _ = proto.ProtoPackageIsVersion2 // please upgrade the proto package
 type ContextMsg_RequestType int32
 
 const (
-	ContextMsg_Discover   ContextMsg_RequestType = 0
-	ContextMsg_Request    ContextMsg_RequestType = 1
-	ContextMsg_Release    ContextMsg_RequestType = 2
-	ContextMsg_Decline    ContextMsg_RequestType = 3
-	ContextMsg_ConflictIP ContextMsg_RequestType = 4
+	ContextMsg_Discover     ContextMsg_RequestType = 0
+	ContextMsg_Request      ContextMsg_RequestType = 1
+	ContextMsg_Release      ContextMsg_RequestType = 2
+	ContextMsg_Decline      ContextMsg_RequestType = 3
+	ContextMsg_ConflictIP   ContextMsg_RequestType = 4
+	ContextMsg_AcquireBlock ContextMsg_RequestType = 5
+	ContextMsg_ReleaseBlock ContextMsg_RequestType = 6
+	ContextMsg_CommitOffer  ContextMsg_RequestType = 7
+	ContextMsg_RapidCommit  ContextMsg_RequestType = 8
 )
 
 var ContextMsg_RequestType_name = map[int32]string{
@@ -44,13 +48,21 @@ var ContextMsg_RequestType_name = map[int32]string{
 	2: "Release",
 	3: "Decline",
 	4: "ConflictIP",
+	5: "AcquireBlock",
+	6: "ReleaseBlock",
+	7: "CommitOffer",
+	8: "RapidCommit",
 }
 var ContextMsg_RequestType_value = map[string]int32{
-	"Discover":   0,
-	"Request":    1,
-	"Release":    2,
-	"Decline":    3,
-	"ConflictIP": 4,
+	"Discover":     0,
+	"Request":      1,
+	"Release":      2,
+	"Decline":      3,
+	"ConflictIP":   4,
+	"AcquireBlock": 5,
+	"ReleaseBlock": 6,
+	"CommitOffer":  7,
+	"RapidCommit":  8,
 }
 
 func (x ContextMsg_RequestType) String() string {
@@ -59,12 +71,16 @@ func (x ContextMsg_RequestType) String() string {
 func (ContextMsg_RequestType) EnumDescriptor() ([]byte, []int) { return fileDescriptor0, []int{0, 0} }
 
 type ContextMsg struct {
-	RequestType ContextMsg_RequestType `protobuf:"varint,1,opt,name=requestType,enum=kea.ContextMsg_RequestType" json:"requestType,omitempty"`
-	SubnetID    uint32                 `protobuf:"varint,2,opt,name=subnetID" json:"subnetID,omitempty"`
-	ClientID    []byte                 `protobuf:"bytes,3,opt,name=clientID,proto3" json:"clientID,omitempty"`
-	Mac         []byte                 `protobuf:"bytes,4,opt,name=mac,proto3" json:"mac,omitempty"`
-	RequestAddr uint32                 `protobuf:"varint,5,opt,name=requestAddr" json:"requestAddr,omitempty"`
-	HostName    string                 `protobuf:"bytes,6,opt,name=hostName" json:"hostName,omitempty"`
+	RequestType    ContextMsg_RequestType `protobuf:"varint,1,opt,name=requestType,enum=kea.ContextMsg_RequestType" json:"requestType,omitempty"`
+	SubnetID       uint32                 `protobuf:"varint,2,opt,name=subnetID" json:"subnetID,omitempty"`
+	ClientID       []byte                 `protobuf:"bytes,3,opt,name=clientID,proto3" json:"clientID,omitempty"`
+	Mac            []byte                 `protobuf:"bytes,4,opt,name=mac,proto3" json:"mac,omitempty"`
+	RequestAddr    uint32                 `protobuf:"varint,5,opt,name=requestAddr" json:"requestAddr,omitempty"`
+	HostName       string                 `protobuf:"bytes,6,opt,name=hostName" json:"hostName,omitempty"`
+	BlockSize      uint32                 `protobuf:"varint,7,opt,name=blockSize" json:"blockSize,omitempty"`
+	BlockAddrs     []uint32               `protobuf:"varint,8,rep,packed,name=blockAddrs" json:"blockAddrs,omitempty"`
+	BlockLifeTime  uint32                 `protobuf:"varint,9,opt,name=blockLifeTime" json:"blockLifeTime,omitempty"`
+	CandidateCount uint32                 `protobuf:"varint,10,opt,name=candidateCount" json:"candidateCount,omitempty"`
 }
 
 func (m *ContextMsg) Reset()                    { *m = ContextMsg{} }
@@ -80,20 +96,26 @@ func init() {
 func init() { proto.RegisterFile("context.proto", fileDescriptor0) }
 
 var fileDescriptor0 = []byte{
-	// 234 bytes of a gzipped FileDescriptorProto
-	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x09, 0x6e, 0x88, 0x02, 0xff, 0x4c, 0x90, 0xb1, 0x4e, 0xc3, 0x30,
-	0x10, 0x86, 0x49, 0x52, 0x4a, 0xb9, 0xb4, 0x95, 0x75, 0x93, 0x05, 0x4b, 0xd5, 0x89, 0x29, 0x03,
-	0xcc, 0x0c, 0x88, 0x2c, 0x1d, 0x40, 0xc8, 0xe2, 0x05, 0x5c, 0xf7, 0x80, 0x88, 0xd4, 0x2e, 0xb6,
-	0x8b, 0xe0, 0x89, 0x78, 0x4d, 0x6c, 0xb7, 0x72, 0xb3, 0xf9, 0xbb, 0xef, 0xf7, 0xe9, 0xd7, 0xc1,
-	0x4c, 0x19, 0xed, 0xe9, 0xc7, 0x37, 0x3b, 0x6b, 0xbc, 0xc1, 0xea, 0x93, 0xe4, 0xf2, 0xaf, 0x04,
-	0x78, 0x3c, 0x8c, 0x9f, 0xdc, 0x3b, 0xde, 0x43, 0x6d, 0xe9, 0x6b, 0x4f, 0xce, 0xbf, 0xfe, 0xee,
-	0x88, 0x17, 0x8b, 0xe2, 0x66, 0x7e, 0x7b, 0xdd, 0x84, 0x64, 0x73, 0x4a, 0x35, 0xe2, 0x14, 0x11,
-	0xc3, 0x3c, 0x5e, 0xc1, 0xc4, 0xed, 0xd7, 0x9a, 0xfc, 0xaa, 0xe5, 0x65, 0xf8, 0x3b, 0x13, 0x99,
-	0xa3, 0x53, 0x7d, 0x47, 0x3a, 0xba, 0x2a, 0xb8, 0xa9, 0xc8, 0x8c, 0x0c, 0xaa, 0xad, 0x54, 0x7c,
-	0x94, 0xc6, 0xf1, 0x89, 0x8b, 0x5c, 0xe4, 0x61, 0xb3, 0xb1, 0xfc, 0x3c, 0x2d, 0x1b, 0x8e, 0xe2,
-	0xbe, 0x0f, 0xe3, 0xfc, 0xb3, 0xdc, 0x12, 0x1f, 0x07, 0x7d, 0x29, 0x32, 0x2f, 0x05, 0xd4, 0x83,
-	0x8e, 0x38, 0x85, 0x49, 0xdb, 0x39, 0x65, 0xbe, 0xc9, 0xb2, 0x33, 0xac, 0xe1, 0xe2, 0x28, 0x59,
-	0x71, 0x80, 0x9e, 0xa4, 0x23, 0x56, 0x46, 0x68, 0x29, 0x94, 0xd2, 0xc4, 0x2a, 0x9c, 0xa7, 0xc3,
-	0xbc, 0xf5, 0x9d, 0xf2, 0xab, 0x17, 0x36, 0x5a, 0x8f, 0xd3, 0xd5, 0xee, 0xfe, 0x03, 0x00, 0x00,
-	0xff, 0xff, 0x86, 0x7d, 0x08, 0xb7, 0x46, 0x01, 0x00, 0x00,
+	// 336 bytes of a gzipped FileDescriptorProto
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0x5d, 0x92, 0xcd, 0x4e, 0xc3, 0x30,
+	0x10, 0x84, 0x49, 0xd3, 0x9f, 0x74, 0xd3, 0x16, 0xcb, 0x27, 0x0b, 0x10, 0xaa, 0x2a, 0x84, 0x38,
+	0xf5, 0x00, 0x67, 0x0e, 0xa5, 0xbd, 0x54, 0xe2, 0x4f, 0xa1, 0x2f, 0x90, 0x3a, 0x1b, 0xb0, 0x9a,
+	0xc4, 0x6d, 0xe2, 0x20, 0xe0, 0x49, 0x78, 0x56, 0x4e, 0xd8, 0x4e, 0x95, 0x06, 0x6e, 0x9e, 0x6f,
+	0x66, 0x27, 0xd6, 0xc6, 0x30, 0xe4, 0x32, 0x53, 0xf8, 0xa1, 0xa6, 0xdb, 0x5c, 0x2a, 0x49, 0xdd,
+	0x0d, 0x86, 0x93, 0x1f, 0x17, 0x60, 0x5e, 0xe1, 0x87, 0xe2, 0x95, 0xde, 0x82, 0x9f, 0xe3, 0xae,
+	0xc4, 0x42, 0xad, 0x3e, 0xb7, 0xc8, 0x9c, 0xb1, 0x73, 0x35, 0xba, 0x3e, 0x9d, 0xea, 0xe4, 0xf4,
+	0x90, 0x9a, 0x06, 0x87, 0x48, 0xd0, 0xcc, 0xd3, 0x13, 0xf0, 0x8a, 0x72, 0x9d, 0xa1, 0x5a, 0x2e,
+	0x58, 0x4b, 0xcf, 0x0e, 0x83, 0x5a, 0x1b, 0x8f, 0x27, 0x02, 0x33, 0xe3, 0xb9, 0xda, 0x1b, 0x04,
+	0xb5, 0xa6, 0x04, 0xdc, 0x34, 0xe4, 0xac, 0x6d, 0xb1, 0x39, 0xd2, 0x71, 0x7d, 0x91, 0x59, 0x14,
+	0xe5, 0xac, 0x63, 0xcb, 0x9a, 0xc8, 0xf4, 0xbd, 0xc9, 0x42, 0x3d, 0x86, 0x29, 0xb2, 0xae, 0xb6,
+	0xfb, 0x41, 0xad, 0xe9, 0x19, 0xf4, 0xd7, 0x89, 0xe4, 0x9b, 0x17, 0xf1, 0x85, 0xac, 0x67, 0x67,
+	0x0f, 0x80, 0x9e, 0x03, 0x58, 0x61, 0x6a, 0x0a, 0xe6, 0x8d, 0x5d, 0x6d, 0x37, 0x08, 0xbd, 0x80,
+	0xa1, 0x55, 0xf7, 0x22, 0xc6, 0x95, 0xd0, 0xf5, 0x7d, 0xdb, 0xf0, 0x17, 0xd2, 0x4b, 0x18, 0xf1,
+	0x30, 0x8b, 0x44, 0x14, 0x2a, 0x9c, 0xcb, 0x32, 0x53, 0x0c, 0x6c, 0xec, 0x1f, 0x9d, 0x7c, 0x3b,
+	0xe0, 0x37, 0x16, 0x46, 0x07, 0xe0, 0x2d, 0x44, 0xc1, 0xe5, 0x3b, 0xe6, 0xe4, 0x88, 0xfa, 0xd0,
+	0xdb, 0x9b, 0xc4, 0xa9, 0x44, 0x82, 0x61, 0x81, 0xa4, 0x65, 0xc4, 0x02, 0xf5, 0x86, 0x32, 0x24,
+	0x2e, 0x1d, 0xd9, 0xbf, 0x14, 0x27, 0x82, 0xab, 0xe5, 0x33, 0x69, 0xeb, 0x85, 0x0d, 0x66, 0x7c,
+	0x57, 0x8a, 0x1c, 0xef, 0xcc, 0xa5, 0x48, 0xc7, 0x90, 0xfd, 0x6c, 0x45, 0xba, 0xf4, 0x18, 0xfc,
+	0xb9, 0x4c, 0x53, 0xa1, 0x9e, 0xe2, 0x58, 0x7f, 0xab, 0x67, 0x40, 0x10, 0x6e, 0x45, 0x54, 0x51,
+	0xe2, 0xad, 0xbb, 0xf6, 0x21, 0xdc, 0xfc, 0x02, 0x84, 0x0f, 0x60, 0xae, 0x19, 0x02, 0x00, 0x00,
 }
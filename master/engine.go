@@ -20,6 +20,7 @@ var ErrNotWantReservedAddr = errors.New("request addr is not same with reserved"
 var ErrWantAddressInOtherSubnet = errors.New("request addr is not belongs to this subnet")
 var ErrDeclineConflictAddr = errors.New("decline conflict ip has beed allocated")
 var ErrDeclineNotExistAddr = errors.New("decline lease doesn't exist")
+var ErrGrantWithoutSize = errors.New("grant block without size")
 
 type SubnetEngine struct {
 	leaseManager LeaseManager
@@ -74,6 +75,23 @@ func (e *SubnetEngine) PlanLease(ctx *Context) (*Lease, error) {
 	return e.allocateUnreservedLease(ctx)
 }
 
+//more free addresses besides planned one, the slave pings all of them at once
+//and offers the first silent one. nothing is stored since it's still a plan
+func (e *SubnetEngine) PlanCandidates(ctx *Context, planned *Lease) []*Lease {
+	candidates := []*Lease{planned}
+	maxAddrCount := e.subnet.Capacity()
+	for i := uint32(0); i < maxAddrCount && uint32(len(candidates)) < ctx.CandidateCount; i++ {
+		addr := e.allocator.PickAddr()
+		if addr.Equal(planned.Address) || e.addressIsReserved(addr, ctx.Mac) {
+			continue
+		}
+		if lease, err := e.allocateLeaseWithAddr(addr, ctx); err == nil {
+			candidates = append(candidates, lease)
+		}
+	}
+	return candidates
+}
+
 func (e *SubnetEngine) findOldLease(ctx *Context) *Lease {
 	if len(ctx.ClientID) != 0 {
 		if lease := e.leaseManager.GetLeaseWithClient(ctx.ClientID); lease != nil {
@@ -124,6 +142,30 @@ func (e *SubnetEngine) AllocateLease(ctx *Context) (*Lease, error) {
 	return newLease, err
 }
 
+//commit an address this engine planned for the same client in its discover,
+//the slave already picked the subnet so the shared network isn't searched
+//and the plan isn't redone, only a lease taken meanwhile is refused
+func (e *SubnetEngine) CommitOfferedLease(ctx *Context) (*Lease, error) {
+	if ctx.RequestAddr == nil {
+		return nil, ErrRequestWithoutTarget
+	}
+
+	if e.addressIsReserved(ctx.RequestAddr, ctx.Mac) {
+		return nil, ErrWantReservedAddress
+	}
+
+	oldLease := e.findOldLease(ctx)
+	if oldLease != nil && oldLease.Address.Equal(ctx.RequestAddr) {
+		return e.renewLease(oldLease, ctx), nil
+	}
+
+	newLease, err := e.allocateLeaseWithAddr(ctx.RequestAddr, ctx)
+	if oldLease != nil && newLease != nil {
+		e.leaseManager.DeleteLease(oldLease.SubnetId, oldLease.Address)
+	}
+	return newLease, err
+}
+
 func (e *SubnetEngine) renewLease(lease *Lease, ctx *Context) *Lease {
 	newLease := *lease
 	newLease.SubnetId = e.subnet.Id
@@ -136,7 +178,7 @@ func (e *SubnetEngine) renewLease(lease *Lease, ctx *Context) *Lease {
 	newLease.ValidLifeTime = e.subnet.ValidLifeTime
 	newLease.HostName = ctx.HostName
 
-	if ctx.RequestType == ContextMsg_Request {
+	if ctx.CommitsLease() {
 		e.leaseManager.UpdateLease(&newLease)
 	}
 
@@ -159,14 +201,17 @@ func (e *SubnetEngine) allocateLeaseWithAddr(ip net.IP, ctx *Context) (*Lease, e
 			RebindTime:          e.subnet.RebindTime,
 		}
 
-		if ctx.RequestType == ContextMsg_Request {
+		if ctx.CommitsLease() {
 			e.leaseManager.AddLease(newLease)
 		}
 
 		return newLease, nil
 	}
 
-	if oldLease.IsExpired() == false {
+	//address granted to a slave is committed by the request of the client it offered to
+	if oldLease.IsExpired() == false &&
+		(oldLease.State != Granted ||
+			(ctx.RequestType != ContextMsg_Request && ctx.RequestType != ContextMsg_CommitOffer)) {
 		return nil, ErrWantUsedAddress
 	} else {
 		return e.renewLease(oldLease, ctx), nil
@@ -257,3 +302,54 @@ func (e *SubnetEngine) DeclineConflictIP(ctx *Context) error {
 		return nil
 	}
 }
+
+func (e *SubnetEngine) GrantBlock(ctx *Context) ([]*Lease, error) {
+	if ctx.BlockSize == 0 {
+		return nil, ErrGrantWithoutSize
+	}
+
+	var leases []*Lease
+	maxAddrCount := e.subnet.Capacity()
+	for i := uint32(0); i < maxAddrCount && uint32(len(leases)) < ctx.BlockSize; i++ {
+		addr := e.allocator.PickAddr()
+		if e.addressIsReserved(addr, nil) {
+			continue
+		}
+
+		oldLease := e.leaseManager.GetLeaseWithIp(addr)
+		if oldLease != nil && oldLease.IsExpired() == false {
+			continue
+		}
+
+		lease := &Lease{
+			Address:             addr,
+			State:               Granted,
+			ValidLifeTime:       ctx.BlockLifeTime,
+			SubnetId:            e.subnet.Id,
+			ClientLastTransTime: time.Now(),
+			RenewTime:           e.subnet.RenewTime,
+			RebindTime:          e.subnet.RebindTime,
+		}
+		if oldLease != nil {
+			e.leaseManager.UpdateLease(lease)
+		} else {
+			e.leaseManager.AddLease(lease)
+		}
+		leases = append(leases, lease)
+	}
+
+	if len(leases) == 0 {
+		return nil, ErrNoAddressLeft
+	}
+	return leases, nil
+}
+
+func (e *SubnetEngine) ReleaseBlock(ctx *Context) error {
+	for _, addr := range ctx.BlockAddrs {
+		lease := e.leaseManager.GetLeaseWithIp(addr)
+		if lease != nil && lease.State == Granted {
+			e.leaseManager.DeleteLease(lease.SubnetId, lease.Address)
+		}
+	}
+	return nil
+}
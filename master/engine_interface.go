@@ -3,6 +3,7 @@ package kea
 import (
 	"kea/util"
 	"net"
+	"time"
 )
 
 type Allocator interface {
@@ -16,6 +17,19 @@ type Context struct {
 	Mac         net.HardwareAddr
 	RequestAddr net.IP
 	HostName    string
+
+	BlockSize     uint32
+	BlockAddrs    []net.IP
+	BlockLifeTime time.Duration
+
+	CandidateCount uint32
+}
+
+//the lease is stored for request types which end an exchange with an ack
+func (ctx *Context) CommitsLease() bool {
+	return ctx.RequestType == ContextMsg_Request ||
+		ctx.RequestType == ContextMsg_CommitOffer ||
+		ctx.RequestType == ContextMsg_RapidCommit
 }
 
 func FromContextMsg(msg *ContextMsg) *Context {
@@ -26,7 +40,25 @@ func FromContextMsg(msg *ContextMsg) *Context {
 		Mac:         net.HardwareAddr(msg.Mac),
 		RequestAddr: util.IPv4FromLong(msg.RequestAddr),
 		HostName:    msg.HostName,
+
+		BlockSize:     msg.BlockSize,
+		BlockAddrs:    blockAddrsFromMsg(msg.BlockAddrs),
+		BlockLifeTime: time.Duration(msg.BlockLifeTime) * time.Second,
+
+		CandidateCount: msg.CandidateCount,
+	}
+}
+
+func blockAddrsFromMsg(addrs []uint32) []net.IP {
+	if len(addrs) == 0 {
+		return nil
+	}
+
+	ips := make([]net.IP, 0, len(addrs))
+	for _, addr := range addrs {
+		ips = append(ips, util.IPv4FromLong(addr))
 	}
+	return ips
 }
 
 type Engine interface {
@@ -34,10 +66,14 @@ type Engine interface {
 	LeaseManager() LeaseManager
 	SetHostManager(hostManager HostManager)
 	PlanLease(ctx *Context) (*Lease, error)
+	PlanCandidates(ctx *Context, planned *Lease) []*Lease
 	AllocateLease(ctx *Context) (*Lease, error)
+	CommitOfferedLease(ctx *Context) (*Lease, error)
 	ReleaseLease(ctx *Context) error
 	DeclineLease(ctx *Context) error
 	DeclineConflictIP(ctx *Context) error
+	GrantBlock(ctx *Context) ([]*Lease, error)
+	ReleaseBlock(ctx *Context) error
 }
 
 type Configurable interface {
@@ -14,6 +14,7 @@ const (
 	Normal           LeaseState = 0
 	Declined                    = 1
 	ExpiredReclaimed            = 2
+	Granted                     = 3 //handed to a slave which offers it by itself
 )
 
 type Lease struct {
@@ -74,3 +75,27 @@ func ToLeaseResult(lease *Lease) LeaseResult {
 		}
 	}
 }
+
+func ToBlockResult(leases []*Lease) LeaseResult {
+	if len(leases) == 0 {
+		return ToLeaseResult(nil)
+	}
+
+	addrs := make([]uint32, 0, len(leases))
+	for _, lease := range leases {
+		addrs = append(addrs, util.IPv4ToLong(lease.Address))
+	}
+	return LeaseResult{
+		Succeed:  true,
+		SubnetID: uint32(leases[0].SubnetId),
+		Addrs:    addrs,
+	}
+}
+
+func ToCandidateResult(leases []*Lease) LeaseResult {
+	result := ToLeaseResult(leases[0])
+	for _, lease := range leases {
+		result.Addrs = append(result.Addrs, util.IPv4ToLong(lease.Address))
+	}
+	return result
+}
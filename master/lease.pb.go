@@ -14,9 +14,10 @@ var _ = fmt.Errorf
 var _ = math.Inf
 
 type LeaseResult struct {
-	Succeed  bool   `protobuf:"varint,1,opt,name=succeed" json:"succeed,omitempty"`
-	Addr     uint32 `protobuf:"varint,2,opt,name=addr" json:"addr,omitempty"`
-	SubnetID uint32 `protobuf:"varint,3,opt,name=subnetID" json:"subnetID,omitempty"`
+	Succeed  bool     `protobuf:"varint,1,opt,name=succeed" json:"succeed,omitempty"`
+	Addr     uint32   `protobuf:"varint,2,opt,name=addr" json:"addr,omitempty"`
+	SubnetID uint32   `protobuf:"varint,3,opt,name=subnetID" json:"subnetID,omitempty"`
+	Addrs    []uint32 `protobuf:"varint,4,rep,packed,name=addrs" json:"addrs,omitempty"`
 }
 
 func (m *LeaseResult) Reset()                    { *m = LeaseResult{} }
@@ -31,13 +32,13 @@ func init() {
 func init() { proto.RegisterFile("lease.proto", fileDescriptor1) }
 
 var fileDescriptor1 = []byte{
-	// 113 bytes of a gzipped FileDescriptorProto
-	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x09, 0x6e, 0x88, 0x02, 0xff, 0xe2, 0xe2, 0xce, 0x49, 0x4d, 0x2c,
-	0x4e, 0xd5, 0x2b, 0x28, 0xca, 0x2f, 0xc9, 0x17, 0x62, 0xce, 0x4e, 0x4d, 0x54, 0x0a, 0xe7, 0xe2,
+	// 123 bytes of a gzipped FileDescriptorProto
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0xe3, 0xe2, 0xce, 0x49, 0x4d, 0x2c,
+	0x4e, 0xd5, 0x2b, 0x28, 0xca, 0x2f, 0xc9, 0x17, 0x62, 0xce, 0x4e, 0x4d, 0x54, 0xca, 0xe5, 0xe2,
 	0xf6, 0x01, 0x89, 0x05, 0xa5, 0x16, 0x97, 0xe6, 0x94, 0x08, 0x49, 0x70, 0xb1, 0x17, 0x97, 0x26,
 	0x27, 0xa7, 0xa6, 0xa6, 0x48, 0x30, 0x2a, 0x30, 0x6a, 0x70, 0x04, 0xc1, 0xb8, 0x42, 0x42, 0x5c,
 	0x2c, 0x89, 0x29, 0x29, 0x45, 0x12, 0x4c, 0x40, 0x61, 0xde, 0x20, 0x30, 0x5b, 0x48, 0x8a, 0x8b,
-	0xa3, 0xb8, 0x34, 0x29, 0x2f, 0xb5, 0xc4, 0xd3, 0x45, 0x82, 0x19, 0x2c, 0x0e, 0xe7, 0x27, 0xb1,
-	0x81, 0x2d, 0x31, 0x06, 0x04, 0x00, 0x00, 0xff, 0xff, 0x92, 0x5f, 0x24, 0x8e, 0x73, 0x00, 0x00,
-	0x00,
+	0xa3, 0xb8, 0x34, 0x29, 0x2f, 0xb5, 0xc4, 0xd3, 0x45, 0x82, 0x19, 0x2c, 0x0e, 0xe7, 0x0b, 0x89,
+	0x70, 0xb1, 0x82, 0xd4, 0x14, 0x4b, 0xb0, 0x28, 0x30, 0x03, 0x25, 0x20, 0x9c, 0x24, 0x36, 0xb0,
+	0xd5, 0xc6, 0x00, 0x1d, 0x1c, 0x6e, 0xd5, 0x89, 0x00, 0x00, 0x00,
 }
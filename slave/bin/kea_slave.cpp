@@ -2,6 +2,7 @@
 #include <kea/controller/cmd_server.h>
 #include <kea/statistics/pkt_statistic.h>
 #include <kea/version.h>
+#include <kea/util/thread_affinity.h>
 
 #include <gflags/gflags.h>
 
@@ -28,8 +29,19 @@ int main(int argc, char** argv) {
     std::unique_ptr<CmdServer> cmd_server(new CmdServer(FLAGS_port));
     cmd_server->registerHandler("stop", dhcp_server.get());
     cmd_server->registerHandler("reconfig", dhcp_server.get());
+    cmd_server->registerHandler("invalidate_lease_cache", dhcp_server.get());
+    cmd_server->registerHandler("inflight_stats", dhcp_server.get());
+    cmd_server->registerHandler("admission_stats", dhcp_server.get());
+    cmd_server->registerHandler("queue_stats", dhcp_server.get());
+    cmd_server->registerHandler("set_workers", dhcp_server.get());
+    cmd_server->registerHandler("subnet_add", dhcp_server.get());
+    cmd_server->registerHandler("subnet_update", dhcp_server.get());
+    cmd_server->registerHandler("subnet_del", dhcp_server.get());
+    cmd_server->registerHandler("subnet_option_set", dhcp_server.get());
+    cmd_server->registerHandler("subnet_option_del", dhcp_server.get());
     cmd_server->registerHandler("statis_lps", &Statistics::instance());
 
+    ThreadAffinity::instance().pinCurrent(TC_CONTROL);
     cmd_server->run();
 
     return 0;
@@ -0,0 +1,93 @@
+#include <kea/util/spsc_ring.h>
+#include <kea/util/mpsc_ring.h>
+#include <kea/util/aligned_ptr.h>
+#include <folly/MPMCQueue.h>
+#include <gflags/gflags.h>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace kea::util;
+
+DEFINE_uint64(items, 1000000, "items written by each producer");
+DEFINE_uint64(capacity, 1024, "queue capacity");
+DEFINE_uint64(max_producers, 32, "producers go 1, 2, 4 ... up to this");
+
+// many producers, one consumer, the way workers feed the send thread
+template <typename Write, typename Read>
+double run(size_t producers, Write write, Read read) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; p++) {
+        threads.push_back(std::thread([p, write]() {
+            for (uint64_t i = 0; i < FLAGS_items; i++) {
+                uint64_t item = i;
+                while (!write(p, item)) {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+
+    uint64_t total = producers * FLAGS_items;
+    uint64_t item;
+    for (uint64_t read_count = 0; read_count < total;) {
+        if (read(item)) {
+            read_count++;
+        }
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return total / elapsed.count() / 1e6;
+}
+
+double benchMPMC(size_t producers) {
+    folly::MPMCQueue<uint64_t> queue(FLAGS_capacity);
+    return run(producers,
+            [&queue](size_t, uint64_t item) { return queue.write(std::move(item)); },
+            [&queue](uint64_t& item) { return queue.read(item); });
+}
+
+double benchMpsc(size_t producers) {
+    MpscRing<uint64_t> ring(FLAGS_capacity);
+    return run(producers,
+            [&ring](size_t, uint64_t item) { return ring.write(std::move(item)); },
+            [&ring](uint64_t& item) { return ring.read(item); });
+}
+
+// one ring per producer, the consumer goes round them
+double benchSpsc(size_t producers) {
+    std::vector<AlignedPtr<SpscRing<uint64_t>>> rings;
+    for (size_t p = 0; p < producers; p++) {
+        rings.push_back(makeAligned<SpscRing<uint64_t>>(FLAGS_capacity));
+    }
+    size_t next = 0;
+    return run(producers,
+            [&rings](size_t p, uint64_t item) { return rings[p]->write(std::move(item)); },
+            [&rings, &next](uint64_t& item) {
+                for (size_t i = 0; i < rings.size(); i++) {
+                    next = (next + 1) % rings.size();
+                    if (rings[next]->read(item)) {
+                        return true;
+                    }
+                }
+                return false;
+            });
+}
+
+int main(int argc, char** argv) {
+    ::google::ParseCommandLineFlags(&argc, &argv, true);
+    std::cout << "producers  mpmc(Mops/s)  mpsc(Mops/s)  spsc(Mops/s)\n";
+    for (size_t producers = 1; producers <= FLAGS_max_producers; producers *= 2) {
+        double mpmc = benchMPMC(producers);
+        double mpsc = benchMpsc(producers);
+        double spsc = benchSpsc(producers);
+        std::cout << producers << "  " << mpmc << "  " << mpsc << "  " << spsc << "\n";
+    }
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include <kea/client/client_context.h>
+#include <kea/dhcp++/dhcp4.h>
 #include <kea/dhcp++/option_custom.h>
 
 namespace kea {
@@ -9,9 +10,14 @@ using namespace kea::dhcp;
 ClientContext::ClientContext(PktPtr query, const Subnet& subnet)
     : query_(std::move(query)), 
     subnet_(subnet), 
+    shared_subnet_id_(0),
     is_request_addr_conflict_(false),
     your_addr_(IOAddress(0)),
-    retry_count_(0) {
+    reserved_addr_(IOAddress(0)),
+    retry_count_(0),
+    candidate_count_(0),
+    offer_commit_(false),
+    rapid_commit_(false) {
 }
 
 std::vector<uint8_t> 
@@ -31,6 +37,10 @@ ClientContext::getHWAddr() const {
 
 IOAddress
 ClientContext::getRequestAddr() const {
+    if (query_->getType() == DHCPDISCOVER && !reserved_addr_.isV4Zero()) {
+        return reserved_addr_;
+    }
+
     const OptionCustom* opt_requested_address = dynamic_cast<const OptionCustom*>
         (query_->getOption(DHO_DHCP_REQUESTED_ADDRESS));
     if (opt_requested_address) {
@@ -42,6 +52,12 @@ ClientContext::getRequestAddr() const {
     }
 }
 
+bool
+ClientContext::acceptsAnyAddr() const {
+    return query_->getType() == DHCPDISCOVER && !rapid_commit_ && reserved_addr_.isV4Zero() &&
+        query_->getOption(DHO_DHCP_REQUESTED_ADDRESS) == nullptr;
+}
+
 uint8_t
 ClientContext::getQueryType() const {
     return query_->getType();    
@@ -3,6 +3,8 @@
 #include <kea/dhcp++/subnet.h>
 #include <kea/dhcp++/pkt.h>
 #include <kea/util/io_address.h>
+#include <vector>
+#include <memory>
 
 namespace kea {
 namespace client {
@@ -37,22 +39,69 @@ public:
     IOAddress getYourAddr() const;
     void setYourAddr(IOAddress addr);
 
+    // address reserved for the client in this slave's configure, a discover
+    // asks master for it. master still decides, it only gets the address if
+    // nobody else holds it
+    IOAddress getReservedAddr() const { return reserved_addr_; }
+    void setReservedAddr(IOAddress addr) { reserved_addr_ = addr; }
+
+    // a discover which asks for no address of its own, neither requested
+    // nor reserved, and isn't committed right away. any free one will do
+    bool acceptsAnyAddr() const;
+
     std::string getHostName() const;
     
     void addRetryCount() { retry_count_ += 1;}
     int getRetryCount() const { return retry_count_; }
 
+    // addresses master planned for a discover besides your addr, they are
+    // probed together and the first silent one becomes your addr
+    uint32_t getCandidateCount() const { return candidate_count_; }
+    void setCandidateCount(uint32_t count) { candidate_count_ = count; }
+    const std::vector<IOAddress>& getCandidates() const { return candidates_; }
+    void setCandidates(std::vector<IOAddress> candidates) { candidates_ = std::move(candidates); }
+
+    // a request answering an offer this slave made, master only needs to
+    // commit the offered address
+    bool isOfferCommit() const { return offer_commit_; }
+    void setOfferCommit(bool offer_commit) { offer_commit_ = offer_commit; }
+
+    // a discover answered with an ack right away, master plans and
+    // commits the lease in one go
+    bool isRapidCommit() const { return rapid_commit_; }
+    void setRapidCommit(bool rapid_commit) { rapid_commit_ = rapid_commit; }
+
+    // keeps the exchange marked in flight until the context is gone
+    void setInflightToken(std::shared_ptr<void> token) { inflight_token_ = std::move(token); }
+
+    // keeps the configuration the subnet belongs to alive until the
+    // context is gone, a reconfig meanwhile doesn't pull it away
+    void setConfig(std::shared_ptr<const void> config) { config_ = std::move(config); }
+    const std::shared_ptr<const void>& getConfig() const { return config_; }
+
+    // candidates answering the probe, to be reported as conflict
+    const std::vector<IOAddress>& getConflictAddrs() const { return conflict_addrs_; }
+    void addConflictAddr(const IOAddress& addr) { conflict_addrs_.push_back(addr); }
+    void clearConflictAddrs() { conflict_addrs_.clear(); }
+
 private:
     const Subnet& subnet_;
     uint32_t shared_subnet_id_;
     PktPtr query_;
     bool is_request_addr_conflict_;
     IOAddress your_addr_;
+    IOAddress reserved_addr_;
     int retry_count_;
+    uint32_t candidate_count_;
+    bool offer_commit_;
+    bool rapid_commit_;
+    std::vector<IOAddress> candidates_;
+    std::vector<IOAddress> conflict_addrs_;
+    std::shared_ptr<void> inflight_token_;
+    std::shared_ptr<const void> config_;
 };
 
 typedef std::unique_ptr<ClientContext> ClientContextPtr;
-typedef std::function<void(ClientContextPtr)> ClientContextHandler;
 
 };
 };
@@ -0,0 +1,38 @@
+#include <kea/client/client_key.h>
+#include <kea/dhcp++/dhcp4.h>
+#include <kea/dhcp++/option.h>
+
+namespace kea {
+namespace client {
+
+using namespace kea::dhcp;
+
+// first byte tells which identifier the key is made from, so a client id
+// can never collide with a hardware address
+const char CLIENT_ID_KEY_TAG = 'C';
+const char HWADDR_KEY_TAG = 'H';
+
+std::string
+getClientKey(const Pkt& query) {
+    std::string key;
+    const Option* opt_clientid = query.getOption(DHO_DHCP_CLIENT_IDENTIFIER);
+    if (opt_clientid && !opt_clientid->getData().empty()) {
+        const OptionBuffer& client_id = opt_clientid->getData();
+        key.reserve(client_id.size() + 1);
+        key.push_back(CLIENT_ID_KEY_TAG);
+        key.append(client_id.begin(), client_id.end());
+        return key;
+    }
+
+    const HWAddr& hwaddr = query.getHWAddr();
+    if (!hwaddr.hwaddr_.empty()) {
+        key.reserve(hwaddr.hwaddr_.size() + 2);
+        key.push_back(HWADDR_KEY_TAG);
+        key.push_back(static_cast<char>(hwaddr.htype_));
+        key.append(hwaddr.hwaddr_.begin(), hwaddr.hwaddr_.end());
+    }
+    return key;
+}
+
+};
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <string>
+#include <kea/dhcp++/pkt.h>
+
+namespace kea {
+namespace client {
+
+using kea::dhcp::Pkt;
+
+// Identify a client the same way the master does: by client identifier if
+// the client sends one, otherwise by hardware type and address. returns an
+// empty key if the query carries neither
+std::string getClientKey(const Pkt& query);
+
+};
+};
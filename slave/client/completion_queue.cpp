@@ -0,0 +1,44 @@
+#include <kea/client/completion_queue.h>
+#include <kea/logging/logging.h>
+
+using namespace kea::logging;
+
+namespace kea {
+namespace client {
+
+void
+Continuation::operator()(ClientContextPtr client_ctx) const {
+    if (queue_ != nullptr) {
+        queue_->post(std::move(client_ctx), stage_);
+    }
+}
+
+CompletionQueue::CompletionQueue(size_t capacity, kea::util::EventNotifier* notifier)
+    : ring_(capacity),
+      notifier_(notifier) {
+    drop_count_.store(0);
+}
+
+bool
+CompletionQueue::post(ClientContextPtr client_ctx, CompletionStage stage) {
+    Completion completion(std::move(client_ctx), stage);
+    if (ring_.write(std::move(completion))) {
+        if (notifier_ != nullptr) {
+            notifier_->notify();
+        }
+        return true;
+    }
+
+    if (drop_count_.fetch_add(1) == 0) {
+        logWarning("Completion ", "Completion queue is full, drop finished client context");
+    }
+    return false;
+}
+
+bool
+CompletionQueue::read(Completion& completion) {
+    return ring_.read(completion);
+}
+
+};
+};
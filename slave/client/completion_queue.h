@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <kea/client/client_context.h>
+#include <kea/util/mpsc_ring.h>
+#include <kea/util/event_notifier.h>
+
+namespace kea {
+namespace client {
+
+// the step a client context resumes at once the rpc or ping it waits on is done
+enum CompletionStage {
+    CS_RPC_FINISH,
+    CS_PING_FINISH,
+};
+
+struct Completion {
+    ClientContextPtr client_ctx_;
+    CompletionStage stage_;
+
+    Completion() : client_ctx_(nullptr), stage_(CS_RPC_FINISH) {}
+    Completion(ClientContextPtr client_ctx, CompletionStage stage)
+        : client_ctx_(std::move(client_ctx)), stage_(stage) {}
+};
+
+class CompletionQueue;
+
+// hands a context back to the worker which owns queue_. it's two words
+// copied along with the context through rpc and ping records, so waiting
+// on master or a probe allocates nothing besides the context itself
+struct Continuation {
+    CompletionQueue* queue_;
+    CompletionStage stage_;
+
+    Continuation() : queue_(nullptr), stage_(CS_RPC_FINISH) {}
+    Continuation(CompletionQueue* queue, CompletionStage stage)
+        : queue_(queue), stage_(stage) {}
+
+    bool isValid() const { return queue_ != nullptr; }
+    void operator()(ClientContextPtr client_ctx) const;
+};
+
+//contexts a worker sent out to rpc or ping come back here, the worker
+//resumes them between queries, so rpc and ping threads only ever do io.
+//posting wakes the worker through notifier, the same one its input queue
+//wakes it with
+class CompletionQueue {
+public:
+    CompletionQueue(size_t capacity, kea::util::EventNotifier* notifier);
+
+    // called by io threads and never blocks, a context which doesn't fit is
+    // dropped and the client retransmits
+    bool post(ClientContextPtr client_ctx, CompletionStage stage);
+
+    // owning worker only
+    bool read(Completion& completion);
+    bool isEmpty() const { return ring_.isEmpty(); }
+
+    uint64_t getDropCount() const { return drop_count_.load(); }
+
+private:
+    kea::util::MpscRing<Completion> ring_;
+    kea::util::EventNotifier* notifier_;
+    std::atomic<uint64_t> drop_count_;
+};
+
+};
+};
@@ -0,0 +1,51 @@
+#include <kea/client/client_context.h>
+#include <kea/dhcp++/dhcp4.h>
+#include <kea/dhcp++/option_custom.h>
+#include <kea/dhcp++/libdhcp++.h>
+#include <gtest/gtest.h>
+
+using namespace kea;
+using namespace kea::dhcp;
+using namespace kea::client;
+
+namespace {
+
+class ClientContextTest : public ::testing::Test {
+public:
+    ClientContextTest()
+        : subnet_(IOAddress("10.0.0.0"), 24, 1000, 2000, 3000, 1) {
+        LibDHCP::initOptions();
+    }
+
+    ClientContextPtr makeContext(uint8_t type) {
+        return ClientContextPtr(new ClientContext(PktPtr(new Pkt(type, 1)), subnet_));
+    }
+
+    Subnet subnet_;
+};
+
+TEST_F(ClientContextTest, acceptsAnyAddr) {
+    EXPECT_TRUE(makeContext(DHCPDISCOVER)->acceptsAnyAddr());
+    EXPECT_FALSE(makeContext(DHCPREQUEST)->acceptsAnyAddr());
+
+    ClientContextPtr rapid_commit = makeContext(DHCPDISCOVER);
+    rapid_commit->setRapidCommit(true);
+    EXPECT_FALSE(rapid_commit->acceptsAnyAddr());
+
+    PktPtr query(new Pkt(DHCPDISCOVER, 1));
+    std::unique_ptr<OptionCustom> requested(new OptionCustom(
+                *LibDHCP::getStdOptionDef(DHO_DHCP_REQUESTED_ADDRESS)));
+    requested->writeAddress(IOAddress("10.0.0.9"));
+    query->addOption(std::move(requested));
+    ClientContext previous(std::move(query), subnet_);
+    EXPECT_FALSE(previous.acceptsAnyAddr());
+    EXPECT_EQ(IOAddress("10.0.0.9"), previous.getRequestAddr());
+
+    // a reserved client is never offered an address out of a block
+    ClientContextPtr reserved = makeContext(DHCPDISCOVER);
+    reserved->setReservedAddr(IOAddress("10.0.0.5"));
+    EXPECT_FALSE(reserved->acceptsAnyAddr());
+    EXPECT_EQ(IOAddress("10.0.0.5"), reserved->getRequestAddr());
+}
+
+};
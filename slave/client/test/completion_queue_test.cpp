@@ -0,0 +1,75 @@
+#include <kea/client/completion_queue.h>
+#include <kea/dhcp++/dhcp4.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace kea;
+using namespace kea::dhcp;
+using namespace kea::client;
+
+namespace {
+
+class CompletionQueueTest : public ::testing::Test {
+public:
+    CompletionQueueTest()
+        : subnet_(IOAddress("10.0.0.0"), 24, 1000, 2000, 3000, 1) {}
+
+    ClientContextPtr makeContext(uint32_t xid) {
+        return ClientContextPtr(new ClientContext(PktPtr(new Pkt(DHCPDISCOVER, xid)), subnet_));
+    }
+
+    Subnet subnet_;
+};
+
+TEST_F(CompletionQueueTest, continuation) {
+    CompletionQueue queue(10, nullptr);
+    Continuation rpc_finish(&queue, CS_RPC_FINISH);
+    Continuation ping_finish(&queue, CS_PING_FINISH);
+    EXPECT_TRUE(rpc_finish.isValid());
+    EXPECT_FALSE(Continuation().isValid());
+
+    // io threads only post, the owner resumes in order
+    std::thread io([&]() {
+        rpc_finish(makeContext(1));
+        ping_finish(makeContext(2));
+    });
+    io.join();
+    EXPECT_FALSE(queue.isEmpty());
+
+    Completion completion;
+    ASSERT_TRUE(queue.read(completion));
+    EXPECT_EQ(CS_RPC_FINISH, completion.stage_);
+    EXPECT_EQ(1, completion.client_ctx_->getQuery().getTransid());
+    ASSERT_TRUE(queue.read(completion));
+    EXPECT_EQ(CS_PING_FINISH, completion.stage_);
+    EXPECT_EQ(2, completion.client_ctx_->getQuery().getTransid());
+    EXPECT_FALSE(queue.read(completion));
+}
+
+TEST_F(CompletionQueueTest, wakeup) {
+    kea::util::EventNotifier notifier;
+    CompletionQueue queue(10, &notifier);
+
+    // the owner sleeps until a completion is posted
+    std::thread io([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        queue.post(makeContext(1), CS_PING_FINISH);
+    });
+    Completion completion;
+    while (!queue.read(completion)) {
+        notifier.wait([&]() { return !queue.isEmpty(); });
+    }
+    io.join();
+    EXPECT_EQ(CS_PING_FINISH, completion.stage_);
+    EXPECT_EQ(1, completion.client_ctx_->getQuery().getTransid());
+}
+
+TEST_F(CompletionQueueTest, full) {
+    CompletionQueue queue(2, nullptr);
+    EXPECT_TRUE(queue.post(makeContext(1), CS_RPC_FINISH));
+    EXPECT_TRUE(queue.post(makeContext(2), CS_RPC_FINISH));
+    EXPECT_FALSE(queue.post(makeContext(3), CS_RPC_FINISH));
+    EXPECT_EQ(1, queue.getDropCount());
+}
+
+};
@@ -85,6 +85,10 @@ size_t Pkt::len() const {
 }
 
 void Pkt::pack() {
+    pack(nullptr, 0);
+}
+
+void Pkt::pack(const uint8_t* raw_options, size_t raw_len) {
     buffer_out_.clear();
     try {
         size_t hw_len = hwaddr_.hwaddr_.size();
@@ -119,6 +123,9 @@ void Pkt::pack() {
         buffer_out_.writeData(file_, MAX_FILE_LEN);
         buffer_out_.writeUint32(DHCP_OPTIONS_COOKIE);
 
+        if (raw_len != 0) {
+            buffer_out_.writeData(raw_options, raw_len);
+        }
         LibDHCP::packOptions4(buffer_out_, options_);
         buffer_out_.writeUint8(DHO_END);
      } catch(const Exception& e) {
@@ -33,6 +33,9 @@ public:
     Pkt(uint8_t msg_type, uint32_t transid);
 
     void pack();
+    // like pack, with options already in wire format written ahead of the
+    // options of the packet
+    void pack(const uint8_t* raw_options, size_t raw_len);
     void unpack();
     
     void addOption(const std::unique_ptr<Option>);
@@ -46,6 +49,9 @@ public:
     const ClientClasses& getClasses() const { return (classes_); }
 
     void updateTimestamp() { timestamp_ = std::chrono::system_clock::now(); }
+    const TimePoint& getTimestamp() const { return (timestamp_); }
+    // received bytes, before unpack
+    const OptionBuffer& getData() const { return (data_); }
     kea::util::OutputBuffer& getBuffer() { return (buffer_out_); };
 
     std::string getLabel() const;
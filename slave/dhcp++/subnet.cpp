@@ -14,7 +14,8 @@ Subnet::Subnet(const IOAddress& prefix, uint8_t len,
     :id_(id), 
     prefix_(prefix), prefix_len_(len), t1_(t1), t2_(t2), 
     valid_(valid_lifetime), last_allocated_ia_(lastAddrInNetwork(prefix, len)), 
-    relay_(relay), host_reservation_mode_(HR_ALL), siaddr_(IOAddress("0.0.0.0")) {
+    relay_(relay), host_reservation_mode_(HR_ALL), siaddr_(IOAddress("0.0.0.0")),
+    rapid_commit_(false) {
         assert(prefix.isV4() && len <= 32);
 }
 
@@ -24,6 +24,20 @@ public:
         IOAddress addr_;
     };
 
+    // spread of the lease times handed to clients, so clients leased at
+    // the same moment don't renew at the same moment forever after
+    struct LeaseJitter {
+        // percent of T1 randomly added to or taken from T1 and T2
+        uint32_t renew_jitter_;
+        // percent of valid lifetime it may randomly be shortened by
+        uint32_t lifetime_jitter_;
+        // seconds over which T1 and T2 of different clients are spread,
+        // a client always gets the same place in the window
+        uint32_t smoothing_window_;
+
+        LeaseJitter() : renew_jitter_(0), lifetime_jitter_(0), smoothing_window_(0) {}
+    };
+
     typedef enum  {
         HR_DISABLED,
         HR_OUT_OF_POOL,
@@ -128,6 +142,20 @@ public:
         return (match_client_id_);
     }
 
+    void setRapidCommit(const bool rapid_commit) {
+        rapid_commit_ = rapid_commit;
+    }
+    bool getRapidCommit() const {
+        return (rapid_commit_);
+    }
+
+    void setLeaseJitter(const LeaseJitter& jitter) {
+        lease_jitter_ = jitter;
+    }
+    const LeaseJitter& getLeaseJitter() const {
+        return (lease_jitter_);
+    }
+
     OptionCollection& getOptdata() {
         return opt_data_;
     }
@@ -142,6 +170,8 @@ private:
 
     IOAddress siaddr_;
     bool match_client_id_;
+    bool rapid_commit_;
+    LeaseJitter lease_jitter_;
     OptionCollection opt_data_;
 };
 
@@ -40,6 +40,12 @@ public:
       const std::string& message,
       T... args);
 
+  // whether a message at log_level would reach any target, to skip
+  // building messages nobody reads
+  bool isEnabled(LogLevel log_level) const {
+    return log_level >= min_level_.load() && max_listener_index_.load() != 0;
+  }
+
   void addTarget(LogTarget* target);
   void setMinimumLogLevel(LogLevel min_level);
   static void open_log(const std::string& log_file_path, const std::string& program_name, LogLevel min_log_level=LogLevel::kTrace, bool log_enable=false);
@@ -3,6 +3,7 @@
 
 #include <kea/ping/ping.h>
 #include <kea/logging/logging.h>
+#include <kea/util/thread_affinity.h>
 
 
 using namespace kea::logging;
@@ -15,7 +16,8 @@ static Pinger* SingletonPinger = nullptr;
 const uint32_t PACKET_SIZE = 128;
 const uint32_t PROTO_ICMP = 1;
 
-Pinger::Pinger(uint32_t max_size, bool is_enable, MilliSeconds time_out) : is_enable_(is_enable), timer_queue_(max_size, time_out){
+Pinger::Pinger(uint32_t max_size, bool is_enable, MilliSeconds time_out, uint32_t candidate_count)
+    : is_enable_(is_enable), candidate_count_(candidate_count), timer_queue_(max_size, time_out){
     pipe(pipefd_);
     stop_.store(false);
     fcntl(pipefd_[1], F_SETFL, O_NONBLOCK);
@@ -24,7 +26,10 @@ Pinger::Pinger(uint32_t max_size, bool is_enable, MilliSeconds time_out) : is_en
         assert(sockfd_ > 0);
     }
     fcntl(sockfd_, F_SETFL, O_NONBLOCK);
-    std::thread threadrecv([&](){Pinger::recvPacket();});  
+    std::thread threadrecv([&](){
+        kea::util::ThreadAffinity::instance().pinCurrent(kea::util::TC_PING);
+        Pinger::recvPacket();
+    });
     thread_recv_ = std::move(threadrecv);
 }
 
@@ -39,19 +44,20 @@ void Pinger::stop() {
     write(pipefd_[1], "1", 1);
     thread_recv_.join();
     seq_record_map_.clear();
+    group_record_map_.clear();
     close(sockfd_);
     close(pipefd_[0]);
     close(pipefd_[1]);
 }
 
-void Pinger::init(bool is_enable, uint32_t time_out) {
+void Pinger::init(bool is_enable, uint32_t time_out, uint32_t candidate_count) {
     if(SingletonPinger != nullptr) {
         SingletonPinger->stop();
         delete SingletonPinger;
     }
         
     MilliSeconds timeout(time_out*1000);
-    SingletonPinger = new Pinger(QUEUE_MAX_SIZE, is_enable, timeout);
+    SingletonPinger = new Pinger(QUEUE_MAX_SIZE, is_enable, timeout, candidate_count);
     std::atexit([](){ delete SingletonPinger; });
 }
 
@@ -60,7 +66,7 @@ Pinger::instance() {
     return *SingletonPinger;
 }
 
-void Pinger::ping(ClientContextPtr client_ctx, ClientContextHandler callback) {
+void Pinger::ping(ClientContextPtr client_ctx, Continuation callback) {
     if(!is_enable_) {
         callback(std::move(client_ctx));
         return;
@@ -84,19 +90,96 @@ bool Pinger::notifyPingTarget(uint32_t pack_id, bool reachable) {
         seq_record_map_.erase(it);
         lock.unlock();
         record.client_ctx_->setRequestAddrConflict(reachable);
+        if (reachable) {
+            record.client_ctx_->addConflictAddr(record.client_ctx_->getYourAddr());
+        }
         record.val_(std::move(record.client_ctx_));
         return true;
     } else {
-        lock.unlock();
+        return notifyGroupTarget(lock, pack_id, reachable);
+    }
+}
+
+bool Pinger::notifyGroupTarget(std::unique_lock<std::mutex>& lock, uint32_t pack_id, bool reachable) {
+    auto it = group_record_map_.find(pack_id);
+    if (it == group_record_map_.end()) {
         return false;
     }
+
+    PingGroupPtr group = it->second.first;
+    IOAddress addr = it->second.second;
+    group_record_map_.erase(it);
+    group->pending_ -= 1;
+    if (group->done_) {
+        return true;
+    }
+
+    // timers fire in the order candidates were sent, so the first timeout
+    // is the first silent candidate in the order master planned them
+    if (reachable) {
+        group->client_ctx_->addConflictAddr(addr);
+        if (group->pending_ != 0) {
+            return true;
+        }
+    } else {
+        group->client_ctx_->setYourAddr(addr);
+    }
+
+    group->done_ = true;
+    ClientContextPtr client_ctx = std::move(group->client_ctx_);
+    Continuation callback = group->callback_;
+    lock.unlock();
+    client_ctx->setRequestAddrConflict(reachable);
+    callback(std::move(client_ctx));
+    return true;
+}
+
+void Pinger::pingCandidates(ClientContextPtr client_ctx, Continuation callback) {
+    if (!is_enable_ || client_ctx->getCandidates().size() < 2) {
+        ping(std::move(client_ctx), callback);
+        return;
+    }
+
+    struct PingTarget {
+        uint32_t pack_id_;
+        uint16_t pack_seq_;
+        uint16_t random_;
+        IOAddress addr_;
+    };
+
+    std::vector<PingTarget> targets;
+    std::vector<IOAddress> candidates = client_ctx->getCandidates();
+    PingGroupPtr group(new PingGroup(std::move(client_ctx), callback));
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        for (auto& addr : candidates) {
+            uint16_t pack_seq = pack_seq_.fetch_add(1);
+            uint16_t random = random_.getRandom();
+            uint32_t pack_id = (random << 16) + pack_seq;
+            group_record_map_.insert(std::make_pair(pack_id, std::make_pair(group, addr)));
+            group->pending_ += 1;
+            targets.push_back({pack_id, pack_seq, random, addr});
+        }
+    }
+
+    for (auto& target : targets) {
+        if (addTimerTarget(target.pack_id_)) {
+            sendPacket(target.addr_, target.pack_seq_, target.random_);
+        } else {
+            // like a single ping, a client without any probe left is dropped
+            std::lock_guard<std::mutex> guard(mutex_);
+            if (group_record_map_.erase(target.pack_id_) != 0) {
+                group->pending_ -= 1;
+            }
+        }
+    }
 }
 
 bool Pinger::addTimerTarget(uint32_t pack_id) {
     return timer_queue_.addTimer(std::bind(&Pinger::notifyPingTarget, this, pack_id, false));
 }
 
-void Pinger::addPingTarget(uint32_t pack_id, ClientContextPtr client_ctx, ClientContextHandler callback) {
+void Pinger::addPingTarget(uint32_t pack_id, ClientContextPtr client_ctx, Continuation callback) {
     std::lock_guard<std::mutex> guard(mutex_);
     seq_record_map_.insert(std::pair<uint32_t, PingRecord>(pack_id, {std::move(client_ctx), callback}));
 }
@@ -8,6 +8,8 @@
 #include <chrono>
 #include <fcntl.h>
 #include <map>
+#include <memory>
+#include <vector>
 #include <functional>
 #include <mutex>
 #include <thread>
@@ -18,6 +20,7 @@
 #include <kea/ping/icmp_protocol.h>
 #include <kea/util/io_address.h>
 #include <kea/client/client_context_wrapper.h>
+#include <kea/client/completion_queue.h>
 
 using namespace kea::util;
 
@@ -26,36 +29,59 @@ namespace pinger{
 
 typedef std::chrono::milliseconds MilliSeconds;
 
-using PingRecord = client::ClientContextWrapper<client::ClientContextHandler>;
+using PingRecord = client::ClientContextWrapper<client::Continuation>;
 using kea::client::ClientContextPtr;
-using kea::client::ClientContextHandler;
+using kea::client::Continuation;
 
 class Pinger {
 
     public:
         static const uint32_t QUEUE_MAX_SIZE = 4096;
 
-        explicit Pinger(uint32_t max_size, bool is_enable, MilliSeconds time_out = MilliSeconds(1000));
+        explicit Pinger(uint32_t max_size, bool is_enable, MilliSeconds time_out = MilliSeconds(1000),
+                        uint32_t candidate_count = 1);
         ~Pinger();
 
         Pinger(const Pinger& ) = delete;
         Pinger& operator=(const Pinger&) = delete;
 
-        void ping(ClientContextPtr client_ctx, ClientContextHandler callback);
-        static void init(bool is_enable, uint32_t time_out);
+        void ping(ClientContextPtr client_ctx, Continuation callback);
+        // probe all candidates of client_ctx at once, callback gets the first
+        // one which stays silent as your addr, or conflict if all answered
+        void pingCandidates(ClientContextPtr client_ctx, Continuation callback);
+        // how many addresses to ask master for after a conflict
+        uint32_t getCandidateCount() const { return candidate_count_; }
+        // probes waiting for their timeout
+        kea::util::QueueStats getQueueStats() { return timer_queue_.getStats(); }
+
+        static void init(bool is_enable, uint32_t time_out, uint32_t candidate_count = 1);
         static Pinger& instance();
         void stop();
 
     private:
+        struct PingGroup {
+            ClientContextPtr client_ctx_;
+            Continuation callback_;
+            size_t pending_;
+            bool done_;
+
+            PingGroup(ClientContextPtr client_ctx, Continuation callback)
+                : client_ctx_(std::move(client_ctx)), callback_(callback), pending_(0), done_(false) {}
+        };
+        typedef std::shared_ptr<PingGroup> PingGroupPtr;
+
         void sendPacket(IOAddress ip_addr, uint16_t pack_seq, uint16_t random);
         void recvPacket();
         bool notifyPingTarget(uint32_t pack_id, bool reachable);
-        void addPingTarget(uint32_t pack_id, ClientContextPtr client_ctx, ClientContextHandler callback);
+        bool notifyGroupTarget(std::unique_lock<std::mutex>& lock, uint32_t pack_id, bool reachable);
+        void addPingTarget(uint32_t pack_id, ClientContextPtr client_ctx, Continuation callback);
         bool addTimerTarget(uint32_t pack_id);
 
         bool is_enable_;
+        uint32_t candidate_count_;
         uint32_t sockfd_;
         std::map<uint32_t, PingRecord> seq_record_map_;
+        std::map<uint32_t, std::pair<PingGroupPtr, IOAddress>> group_record_map_;
         std::mutex mutex_;
         std::thread thread_recv_;
         RandomGenerate<uint16_t> random_;
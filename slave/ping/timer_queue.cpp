@@ -1,13 +1,18 @@
 #include <kea/ping/timer_queue.h>
+#include <kea/util/thread_affinity.h>
+#include <algorithm>
 
 namespace kea{
 namespace pinger{
 
 static const int32_t NEGNIGIBLE_DELAY = 10; //milliseconds
 
-TimerQueue::TimerQueue(uint32_t max_size, MilliSeconds timeout) : max_size_(max_size), time_out_(timeout) {
+TimerQueue::TimerQueue(uint32_t max_size, MilliSeconds timeout) : max_size_(max_size), time_out_(timeout), high_water_(0) {
     stop_.store(false);
-    std::thread t_pop([&](){removeExpireTimers();});
+    std::thread t_pop([&](){
+        kea::util::ThreadAffinity::instance().pinCurrent(kea::util::TC_PING);
+        removeExpireTimers();
+    });
     thread_remove_timer_ = std::move(t_pop);
 }
 
@@ -33,6 +38,7 @@ bool TimerQueue::addTimer(TimerCallBack callback) {
         return false;
     }
     timer_queue_.push({(std::chrono::system_clock::now() + time_out_), callback});
+    high_water_ = std::max(high_water_, timer_queue_.size());
     lock.unlock();
     empty_condition_.notify_one();
     return true;
@@ -74,5 +80,11 @@ TimerQueue::removeExpireTimers() {
     }
 }
 
+kea::util::QueueStats
+TimerQueue::getStats() {
+    std::lock_guard<std::mutex> lock(timer_mutex_);
+    return kea::util::QueueStats{"ping", timer_queue_.size(), high_water_};
+}
+
 };
 };
@@ -7,6 +7,7 @@
 #include <functional>
 #include <mutex>
 #include <atomic>
+#include <kea/util/queue_stats.h>
 
 namespace kea{
 namespace pinger{
@@ -30,6 +31,7 @@ class TimerQueue {
         bool addTimer(TimerCallBack callback);
         void stop();
         void setTimeOut(uint32_t time_out);
+        kea::util::QueueStats getStats();
 
     private:
         void removeExpireTimers();
@@ -39,6 +41,7 @@ class TimerQueue {
         std::mutex timer_mutex_;
         std::condition_variable empty_condition_;
         std::queue<TimerNode> timer_queue_;
+        size_t high_water_;
         std::atomic<bool> stop_;
         std::thread thread_remove_timer_;
 };
@@ -0,0 +1,37 @@
+#include <kea/rpc/allocate_backend.h>
+#include <cstdlib>
+
+namespace kea {
+namespace rpc {
+
+static AllocateBackend* SingletonAllocateBackend = nullptr;
+static bool ExitHandlerInstalled = false;
+
+void
+AllocateBackend::init(std::unique_ptr<AllocateBackend> backend) {
+    if (SingletonAllocateBackend != nullptr) {
+        SingletonAllocateBackend->stop();
+        delete SingletonAllocateBackend;
+        SingletonAllocateBackend = nullptr;
+    }
+
+    if (!ExitHandlerInstalled) {
+        ExitHandlerInstalled = true;
+        std::atexit([](){
+                if (SingletonAllocateBackend != nullptr) {
+                    SingletonAllocateBackend->stop();
+                    delete SingletonAllocateBackend;
+                    SingletonAllocateBackend = nullptr;
+                }
+        });
+    }
+    SingletonAllocateBackend = backend.release();
+}
+
+AllocateBackend&
+AllocateBackend::instance() {
+    return *SingletonAllocateBackend;
+}
+
+};
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <memory>
+#include <kea/rpc/rpc_codec.h>
+#include <kea/client/completion_queue.h>
+#include <kea/util/queue_stats.h>
+#include <vector>
+
+namespace kea {
+namespace rpc {
+
+using kea::client::ClientContextPtr;
+using kea::client::Continuation;
+
+//where addresses come from. the default backend asks kea masters over rpc,
+//a standalone slave allocates in process. the server only talks to the
+//installed instance
+class AllocateBackend {
+public:
+    virtual ~AllocateBackend() {}
+
+    // callback gets the context with your addr set, zero address means nak
+    virtual void allocateAddr(ClientContextPtr client_ctx, Continuation callback) = 0;
+    // release, decline, conflict ip or a locally acked request, nobody
+    // waits for the result and the caller keeps the context
+    virtual void notify(ClientContext& client_ctx) = 0;
+    // a request off the packet path, such as address blocks
+    virtual bool call(const RequestFields& fields, LeaseResultMsg& result) = 0;
+    virtual void stop() = 0;
+    // queues waiting for masters, none for a local backend
+    virtual void getQueueStats(std::vector<kea::util::QueueStats>&) const {}
+
+    static AllocateBackend& instance();
+    // the previous backend is stopped and destroyed
+    static void init(std::unique_ptr<AllocateBackend> backend);
+};
+
+};
+};
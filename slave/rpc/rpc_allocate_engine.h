@@ -1,77 +1,50 @@
 #pragma once
 
 #include <cstdlib>
-#include <queue>
-#include <iostream>
-#include <thread>
-#include <arpa/inet.h>
-#include <netinet/in.h>
-#include <functional>
-#include <mutex>
-#include <condition_variable>
 #include <atomic>
 #include <string>
 #include <vector>
-#include <asio.hpp>
-#include <kea/rpc/context.pb.h>
+#include <memory>
+#include <unordered_map>
+#include <kea/rpc/rpc_endpoint.h>
+#include <kea/rpc/allocate_backend.h>
 #include <kea/util/io_address.h>
 #include <kea/client/client_context_wrapper.h>
-#include <folly/MPMCQueue.h>
 
 using namespace kea::util;
 
 namespace kea {
 namespace rpc {
 
-using RPCRecord = client::ClientContextWrapper<client::ClientContextHandler>;
-using kea::client::ClientContextPtr;
-using kea::client::ClientContext;
-using kea::client::ClientContextHandler;
-
-typedef folly::MPMCQueue<RPCRecord> RPCRequestQueue;
-
-class RpcConn {
-public:
-    RpcConn(std::string server_addr, uint32_t port, RPCRequestQueue& in_queue);
-    ~RpcConn();
-    void stop();
-
-private:
-    void connectServer();
-    void messageWrite();
-    void writeRequestHeader(std::string request);
-    void writeRequestBody(std::string request);
-    void readResultHeader();
-    void readResultBody();
-    int marshRequset(ClientContext& ctx);
-    void unMarshResult(char* result_body);
-
-    asio::io_service io_service_;
-    asio::ip::tcp::socket socket_;
-    char result_len_[2];
-    static const int MAX_RESULT_BODY_LEN = 1024;
-    char result_body_[MAX_RESULT_BODY_LEN];
-    std::thread io_loop_;
-    asio::ip::tcp::resolver::iterator endpoint_iterator_;
-    std::atomic<bool> stop_;
-    RPCRecord rpc_request_;
-    RPCRequestQueue& in_queue_;
-};
-
-class RpcAllocateEngine{
+//route allocate requests to kea masters by subnet id. among the masters
+//serving a subnet, a healthy primary is preferred over a healthy standby
+//and the one with the lowest latency wins
+class RpcAllocateEngine : public AllocateBackend {
 public:
-    RpcAllocateEngine(std::string server_addr, uint32_t port);
-
-    void allocateAddr(ClientContextPtr client_ctx, ClientContextHandler callback);
-    void stop();
-
-    static RpcAllocateEngine& instance();
+    RpcAllocateEngine(const std::vector<RpcMasterConf>& masters);
+
+    virtual void allocateAddr(ClientContextPtr client_ctx, Continuation callback);
+    // report release, decline, conflict ip or a locally acked renewal to
+    // master, the request is copied so the caller keeps the context
+    virtual void notify(ClientContext& client_ctx);
+    // send a request to the master serving its subnet and wait for the
+    // answer, only for requests off the packet path
+    virtual bool call(const RequestFields& fields, LeaseResultMsg& result);
+    virtual void stop();
+    virtual void getQueueStats(std::vector<kea::util::QueueStats>& stats) const;
+
+    // install a rpc engine as the allocate backend
     static void init(std::string server_addr, uint32_t port);
+    static void init(const std::vector<RpcMasterConf>& masters);
 
 private:
+    RpcEndpoint* selectEndpoint(uint32_t subnet_id, const RpcEndpoint* exclude);
+    void failover(RpcEndpoint& from, RPCRecord&& record);
+
     std::atomic<bool> stop_;
-    std::unique_ptr<RPCRequestQueue> request_queue_;
-    std::vector<std::unique_ptr<RpcConn>> connections_;
+    std::vector<std::unique_ptr<RpcEndpoint>> endpoints_;
+    std::unordered_map<uint32_t, std::vector<RpcEndpoint*>> subnet_routes_;
+    std::vector<RpcEndpoint*> default_route_;
 };
 
 };
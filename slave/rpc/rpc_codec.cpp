@@ -0,0 +1,345 @@
+#include <kea/rpc/rpc_codec.h>
+#include <kea/dhcp++/dhcp4.h>
+#include <kea/dhcp++/option.h>
+#include <cstring>
+
+namespace kea {
+namespace rpc {
+
+using namespace kea::dhcp;
+
+namespace {
+
+enum WireType {
+    WT_VARINT = 0,
+    WT_FIXED64 = 1,
+    WT_LENGTH_DELIMITED = 2,
+    WT_FIXED32 = 5
+};
+
+// field numbers of kea.ContextMsg
+const uint32_t CONTEXT_REQUEST_TYPE = 1;
+const uint32_t CONTEXT_SUBNET_ID = 2;
+const uint32_t CONTEXT_CLIENT_ID = 3;
+const uint32_t CONTEXT_MAC = 4;
+const uint32_t CONTEXT_REQUEST_ADDR = 5;
+const uint32_t CONTEXT_HOST_NAME = 6;
+const uint32_t CONTEXT_BLOCK_SIZE = 7;
+const uint32_t CONTEXT_BLOCK_ADDRS = 8;
+const uint32_t CONTEXT_BLOCK_LIFE_TIME = 9;
+const uint32_t CONTEXT_CANDIDATE_COUNT = 10;
+
+// field numbers of kea.LeaseResult
+const uint32_t RESULT_SUCCEED = 1;
+const uint32_t RESULT_ADDR = 2;
+const uint32_t RESULT_SUBNET_ID = 3;
+const uint32_t RESULT_ADDRS = 4;
+
+const size_t MAX_VARINT_LEN = 10;
+
+class WireWriter {
+public:
+    WireWriter(uint8_t* buf, size_t buf_len)
+        : pos_(buf), end_(buf + buf_len), overflow_(false) {}
+
+    // proto3 doesn't put field with default value on the wire
+    void writeVarintField(uint32_t field, uint64_t value) {
+        if (value == 0) {
+            return;
+        }
+        writeVarint((field << 3) | WT_VARINT);
+        writeVarint(value);
+    }
+
+    void writeBytesField(uint32_t field, const void* data, size_t len) {
+        if (len == 0) {
+            return;
+        }
+        writeVarint((field << 3) | WT_LENGTH_DELIMITED);
+        writeVarint(len);
+        if (overflow_ || static_cast<size_t>(end_ - pos_) < len) {
+            overflow_ = true;
+            return;
+        }
+        memcpy(pos_, data, len);
+        pos_ += len;
+    }
+
+    // repeated scalar is packed in proto3
+    void writePackedField(uint32_t field, const uint32_t* values, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        size_t len = 0;
+        for (size_t i = 0; i < count; i++) {
+            len += varintSize(values[i]);
+        }
+        writeVarint((field << 3) | WT_LENGTH_DELIMITED);
+        writeVarint(len);
+        for (size_t i = 0; i < count; i++) {
+            writeVarint(values[i]);
+        }
+    }
+
+    uint8_t* position() const { return pos_; }
+    bool overflow() const { return overflow_; }
+
+private:
+    static size_t varintSize(uint64_t value) {
+        size_t size = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            size++;
+        }
+        return size;
+    }
+
+    void writeVarint(uint64_t value) {
+        if (overflow_ || static_cast<size_t>(end_ - pos_) < MAX_VARINT_LEN) {
+            overflow_ = true;
+            return;
+        }
+        while (value >= 0x80) {
+            *pos_++ = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        *pos_++ = static_cast<uint8_t>(value);
+    }
+
+    uint8_t* pos_;
+    uint8_t* end_;
+    bool overflow_;
+};
+
+class WireReader {
+public:
+    WireReader(const uint8_t* data, size_t len)
+        : pos_(data), end_(data + len) {}
+
+    bool atEnd() const { return pos_ == end_; }
+
+    // return a reader over the next length delimited field
+    bool readSubReader(WireReader& sub_reader) {
+        uint64_t len = 0;
+        if (!readVarint(len) || static_cast<uint64_t>(end_ - pos_) < len) {
+            return false;
+        }
+        sub_reader = WireReader(pos_, len);
+        pos_ += len;
+        return true;
+    }
+
+    bool readVarint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos_ == end_) {
+                return false;
+            }
+            uint8_t byte = *pos_++;
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool skip(uint32_t wire_type) {
+        uint64_t len = 0;
+        switch (wire_type) {
+            case WT_VARINT:
+                return readVarint(len);
+            case WT_FIXED64:
+                len = 8;
+                break;
+            case WT_FIXED32:
+                len = 4;
+                break;
+            case WT_LENGTH_DELIMITED:
+                if (!readVarint(len)) {
+                    return false;
+                }
+                break;
+            default:
+                return false;
+        }
+        if (static_cast<uint64_t>(end_ - pos_) < len) {
+            return false;
+        }
+        pos_ += len;
+        return true;
+    }
+
+private:
+    const uint8_t* pos_;
+    const uint8_t* end_;
+};
+
+void
+appendResultAddr(LeaseResultMsg& result, uint64_t addr) {
+    if (result.addr_count_ < LeaseResultMsg::MAX_ADDRS) {
+        result.addrs_[result.addr_count_++] = static_cast<uint32_t>(addr);
+    }
+}
+
+};
+
+const size_t RpcCodec::FRAME_HEADER_LEN;
+const size_t RpcCodec::MAX_FRAME_BODY_LEN;
+const size_t LeaseResultMsg::MAX_ADDRS;
+
+bool
+RpcCodec::getRequestType(uint8_t query_type, RequestType& request_type) {
+    switch (query_type) {
+        case DHCPDISCOVER:
+            request_type = RT_DISCOVER;
+            return true;
+        case DHCPREQUEST:
+            request_type = RT_REQUEST;
+            return true;
+        case DHCPRELEASE:
+            request_type = RT_RELEASE;
+            return true;
+        case DHCPDECLINE:
+            request_type = RT_DECLINE;
+            return true;
+        case DHCPCONFLICTIP:
+            request_type = RT_CONFLICT_IP;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool
+RpcCodec::getRequestFields(ClientContext& ctx, RequestFields& fields) {
+    Pkt& query = ctx.getQuery();
+    if (!getRequestType(query.getType(), fields.request_type_)) {
+        return false;
+    }
+
+    fields.subnet_id_ = ctx.getSubnetID();
+    if (fields.request_type_ == RT_REQUEST && ctx.isOfferCommit()) {
+        // the offer already settled the subnet inside the shared network
+        fields.request_type_ = RT_COMMIT_OFFER;
+        if (ctx.getSharedSubnetID() != 0) {
+            fields.subnet_id_ = ctx.getSharedSubnetID();
+        }
+    }
+    if (fields.request_type_ == RT_DISCOVER && ctx.isRapidCommit()) {
+        fields.request_type_ = RT_RAPID_COMMIT;
+    }
+    const Option* opt_clientid = query.getOption(DHO_DHCP_CLIENT_IDENTIFIER);
+    if (opt_clientid && !opt_clientid->getData().empty()) {
+        fields.client_id_ = opt_clientid->getData().data();
+        fields.client_id_len_ = opt_clientid->getData().size();
+    }
+    const std::vector<uint8_t>& hwaddr = query.getHWAddr().hwaddr_;
+    fields.mac_ = hwaddr.data();
+    fields.mac_len_ = hwaddr.size();
+    fields.request_addr_ = IOAddress::toLong(ctx.getRequestAddr());
+    // a rapid commit is answered with the single address master committed
+    if (fields.request_type_ == RT_DISCOVER && ctx.getCandidateCount() > 1) {
+        fields.candidate_count_ = ctx.getCandidateCount();
+    }
+    return true;
+}
+
+size_t
+RpcCodec::encodeRequest(const RequestFields& fields, uint8_t* buf, size_t buf_len) {
+    if (buf_len <= FRAME_HEADER_LEN) {
+        return 0;
+    }
+
+    WireWriter writer(buf + FRAME_HEADER_LEN, buf_len - FRAME_HEADER_LEN);
+    writer.writeVarintField(CONTEXT_REQUEST_TYPE, fields.request_type_);
+    writer.writeVarintField(CONTEXT_SUBNET_ID, fields.subnet_id_);
+    writer.writeBytesField(CONTEXT_CLIENT_ID, fields.client_id_, fields.client_id_len_);
+    writer.writeBytesField(CONTEXT_MAC, fields.mac_, fields.mac_len_);
+    writer.writeVarintField(CONTEXT_REQUEST_ADDR, fields.request_addr_);
+    writer.writeBytesField(CONTEXT_HOST_NAME, fields.host_name_, fields.host_name_len_);
+    writer.writeVarintField(CONTEXT_BLOCK_SIZE, fields.block_size_);
+    writer.writePackedField(CONTEXT_BLOCK_ADDRS, fields.block_addrs_, fields.block_addr_count_);
+    writer.writeVarintField(CONTEXT_BLOCK_LIFE_TIME, fields.block_life_time_);
+    writer.writeVarintField(CONTEXT_CANDIDATE_COUNT, fields.candidate_count_);
+    if (writer.overflow()) {
+        return 0;
+    }
+
+    size_t body_len = writer.position() - (buf + FRAME_HEADER_LEN);
+    if (body_len > MAX_FRAME_BODY_LEN) {
+        return 0;
+    }
+    buf[0] = static_cast<uint8_t>((body_len & 0xff00) >> 8);
+    buf[1] = static_cast<uint8_t>(body_len & 0xff);
+    return body_len + FRAME_HEADER_LEN;
+}
+
+size_t
+RpcCodec::decodeFrameLen(const uint8_t* header) {
+    return (static_cast<size_t>(header[0]) << 8) + header[1];
+}
+
+bool
+RpcCodec::decodeResult(const uint8_t* body, size_t body_len, LeaseResultMsg& result) {
+    result.succeed_ = false;
+    result.addr_ = 0;
+    result.subnet_id_ = 0;
+    result.addr_count_ = 0;
+    WireReader reader(body, body_len);
+    while (!reader.atEnd()) {
+        uint64_t key = 0;
+        if (!reader.readVarint(key)) {
+            return false;
+        }
+
+        uint32_t field = static_cast<uint32_t>(key >> 3);
+        uint32_t wire_type = static_cast<uint32_t>(key & 0x07);
+        if (field == RESULT_ADDRS && wire_type == WT_LENGTH_DELIMITED) {
+            WireReader packed_reader(nullptr, 0);
+            if (!reader.readSubReader(packed_reader)) {
+                return false;
+            }
+            while (!packed_reader.atEnd()) {
+                uint64_t addr = 0;
+                if (!packed_reader.readVarint(addr)) {
+                    return false;
+                }
+                appendResultAddr(result, addr);
+            }
+            continue;
+        }
+
+        if (wire_type != WT_VARINT) {
+            if (!reader.skip(wire_type)) {
+                return false;
+            }
+            continue;
+        }
+
+        uint64_t value = 0;
+        if (!reader.readVarint(value)) {
+            return false;
+        }
+        switch (field) {
+            case RESULT_SUCCEED:
+                result.succeed_ = (value != 0);
+                break;
+            case RESULT_ADDR:
+                result.addr_ = static_cast<uint32_t>(value);
+                break;
+            case RESULT_SUBNET_ID:
+                result.subnet_id_ = static_cast<uint32_t>(value);
+                break;
+            case RESULT_ADDRS:
+                appendResultAddr(result, value);
+                break;
+            default:
+                break;
+        }
+    }
+    return true;
+}
+
+};
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <kea/client/client_context.h>
+
+namespace kea {
+namespace rpc {
+
+using kea::client::ClientContext;
+
+// Request types of kea.ContextMsg, see master/proto/context.proto
+enum RequestType {
+    RT_DISCOVER     = 0,
+    RT_REQUEST      = 1,
+    RT_RELEASE      = 2,
+    RT_DECLINE      = 3,
+    RT_CONFLICT_IP  = 4,
+    RT_ACQUIRE_BLOCK = 5,
+    RT_RELEASE_BLOCK = 6,
+    RT_COMMIT_OFFER = 7,
+    RT_RAPID_COMMIT = 8
+};
+
+// Fields of one kea.ContextMsg, byte fields point into memory owned by
+// the caller (normally the query packet) and are not copied before encoding
+struct RequestFields {
+    RequestType request_type_;
+    uint32_t subnet_id_;
+    const uint8_t* client_id_;
+    size_t client_id_len_;
+    const uint8_t* mac_;
+    size_t mac_len_;
+    uint32_t request_addr_;
+    const char* host_name_;
+    size_t host_name_len_;
+    uint32_t block_size_;
+    const uint32_t* block_addrs_;
+    size_t block_addr_count_;
+    uint32_t block_life_time_;
+    uint32_t candidate_count_;
+
+    RequestFields()
+        : request_type_(RT_DISCOVER),
+          subnet_id_(0),
+          client_id_(nullptr),
+          client_id_len_(0),
+          mac_(nullptr),
+          mac_len_(0),
+          request_addr_(0),
+          host_name_(nullptr),
+          host_name_len_(0),
+          block_size_(0),
+          block_addrs_(nullptr),
+          block_addr_count_(0),
+          block_life_time_(0),
+          candidate_count_(0) {}
+};
+
+// Fields of kea.LeaseResult, see master/proto/lease.proto. addresses beyond
+// MAX_ADDRS are dropped
+struct LeaseResultMsg {
+    static const size_t MAX_ADDRS = 256;
+
+    bool succeed_;
+    uint32_t addr_;
+    uint32_t subnet_id_;
+    size_t addr_count_;
+    uint32_t addrs_[MAX_ADDRS];
+
+    LeaseResultMsg() : succeed_(false), addr_(0), subnet_id_(0), addr_count_(0) {}
+};
+
+//codec of the messages exchanged between slave and master, every message
+//is a protobuf (proto3) body prefixed with a 2 bytes big endian length.
+//encoding writes the wire format straight into the caller's buffer so the
+//request path needs neither protobuf objects nor heap allocation
+class RpcCodec {
+public:
+    static const size_t FRAME_HEADER_LEN = 2;
+    static const size_t MAX_FRAME_BODY_LEN = 0x7fff;
+
+    static bool getRequestType(uint8_t query_type, RequestType& request_type);
+
+    // Fill fields from the query of client context, returns false if
+    // the query type has no corresponding request type
+    static bool getRequestFields(ClientContext& ctx, RequestFields& fields);
+
+    // Encode one frame into buf, returns the frame length including the
+    // length header, or 0 if buf is too small
+    static size_t encodeRequest(const RequestFields& fields, uint8_t* buf, size_t buf_len);
+
+    // Return the body length carried by a frame header
+    static size_t decodeFrameLen(const uint8_t* header);
+
+    // Decode a frame body, the body may legally be empty or contain zero bytes
+    static bool decodeResult(const uint8_t* body, size_t body_len, LeaseResultMsg& result);
+};
+
+};
+};
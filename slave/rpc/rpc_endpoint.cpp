@@ -0,0 +1,426 @@
+#include <kea/rpc/rpc_endpoint.h>
+#include <kea/util/io_address.h>
+#include <kea/logging/logging.h>
+#include <kea/util/thread_affinity.h>
+
+using namespace kea::logging;
+using namespace kea::util;
+
+// master which doesn't answer a request in time is treated as failed
+const uint32_t RESPONSE_TIMEOUT_SECONDS = 2;
+// weight of the newest sample in the smoothed latency is 1/8
+const uint32_t LATENCY_SMOOTH_SHIFT = 3;
+
+namespace kea {
+namespace rpc {
+
+RpcEndpoint::RpcEndpoint(const RpcMasterConf& conf, size_t conn_count, size_t queue_size,
+                         FailoverHandler failover)
+    : conf_(conf),
+    failover_(failover),
+    conn_count_(conn_count),
+    request_queue_(new RPCRequestQueue(queue_size)) {
+    stop_.store(false);
+    healthy_.store(false);
+    latency_us_.store(0);
+}
+
+void
+RpcEndpoint::start() {
+    for (size_t i = 0; i < conn_count_; i++) {
+        connections_.push_back(std::unique_ptr<RpcConn>(new RpcConn(*this, conf_.ip_, conf_.port_)));
+    }
+    notifier_.reset(new RpcNotifier(conf_.ip_, conf_.port_, request_queue_->capacity()));
+}
+
+RpcEndpoint::~RpcEndpoint() {
+    stop();
+}
+
+void
+RpcEndpoint::stop() {
+    if(stop_.load()) { return; }
+    stop_.store(true);
+
+    RPCRecord tmp;
+    while (request_queue_->read(tmp)) {
+    }
+
+    for(size_t i = 0; i < connections_.size(); i++) {
+        request_queue_->blockingWrite(RPCRecord());
+    }
+
+    for(auto& conn : connections_) {
+        conn->stop();
+    }
+
+    if (notifier_ != nullptr) {
+        notifier_->stop();
+    }
+}
+
+void
+RpcEndpoint::push(RPCRecord&& record) {
+    request_queue_->blockingWrite(std::move(record));
+    high_water_.update(request_queue_->size());
+}
+
+bool
+RpcEndpoint::tryPush(RPCRecord&& record) {
+    if (request_queue_->write(std::move(record))) {
+        high_water_.update(request_queue_->size());
+        return true;
+    }
+    return false;
+}
+
+kea::util::QueueStats
+RpcEndpoint::getQueueStats() const {
+    ssize_t depth = request_queue_->size();
+    return kea::util::QueueStats{"rpc " + toText(), depth > 0 ? static_cast<size_t>(depth) : 0, high_water_.get()};
+}
+
+bool
+RpcEndpoint::notify(const RpcNotification& notification) {
+    return notifier_->notify(notification);
+}
+
+bool
+RpcEndpoint::call(const RequestFields& fields, LeaseResultMsg& result) {
+    std::lock_guard<std::mutex> lock(sync_conn_mutex_);
+    if (stop_.load()) {
+        return false;
+    }
+
+    if (sync_conn_ == nullptr) {
+        sync_conn_.reset(new RpcSyncConn(conf_.ip_, conf_.port_));
+    }
+    return sync_conn_->call(fields, result);
+}
+
+std::string
+RpcEndpoint::toText() const {
+    return conf_.ip_ + ":" + std::to_string(conf_.port_);
+}
+
+void
+RpcEndpoint::onConnected() {
+    if (healthy_.exchange(true) == false) {
+        logInfo("RpcEndpoint", "Master $0 is up", toText());
+    }
+}
+
+void
+RpcEndpoint::onResponse(uint64_t latency_us) {
+    uint64_t latency = latency_us_.load();
+    if (latency == 0) {
+        latency = latency_us;
+    } else {
+        latency = latency - (latency >> LATENCY_SMOOTH_SHIFT) + (latency_us >> LATENCY_SMOOTH_SHIFT);
+    }
+    latency_us_.store(latency);
+    healthy_.store(true);
+}
+
+void
+RpcEndpoint::onFailure(RPCRecord&& in_flight) {
+    if (stop_.load()) {
+        return;
+    }
+
+    std::vector<RPCRecord> pending;
+    if (in_flight.client_ctx_ != nullptr) {
+        pending.push_back(std::move(in_flight));
+    }
+
+    if (healthy_.exchange(false)) {
+        logWarning("RpcEndpoint", "Master $0 is down, fail over queued requests", toText());
+        RPCRecord record;
+        while (request_queue_->read(record)) {
+            if (record.client_ctx_ == nullptr) {
+                // stop marker raced with us, leave it for the connections
+                request_queue_->write(std::move(record));
+                break;
+            }
+            pending.push_back(std::move(record));
+        }
+    }
+
+    for (auto& record : pending) {
+        failover_(*this, std::move(record));
+    }
+}
+
+
+RpcSyncConn::RpcSyncConn(const std::string& server_addr, uint32_t port)
+    : socket_(io_service_),
+    timer_(io_service_),
+    server_addr_(server_addr),
+    port_(port) {
+}
+
+RpcSyncConn::~RpcSyncConn() {
+    std::error_code ec;
+    socket_.close(ec);
+}
+
+void
+RpcSyncConn::wait(std::error_code& ec) {
+    do {
+        io_service_.run_one();
+    } while (ec == asio::error::would_block);
+}
+
+bool
+RpcSyncConn::call(const RequestFields& fields, LeaseResultMsg& result) {
+    size_t request_len = RpcCodec::encodeRequest(fields, request_buf_, MAX_REQUEST_LEN);
+    if (request_len == 0) {
+        logError("RpcSyncConn ", "Marshal request failed with type $0", static_cast<int>(fields.request_type_));
+        return false;
+    }
+
+    io_service_.reset();
+    timer_.expires_from_now(std::chrono::seconds(RESPONSE_TIMEOUT_SECONDS));
+    timer_.async_wait([this](std::error_code ec) {
+        if (ec != asio::error::operation_aborted &&
+            timer_.expires_at() <= std::chrono::steady_clock::now()) {
+            socket_.close();
+        }
+    });
+
+    std::error_code ec;
+    if (!socket_.is_open()) {
+        asio::ip::tcp::resolver resolver(io_service_);
+        auto endpoint_iterator = resolver.resolve({server_addr_, std::to_string(port_)}, ec);
+        if (!ec) {
+            ec = asio::error::would_block;
+            asio::async_connect(socket_, endpoint_iterator, [&ec](std::error_code connect_ec, asio::ip::tcp::resolver::iterator) {
+                ec = connect_ec;
+            });
+            wait(ec);
+        }
+    }
+
+    if (!ec) {
+        ec = asio::error::would_block;
+        asio::async_write(socket_, asio::buffer(request_buf_, request_len), [&ec](std::error_code write_ec, std::size_t) {
+            ec = write_ec;
+        });
+        wait(ec);
+    }
+
+    if (!ec) {
+        ec = asio::error::would_block;
+        asio::async_read(socket_, asio::buffer(result_len_, sizeof(result_len_)), [&ec](std::error_code read_ec, std::size_t) {
+            ec = read_ec;
+        });
+        wait(ec);
+    }
+
+    size_t result_len = 0;
+    if (!ec) {
+        result_len = RpcCodec::decodeFrameLen(result_len_);
+        if (result_len > MAX_RESULT_BODY_LEN) {
+            ec = asio::error::message_size;
+        } else if (result_len != 0) {
+            ec = asio::error::would_block;
+            asio::async_read(socket_, asio::buffer(result_body_, result_len), [&ec](std::error_code read_ec, std::size_t) {
+                ec = read_ec;
+            });
+            wait(ec);
+        }
+    }
+
+    timer_.cancel();
+    if (ec) {
+        logError("RpcSyncConn ", "Call master $0:$1 failed: $2", server_addr_, port_, ec.message().c_str());
+        std::error_code close_ec;
+        socket_.close(close_ec);
+        return false;
+    }
+
+    if (!RpcCodec::decodeResult(result_body_, result_len, result)) {
+        logWarning("RpcSyncConn ", "Unmarshal result message failed with len $0", result_len);
+        return false;
+    }
+    return true;
+}
+
+
+RpcConn::RpcConn(RpcEndpoint& endpoint, const std::string& server_addr, uint32_t port)
+    : socket_(io_service_),
+    response_timer_(io_service_),
+    endpoint_(endpoint) {
+    stop_.store(false);
+    asio::ip::tcp::resolver resolver(io_service_);
+    endpoint_iterator_ = resolver.resolve({server_addr, std::to_string(port)});
+    connectServer();
+    std::thread io_loop([this](){
+        kea::util::ThreadAffinity::instance().pinCurrent(kea::util::TC_RPC);
+        this->io_service_.run();
+    });
+    io_loop_ = std::move(io_loop);
+}
+
+RpcConn::~RpcConn() {
+    stop();
+}
+
+void
+RpcConn::stop() {
+    if(stop_.load()) { return; }
+    stop_.store(true);
+    io_service_.post([this]() {
+        response_timer_.cancel();
+        socket_.close();
+    });
+    io_loop_.join();
+}
+
+void
+RpcConn::connectServer() {
+    asio::async_connect(socket_, endpoint_iterator_, [&](std::error_code ec, asio::ip::tcp::resolver::iterator) {
+        if (!ec) {
+            endpoint_.onConnected();
+            messageWrite();
+        } else {
+            logError("RpcConn   ", "!!!connect $0 failed: $1, and reconnect", endpoint_.toText(), ec.message().c_str());
+            endpoint_.onFailure(RPCRecord());
+            if (this->stop_.load() == false) {
+            std::this_thread::sleep_for(std::chrono::seconds(5));
+                connectServer();
+            }
+        }
+    });
+}
+
+void
+RpcConn::onFailure() {
+    response_timer_.cancel();
+    endpoint_.onFailure(std::move(rpc_request_));
+    reconnect();
+}
+
+void
+RpcConn::reconnect() {
+    if (this->stop_.load() == false) {
+        connectServer();
+    }
+}
+
+void
+RpcConn::messageWrite() {
+    endpoint_.getQueue().blockingRead(rpc_request_);
+    if (rpc_request_.client_ctx_ != nullptr) {
+        size_t request_len = marshRequset(*(rpc_request_.client_ctx_));
+        if (request_len == 0) {
+            logError("RpcConn   ", "Marshal request failed with msg type $0", rpc_request_.client_ctx_->getQueryType());
+            messageWrite();
+            return;
+        }
+
+        request_time_ = std::chrono::steady_clock::now();
+        response_timer_.expires_from_now(std::chrono::seconds(RESPONSE_TIMEOUT_SECONDS));
+        response_timer_.async_wait([this](std::error_code ec) {
+            if (ec != asio::error::operation_aborted &&
+                response_timer_.expires_at() <= std::chrono::steady_clock::now()) {
+                logError("RpcConn   ", "Master $0 doesn't answer in time, and reconnect", endpoint_.toText());
+                socket_.close();
+            }
+        });
+
+        asio::async_write(socket_, asio::buffer(request_buf_, request_len), [this](std::error_code ec, std::size_t){
+            if (!ec) {
+                readResultHeader();
+            } else {
+                logError("RpcConn   ", "Send message to master failed: $0, and reconnect", ec.message().c_str());
+                onFailure();
+            }
+        });
+    }
+}
+
+void
+RpcConn::readResultHeader() {
+    asio::async_read(socket_, asio::buffer(result_len_, sizeof(result_len_)), [this](std::error_code ec, std::size_t ) {
+        if (!ec) {
+            readResultBody();
+        } else {
+            logError("RpcConn   ", "Read result message header failed: $0, and reconnect", ec.message().c_str());
+            onFailure();
+        }
+    });
+}
+
+void
+RpcConn::readResultBody() {
+    size_t result_len = RpcCodec::decodeFrameLen(result_len_);
+    if (result_len == 0) {
+        // an empty body is a LeaseResult with every field set to default
+        unMarshResult(result_body_, 0);
+        messageWrite();
+    } else if (result_len <= MAX_RESULT_BODY_LEN) {
+        asio::async_read(socket_, asio::buffer(result_body_, result_len), [this, result_len](std::error_code ec, std::size_t) {
+                if (!ec) {
+                    unMarshResult(result_body_, result_len);
+                    messageWrite();
+                } else {
+                    logError("RpcConn   ", "Read result message body failed: $0, and reconnect",ec.message().c_str());
+                    onFailure();
+                }
+        });
+    } else {
+        logError("RpcConn   ", "Read result message body failed with len $0, and reconnect", result_len);
+        onFailure();
+    }
+}
+
+void
+RpcConn::unMarshResult(const uint8_t* result_body, size_t result_len) {
+    response_timer_.cancel();
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - request_time_);
+    endpoint_.onResponse(latency.count());
+
+    LeaseResultMsg result;
+    if (!RpcCodec::decodeResult(result_body, result_len, result)) {
+        logWarning("RpcConn   ", "Unmarshal result message failed with len $0", result_len);
+    }
+
+    IOAddress allocate_addr(0);
+    uint32_t subnet_id = 0;
+
+    if (result.succeed_) {
+        allocate_addr = IOAddress::fromLong(result.addr_);
+        subnet_id = result.subnet_id_;
+    }
+
+    logDebug("RpcConn   ", "Receive result $0 with ip $1 and subnet_id $2 and msg type $3",
+            result.succeed_, allocate_addr.toText(), subnet_id, rpc_request_.client_ctx_->getQueryType());
+    rpc_request_.client_ctx_->setYourAddr(allocate_addr);
+    rpc_request_.client_ctx_->setSharedSubnetID(subnet_id);
+
+    std::vector<IOAddress> candidates;
+    if (result.succeed_ && result.addr_count_ > 1) {
+        for (size_t i = 0; i < result.addr_count_; i++) {
+            candidates.push_back(IOAddress::fromLong(result.addrs_[i]));
+        }
+    }
+    rpc_request_.client_ctx_->setCandidates(std::move(candidates));
+
+    if (rpc_request_.val_.isValid()) {
+        rpc_request_.val_(std::move(rpc_request_.client_ctx_));
+    }
+}
+
+size_t
+RpcConn::marshRequset(ClientContext& request) {
+    RequestFields fields;
+    if (!RpcCodec::getRequestFields(request, fields)) {
+        return 0;
+    }
+    return RpcCodec::encodeRequest(fields, request_buf_, MAX_REQUEST_LEN);
+}
+
+};
+};
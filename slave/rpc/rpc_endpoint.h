@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdlib>
+#include <thread>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <asio.hpp>
+#include <kea/rpc/rpc_codec.h>
+#include <kea/rpc/rpc_notifier.h>
+#include <kea/client/client_context_wrapper.h>
+#include <kea/client/completion_queue.h>
+#include <kea/util/queue_stats.h>
+#include <folly/MPMCQueue.h>
+
+namespace kea {
+namespace rpc {
+
+using RPCRecord = client::ClientContextWrapper<client::Continuation>;
+using kea::client::ClientContextPtr;
+using kea::client::ClientContext;
+using kea::client::Continuation;
+
+typedef folly::MPMCQueue<RPCRecord> RPCRequestQueue;
+
+// One kea master the slave talks to. A master without subnet ids serves
+// every subnet which isn't explicitly assigned to other masters, a standby
+// master only gets requests when no primary of the same subnet is healthy
+struct RpcMasterConf {
+    std::string ip_;
+    uint32_t port_;
+    std::vector<uint32_t> subnet_ids_;
+    bool standby_;
+
+    RpcMasterConf() : port_(0), standby_(false) {}
+    RpcMasterConf(const std::string& ip, uint32_t port)
+        : ip_(ip), port_(port), standby_(false) {}
+};
+
+class RpcEndpoint;
+
+class RpcConn {
+public:
+    RpcConn(RpcEndpoint& endpoint, const std::string& server_addr, uint32_t port);
+    ~RpcConn();
+    void stop();
+
+private:
+    void connectServer();
+    void messageWrite();
+    void readResultHeader();
+    void readResultBody();
+    void onFailure();
+    void reconnect();
+    size_t marshRequset(ClientContext& ctx);
+    void unMarshResult(const uint8_t* result_body, size_t result_len);
+
+    asio::io_service io_service_;
+    asio::ip::tcp::socket socket_;
+    asio::basic_waitable_timer<std::chrono::steady_clock> response_timer_;
+    static const size_t MAX_REQUEST_LEN = 1024;
+    static const size_t MAX_RESULT_BODY_LEN = 1024;
+    uint8_t request_buf_[MAX_REQUEST_LEN];
+    uint8_t result_len_[RpcCodec::FRAME_HEADER_LEN];
+    uint8_t result_body_[MAX_RESULT_BODY_LEN];
+    std::thread io_loop_;
+    asio::ip::tcp::resolver::iterator endpoint_iterator_;
+    std::atomic<bool> stop_;
+    std::chrono::steady_clock::time_point request_time_;
+    RPCRecord rpc_request_;
+    RpcEndpoint& endpoint_;
+};
+
+//blocking request and answer for infrequent requests such as address
+//block acquisition, kept apart from the pipelined allocation connections.
+//the whole call including connecting is bounded by the response timeout
+class RpcSyncConn {
+public:
+    RpcSyncConn(const std::string& server_addr, uint32_t port);
+    ~RpcSyncConn();
+
+    bool call(const RequestFields& fields, LeaseResultMsg& result);
+
+private:
+    void wait(std::error_code& ec);
+
+    asio::io_service io_service_;
+    asio::ip::tcp::socket socket_;
+    asio::basic_waitable_timer<std::chrono::steady_clock> timer_;
+    std::string server_addr_;
+    uint32_t port_;
+    static const size_t MAX_REQUEST_LEN = 4096;
+    static const size_t MAX_RESULT_BODY_LEN = 4096;
+    uint8_t request_buf_[MAX_REQUEST_LEN];
+    uint8_t result_len_[RpcCodec::FRAME_HEADER_LEN];
+    uint8_t result_body_[MAX_RESULT_BODY_LEN];
+};
+
+//a master with its own request queue and connection pool. the endpoint is
+//healthy after a connection is established or an answer is received, and
+//turns unhealthy once a connect, send or read fails or the master doesn't
+//answer in time. requests queued on an endpoint which turns unhealthy are
+//handed to the failover handler so they can be routed to another master
+class RpcEndpoint {
+public:
+    typedef std::function<void(RpcEndpoint&, RPCRecord&&)> FailoverHandler;
+
+    RpcEndpoint(const RpcMasterConf& conf, size_t conn_count, size_t queue_size,
+                FailoverHandler failover);
+    ~RpcEndpoint();
+
+    // connections are opened here rather than in constructor, since they
+    // may call back into the failover handler as soon as they are created
+    void start();
+    void stop();
+
+    void push(RPCRecord&& record);
+    bool tryPush(RPCRecord&& record);
+    // send over the low priority channel, never blocks
+    bool notify(const RpcNotification& notification);
+    // send one request and wait for its answer, callers are serialized
+    bool call(const RequestFields& fields, LeaseResultMsg& result);
+    RPCRequestQueue& getQueue() { return *request_queue_; }
+    kea::util::QueueStats getQueueStats() const;
+
+    const RpcMasterConf& getConf() const { return conf_; }
+    bool isStandby() const { return conf_.standby_; }
+    bool isHealthy() const { return healthy_.load(); }
+    // smoothed round trip time of requests in microseconds
+    uint64_t getLatency() const { return latency_us_.load(); }
+    std::string toText() const;
+
+    void onConnected();
+    void onResponse(uint64_t latency_us);
+    void onFailure(RPCRecord&& in_flight);
+
+private:
+    RpcMasterConf conf_;
+    FailoverHandler failover_;
+    size_t conn_count_;
+    std::atomic<bool> stop_;
+    std::atomic<bool> healthy_;
+    std::atomic<uint64_t> latency_us_;
+    std::unique_ptr<RPCRequestQueue> request_queue_;
+    kea::util::HighWaterMark high_water_;
+    std::vector<std::unique_ptr<RpcConn>> connections_;
+    std::unique_ptr<RpcNotifier> notifier_;
+    std::mutex sync_conn_mutex_;
+    std::unique_ptr<RpcSyncConn> sync_conn_;
+};
+
+};
+};
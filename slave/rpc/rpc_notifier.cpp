@@ -0,0 +1,267 @@
+#include <kea/rpc/rpc_notifier.h>
+#include <kea/logging/logging.h>
+#include <kea/util/thread_affinity.h>
+#include <cstring>
+#include <chrono>
+
+using namespace kea::logging;
+
+namespace kea {
+namespace rpc {
+
+const size_t RpcNotification::MAX_CLIENT_ID_LEN;
+const size_t RpcNotification::MAX_MAC_LEN;
+
+bool
+RpcNotification::assign(const RequestFields& fields) {
+    if (fields.request_type_ != RT_REQUEST &&
+        fields.request_type_ != RT_RELEASE &&
+        fields.request_type_ != RT_DECLINE &&
+        fields.request_type_ != RT_CONFLICT_IP) {
+        return false;
+    }
+
+    request_type_ = fields.request_type_;
+    subnet_id_ = fields.subnet_id_;
+    request_addr_ = fields.request_addr_;
+    client_id_len_ = std::min(fields.client_id_len_, MAX_CLIENT_ID_LEN);
+    if (client_id_len_ != 0) {
+        memcpy(client_id_, fields.client_id_, client_id_len_);
+    }
+    mac_len_ = std::min(fields.mac_len_, MAX_MAC_LEN);
+    if (mac_len_ != 0) {
+        memcpy(mac_, fields.mac_, mac_len_);
+    }
+    return true;
+}
+
+void
+RpcNotification::toFields(RequestFields& fields) const {
+    fields.request_type_ = request_type_;
+    fields.subnet_id_ = subnet_id_;
+    fields.request_addr_ = request_addr_;
+    fields.client_id_ = client_id_;
+    fields.client_id_len_ = client_id_len_;
+    fields.mac_ = mac_;
+    fields.mac_len_ = mac_len_;
+}
+
+bool
+RpcNotification::operator==(const RpcNotification& other) const {
+    return request_type_ == other.request_type_ &&
+        subnet_id_ == other.subnet_id_ &&
+        request_addr_ == other.request_addr_ &&
+        client_id_len_ == other.client_id_len_ &&
+        mac_len_ == other.mac_len_ &&
+        memcmp(client_id_, other.client_id_, client_id_len_) == 0 &&
+        memcmp(mac_, other.mac_, mac_len_) == 0;
+}
+
+
+RpcNotifier::RpcNotifier(const std::string& server_addr, uint32_t port, size_t queue_size)
+    : socket_(io_service_),
+    queue_(queue_size),
+    pending_results_(0),
+    batch_frames_(0),
+    batch_len_(0),
+    batch_resent_(false),
+    server_(server_addr + ":" + std::to_string(port)) {
+    stop_.store(false);
+    drop_count_.store(0);
+    coalesced_count_.store(0);
+    asio::ip::tcp::resolver resolver(io_service_);
+    endpoint_iterator_ = resolver.resolve({server_addr, std::to_string(port)});
+    connectServer();
+    std::thread io_loop([this](){
+        kea::util::ThreadAffinity::instance().pinCurrent(kea::util::TC_RPC);
+        this->io_service_.run();
+    });
+    io_loop_ = std::move(io_loop);
+}
+
+RpcNotifier::~RpcNotifier() {
+    stop();
+}
+
+bool
+RpcNotifier::notify(const RpcNotification& notification) {
+    if (queue_.write(notification)) {
+        return true;
+    }
+
+    drop_count_.fetch_add(1);
+    return false;
+}
+
+void
+RpcNotifier::stop() {
+    if(stop_.load()) { return; }
+    stop_.store(true);
+
+    RpcNotification tmp;
+    while (queue_.read(tmp)) {
+    }
+    queue_.blockingWrite(RpcNotification());
+    io_service_.post([this]() { socket_.close(); });
+    io_loop_.join();
+}
+
+void
+RpcNotifier::connectServer() {
+    asio::async_connect(socket_, endpoint_iterator_, [&](std::error_code ec, asio::ip::tcp::resolver::iterator) {
+        if (!ec) {
+            if (batch_len_ != 0) {
+                sendBatch();
+            } else {
+                batchWrite();
+            }
+        } else {
+            logError("RpcNotify ", "!!!connect $0 failed: $1, and reconnect", server_, ec.message().c_str());
+            if (this->stop_.load() == false) {
+                std::this_thread::sleep_for(std::chrono::seconds(5));
+                connectServer();
+            }
+        }
+    });
+}
+
+void
+RpcNotifier::onFailure() {
+    // frames master already answered are sent again with the rest, which
+    // is harmless for notifications
+    if (batch_len_ != 0) {
+        if (batch_resent_) {
+            logWarning("RpcNotify ", "Drop $0 notifications to master $1 failed twice", batch_frames_, server_);
+            drop_count_.fetch_add(batch_frames_);
+            batch_len_ = 0;
+        } else {
+            batch_resent_ = true;
+        }
+    }
+    reconnect();
+}
+
+void
+RpcNotifier::reconnect() {
+    if (this->stop_.load() == false) {
+        connectServer();
+    }
+}
+
+size_t
+RpcNotifier::collectBatch() {
+    queue_.blockingRead(batch_[0]);
+    if (batch_[0].isStopMarker()) {
+        return 0;
+    }
+
+    size_t batch_size = 1;
+    RpcNotification next;
+    while (batch_size < MAX_BATCH_SIZE && queue_.read(next)) {
+        if (next.isStopMarker()) {
+            queue_.write(next);
+            break;
+        }
+
+        bool duplicate = false;
+        for (size_t i = 0; i < batch_size; i++) {
+            if (batch_[i] == next) {
+                duplicate = true;
+                break;
+            }
+        }
+
+        if (duplicate) {
+            coalesced_count_.fetch_add(1);
+        } else {
+            batch_[batch_size++] = next;
+        }
+    }
+    return batch_size;
+}
+
+void
+RpcNotifier::batchWrite() {
+    size_t batch_size = collectBatch();
+    if (batch_size == 0) {
+        return;
+    }
+
+    size_t buf_len = 0;
+    pending_results_ = 0;
+    for (size_t i = 0; i < batch_size; i++) {
+        RequestFields fields;
+        batch_[i].toFields(fields);
+        size_t frame_len = RpcCodec::encodeRequest(fields, batch_buf_ + buf_len, sizeof(batch_buf_) - buf_len);
+        if (frame_len == 0) {
+            logError("RpcNotify ", "Marshal notification failed with type $0", static_cast<int>(fields.request_type_));
+            continue;
+        }
+        buf_len += frame_len;
+        pending_results_++;
+    }
+
+    if (pending_results_ == 0) {
+        batchWrite();
+        return;
+    }
+
+    batch_frames_ = pending_results_;
+    batch_len_ = buf_len;
+    batch_resent_ = false;
+    sendBatch();
+}
+
+void
+RpcNotifier::sendBatch() {
+    pending_results_ = batch_frames_;
+    logDebug("RpcNotify ", "Send $0 notifications to master $1", pending_results_, server_);
+    asio::async_write(socket_, asio::buffer(batch_buf_, batch_len_), [this](std::error_code ec, std::size_t){
+        if (!ec) {
+            readResultHeader();
+        } else {
+            logError("RpcNotify ", "Send $0 notifications failed: $1, and reconnect", pending_results_, ec.message().c_str());
+            onFailure();
+        }
+    });
+}
+
+void
+RpcNotifier::readResultHeader() {
+    asio::async_read(socket_, asio::buffer(result_len_, sizeof(result_len_)), [this](std::error_code ec, std::size_t ) {
+        if (!ec) {
+            readResultBody();
+        } else {
+            logError("RpcNotify ", "Read result message header failed: $0, and reconnect", ec.message().c_str());
+            onFailure();
+        }
+    });
+}
+
+void
+RpcNotifier::readResultBody() {
+    size_t result_len = RpcCodec::decodeFrameLen(result_len_);
+    if (result_len > MAX_RESULT_BODY_LEN) {
+        logError("RpcNotify ", "Read result message body failed with len $0, and reconnect", result_len);
+        onFailure();
+        return;
+    }
+
+    // results of notifications are of no use, just keep the stream in sync
+    asio::async_read(socket_, asio::buffer(result_body_, result_len), [this](std::error_code ec, std::size_t) {
+        if (!ec) {
+            if (--pending_results_ == 0) {
+                batch_len_ = 0;
+                batchWrite();
+            } else {
+                readResultHeader();
+            }
+        } else {
+            logError("RpcNotify ", "Read result message body failed: $0, and reconnect", ec.message().c_str());
+            onFailure();
+        }
+    });
+}
+
+};
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <asio.hpp>
+#include <kea/rpc/rpc_codec.h>
+#include <kea/dhcp++/hwaddr.h>
+#include <folly/MPMCQueue.h>
+
+namespace kea {
+namespace rpc {
+
+// A fire-and-forget request (release, decline, conflict ip or a renewal the
+// slave already acked) copied out of the query, so it can wait in a queue
+// without holding the packet
+struct RpcNotification {
+    static const size_t MAX_CLIENT_ID_LEN = 255;
+    static const size_t MAX_MAC_LEN = kea::dhcp::HWAddr::MAX_HWADDR_LEN;
+
+    RequestType request_type_;
+    uint32_t subnet_id_;
+    uint32_t request_addr_;
+    uint8_t client_id_len_;
+    uint8_t mac_len_;
+    uint8_t client_id_[MAX_CLIENT_ID_LEN];
+    uint8_t mac_[MAX_MAC_LEN];
+
+    RpcNotification()
+        : request_type_(RT_DISCOVER), subnet_id_(0), request_addr_(0),
+          client_id_len_(0), mac_len_(0) {}
+
+    // returns false if fields isn't a notification
+    bool assign(const RequestFields& fields);
+    void toFields(RequestFields& fields) const;
+    bool operator==(const RpcNotification& other) const;
+
+    // discover is never sent as notification, it's used to wake and stop
+    // the sending thread
+    bool isStopMarker() const { return request_type_ == RT_DISCOVER; }
+};
+
+//low priority channel to one master. notifications are queued without
+//blocking the caller, the sending thread takes whatever is queued, drops
+//duplicates and writes them as back to back frames in a single write, then
+//reads and discards one result per frame. a batch cut off by a broken
+//connection is sent again once after reconnecting, and counted as dropped
+//if that fails too. it never shares the connections used by discover and
+//request
+class RpcNotifier {
+public:
+    RpcNotifier(const std::string& server_addr, uint32_t port, size_t queue_size);
+    ~RpcNotifier();
+
+    bool notify(const RpcNotification& notification);
+    void stop();
+
+    uint64_t getDropCount() const { return drop_count_.load(); }
+    uint64_t getCoalescedCount() const { return coalesced_count_.load(); }
+
+private:
+    void connectServer();
+    void batchWrite();
+    size_t collectBatch();
+    void readResultHeader();
+    void readResultBody();
+    void sendBatch();
+    void onFailure();
+    void reconnect();
+
+    static const size_t MAX_BATCH_SIZE = 64;
+    static const size_t MAX_NOTIFICATION_LEN = 2 + 6 * 10 + RpcNotification::MAX_CLIENT_ID_LEN +
+        RpcNotification::MAX_MAC_LEN;
+    static const size_t MAX_RESULT_BODY_LEN = 1024;
+
+    asio::io_service io_service_;
+    asio::ip::tcp::socket socket_;
+    std::thread io_loop_;
+    asio::ip::tcp::resolver::iterator endpoint_iterator_;
+    std::atomic<bool> stop_;
+    std::atomic<uint64_t> drop_count_;
+    std::atomic<uint64_t> coalesced_count_;
+    folly::MPMCQueue<RpcNotification> queue_;
+    RpcNotification batch_[MAX_BATCH_SIZE];
+    size_t pending_results_;
+    // frames of the batch in batch_buf_ not yet answered as a whole, zero
+    // once master has answered every frame of it
+    size_t batch_frames_;
+    size_t batch_len_;
+    bool batch_resent_;
+    uint8_t batch_buf_[MAX_BATCH_SIZE * MAX_NOTIFICATION_LEN];
+    uint8_t result_len_[RpcCodec::FRAME_HEADER_LEN];
+    uint8_t result_body_[MAX_RESULT_BODY_LEN];
+    std::string server_;
+};
+
+};
+};
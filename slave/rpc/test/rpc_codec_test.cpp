@@ -0,0 +1,161 @@
+#include <kea/rpc/rpc_codec.h>
+#include <kea/client/client_context.h>
+#include <kea/dhcp++/dhcp4.h>
+#include <gtest/gtest.h>
+
+using namespace kea;
+using namespace kea::rpc;
+using namespace kea::client;
+using namespace kea::dhcp;
+
+namespace {
+
+TEST(RpcCodecTest, encodeRequest) {
+    const uint8_t client_id[] = {0x01, 0x00, 0x0c, 0x01, 0x02, 0x03, 0x04};
+    const uint8_t mac[] = {0x00, 0x0c, 0x01, 0x02, 0x03, 0x04};
+    RequestFields fields;
+    fields.request_type_ = RT_REQUEST;
+    fields.subnet_id_ = 300;
+    fields.client_id_ = client_id;
+    fields.client_id_len_ = sizeof(client_id);
+    fields.mac_ = mac;
+    fields.mac_len_ = sizeof(mac);
+    fields.request_addr_ = 0x0a000001;
+
+    uint8_t buf[128];
+    size_t len = RpcCodec::encodeRequest(fields, buf, sizeof(buf));
+    const uint8_t expected[] = {
+        0x00, 0x1b,
+        0x08, 0x01,
+        0x10, 0xac, 0x02,
+        0x1a, 0x07, 0x01, 0x00, 0x0c, 0x01, 0x02, 0x03, 0x04,
+        0x22, 0x06, 0x00, 0x0c, 0x01, 0x02, 0x03, 0x04,
+        0x28, 0x81, 0x80, 0x80, 0x50,
+    };
+    ASSERT_EQ(sizeof(expected), len);
+    EXPECT_EQ(0, memcmp(expected, buf, len));
+}
+
+TEST(RpcCodecTest, encodeRequestOmitDefault) {
+    RequestFields fields;
+    uint8_t buf[16];
+    EXPECT_EQ(RpcCodec::FRAME_HEADER_LEN, RpcCodec::encodeRequest(fields, buf, sizeof(buf)));
+    EXPECT_EQ(0, RpcCodec::decodeFrameLen(buf));
+}
+
+TEST(RpcCodecTest, encodeRequestOverflow) {
+    uint8_t client_id[255] = {0};
+    RequestFields fields;
+    fields.client_id_ = client_id;
+    fields.client_id_len_ = sizeof(client_id);
+
+    uint8_t buf[128];
+    EXPECT_EQ(0, RpcCodec::encodeRequest(fields, buf, sizeof(buf)));
+}
+
+TEST(RpcCodecTest, encodeBlockRequest) {
+    const uint32_t addrs[] = {1, 300};
+    RequestFields fields;
+    fields.request_type_ = RT_RELEASE_BLOCK;
+    fields.subnet_id_ = 1;
+    fields.block_addrs_ = addrs;
+    fields.block_addr_count_ = 2;
+    fields.block_life_time_ = 600;
+
+    uint8_t buf[64];
+    size_t len = RpcCodec::encodeRequest(fields, buf, sizeof(buf));
+    const uint8_t expected[] = {
+        0x00, 0x0c,
+        0x08, 0x06,
+        0x10, 0x01,
+        0x42, 0x03, 0x01, 0xac, 0x02,
+        0x48, 0xd8, 0x04,
+    };
+    ASSERT_EQ(sizeof(expected), len);
+    EXPECT_EQ(0, memcmp(expected, buf, len));
+}
+
+TEST(RpcCodecTest, encodeCandidateRequest) {
+    RequestFields fields;
+    fields.subnet_id_ = 3;
+    fields.candidate_count_ = 4;
+
+    uint8_t buf[64];
+    size_t len = RpcCodec::encodeRequest(fields, buf, sizeof(buf));
+    const uint8_t expected[] = {
+        0x00, 0x04,
+        0x10, 0x03,
+        0x50, 0x04,
+    };
+    ASSERT_EQ(sizeof(expected), len);
+    EXPECT_EQ(0, memcmp(expected, buf, len));
+}
+
+TEST(RpcCodecTest, reservedDiscover) {
+    Subnet subnet(IOAddress("10.0.0.0"), 24, 1, 2, 3, 1);
+    ClientContext discover(PktPtr(new Pkt(DHCPDISCOVER, 1)), subnet);
+    discover.setReservedAddr(IOAddress("10.0.0.5"));
+    RequestFields fields;
+    ASSERT_TRUE(RpcCodec::getRequestFields(discover, fields));
+    EXPECT_EQ(RT_DISCOVER, fields.request_type_);
+    EXPECT_EQ(IOAddress::toLong(IOAddress("10.0.0.5")), fields.request_addr_);
+
+    // a request asks for what the client asks for, master checks it
+    PktPtr query(new Pkt(DHCPREQUEST, 2));
+    query->setCiaddr(IOAddress("10.0.0.9"));
+    ClientContext request(std::move(query), subnet);
+    request.setReservedAddr(IOAddress("10.0.0.5"));
+    RequestFields request_fields;
+    ASSERT_TRUE(RpcCodec::getRequestFields(request, request_fields));
+    EXPECT_EQ(IOAddress::toLong(IOAddress("10.0.0.9")), request_fields.request_addr_);
+}
+
+TEST(RpcCodecTest, decodeResult) {
+    // address 10.0.0.0 has zero bytes inside
+    const uint8_t body[] = {0x08, 0x01, 0x10, 0x80, 0x80, 0x80, 0x50, 0x18, 0x03};
+    LeaseResultMsg result;
+    ASSERT_TRUE(RpcCodec::decodeResult(body, sizeof(body), result));
+    EXPECT_TRUE(result.succeed_);
+    EXPECT_EQ(0x0a000000, result.addr_);
+    EXPECT_EQ(3, result.subnet_id_);
+}
+
+TEST(RpcCodecTest, decodeEmptyResult) {
+    LeaseResultMsg result;
+    result.succeed_ = true;
+    ASSERT_TRUE(RpcCodec::decodeResult(nullptr, 0, result));
+    EXPECT_FALSE(result.succeed_);
+    EXPECT_EQ(0, result.addr_);
+}
+
+TEST(RpcCodecTest, decodeSkipUnknownField) {
+    const uint8_t body[] = {0x08, 0x01, 0x62, 0x02, 0x00, 0x00, 0x18, 0x05};
+    LeaseResultMsg result;
+    ASSERT_TRUE(RpcCodec::decodeResult(body, sizeof(body), result));
+    EXPECT_TRUE(result.succeed_);
+    EXPECT_EQ(5, result.subnet_id_);
+}
+
+TEST(RpcCodecTest, decodeResultAddrs) {
+    // packed as proto3 does, then one more unpacked
+    const uint8_t body[] = {0x08, 0x01, 0x22, 0x03, 0x01, 0xac, 0x02, 0x18, 0x02, 0x20, 0x05};
+    LeaseResultMsg result;
+    ASSERT_TRUE(RpcCodec::decodeResult(body, sizeof(body), result));
+    EXPECT_TRUE(result.succeed_);
+    EXPECT_EQ(2, result.subnet_id_);
+    ASSERT_EQ(3, result.addr_count_);
+    EXPECT_EQ(1, result.addrs_[0]);
+    EXPECT_EQ(300, result.addrs_[1]);
+    EXPECT_EQ(5, result.addrs_[2]);
+
+    const uint8_t truncated[] = {0x08, 0x01, 0x22, 0x03, 0x01, 0xac};
+    EXPECT_FALSE(RpcCodec::decodeResult(truncated, sizeof(truncated), result));
+}
+
+TEST(RpcCodecTest, decodeTruncatedResult) {
+    const uint8_t body[] = {0x08, 0x01, 0x10, 0x80, 0x80};
+    LeaseResultMsg result;
+    EXPECT_FALSE(RpcCodec::decodeResult(body, sizeof(body), result));
+}
+
+};
@@ -0,0 +1,268 @@
+#include <kea/server/addr_block_mgr.h>
+#include <kea/rpc/allocate_backend.h>
+#include <kea/logging/logging.h>
+#include <kea/util/thread_affinity.h>
+#include <algorithm>
+
+using namespace kea::logging;
+using namespace kea::rpc;
+
+namespace kea {
+namespace server {
+
+const size_t AddrBlockMgr::MAX_RELEASE_COUNT;
+
+AddrBlockMgr::AddrBlockMgr(const AddrBlockConf& conf, const std::vector<uint32_t>& subnet_ids)
+    : conf_(conf),
+    min_grant_left_(std::chrono::seconds(2 * conf.offer_timeout_)),
+    stop_(true) {
+    for (auto subnet_id : subnet_ids) {
+        blocks_[subnet_id].reset(new SubnetBlock());
+    }
+}
+
+AddrBlockMgr::~AddrBlockMgr() {
+    stop();
+}
+
+void
+AddrBlockMgr::start() {
+    std::lock_guard<std::mutex> lock(refill_mutex_);
+    if (!stop_) {
+        return;
+    }
+
+    stop_ = false;
+    std::thread refill_thread([this]() {
+        kea::util::ThreadAffinity::instance().pinCurrent(kea::util::TC_RPC);
+        this->refillLoop();
+    });
+    refill_thread_ = std::move(refill_thread);
+}
+
+void
+AddrBlockMgr::stop() {
+    {
+        std::lock_guard<std::mutex> lock(refill_mutex_);
+        if (stop_) {
+            return;
+        }
+        stop_ = true;
+    }
+    refill_cond_.notify_one();
+    refill_thread_.join();
+
+    for (auto& subnet : blocks_) {
+        std::vector<uint32_t> addrs;
+        {
+            std::lock_guard<std::mutex> lock(subnet.second->mutex_);
+            for (auto& granted : subnet.second->free_) {
+                addrs.push_back(granted.addr_);
+            }
+            for (auto& offered : subnet.second->offers_) {
+                addrs.push_back(offered.second.granted_.addr_);
+            }
+            subnet.second->free_.clear();
+            subnet.second->offers_.clear();
+        }
+        release(subnet.first, addrs);
+    }
+}
+
+AddrBlockMgr::SubnetBlock*
+AddrBlockMgr::getSubnetBlock(uint32_t subnet_id) {
+    auto it = blocks_.find(subnet_id);
+    if (it == blocks_.end()) {
+        return nullptr;
+    }
+    return it->second.get();
+}
+
+bool
+AddrBlockMgr::offer(const std::string& client_key, uint32_t subnet_id, uint32_t& addr) {
+    SubnetBlock* block = getSubnetBlock(subnet_id);
+    if (block == nullptr) {
+        return false;
+    }
+
+    Clock::time_point now = Clock::now();
+    bool offered = false;
+    bool low = false;
+    {
+        std::lock_guard<std::mutex> lock(block->mutex_);
+        auto it = block->offers_.find(client_key);
+        if (it != block->offers_.end()) {
+            it->second.offer_expire_ = now + std::chrono::seconds(conf_.offer_timeout_);
+            addr = it->second.granted_.addr_;
+            return true;
+        }
+
+        // grants are acquired in order, the oldest is at front
+        while (!block->free_.empty() && block->free_.front().expire_ - now < min_grant_left_) {
+            block->free_.pop_front();
+        }
+        if (block->free_.empty()) {
+            low = true;
+        } else {
+            OfferedAddr offer;
+            offer.granted_ = block->free_.front();
+            offer.offer_expire_ = now + std::chrono::seconds(conf_.offer_timeout_);
+            block->free_.pop_front();
+            block->offers_[client_key] = offer;
+            addr = offer.granted_.addr_;
+            low = block->free_.size() < conf_.low_watermark_;
+            offered = true;
+        }
+    }
+
+    if (low) {
+        refill_cond_.notify_one();
+    }
+    return offered;
+}
+
+bool
+AddrBlockMgr::commit(const std::string& client_key, uint32_t subnet_id, uint32_t addr) {
+    SubnetBlock* block = getSubnetBlock(subnet_id);
+    if (block == nullptr) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(block->mutex_);
+    auto it = block->offers_.find(client_key);
+    if (it == block->offers_.end() || it->second.granted_.addr_ != addr) {
+        return false;
+    }
+
+    block->offers_.erase(it);
+    return true;
+}
+
+void
+AddrBlockMgr::abandon(const std::string& client_key, uint32_t subnet_id) {
+    SubnetBlock* block = getSubnetBlock(subnet_id);
+    if (block == nullptr) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(block->mutex_);
+    block->offers_.erase(client_key);
+}
+
+size_t
+AddrBlockMgr::getFreeCount(uint32_t subnet_id) {
+    SubnetBlock* block = getSubnetBlock(subnet_id);
+    if (block == nullptr) {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(block->mutex_);
+    return block->free_.size();
+}
+
+void
+AddrBlockMgr::refillLoop() {
+    while (true) {
+        for (auto& subnet : blocks_) {
+            refill(subnet.first, *subnet.second);
+        }
+
+        std::unique_lock<std::mutex> lock(refill_mutex_);
+        if (stop_) {
+            break;
+        }
+        refill_cond_.wait_for(lock, std::chrono::seconds(1));
+        if (stop_) {
+            break;
+        }
+    }
+}
+
+void
+AddrBlockMgr::refill(uint32_t subnet_id, SubnetBlock& block) {
+    Clock::time_point now = Clock::now();
+    std::vector<uint32_t> expiring;
+    size_t free_count = 0;
+    {
+        std::lock_guard<std::mutex> lock(block.mutex_);
+        for (auto it = block.offers_.begin(); it != block.offers_.end();) {
+            if (it->second.offer_expire_ <= now) {
+                if (it->second.granted_.expire_ - now < min_grant_left_) {
+                    expiring.push_back(it->second.granted_.addr_);
+                } else {
+                    block.free_.push_back(it->second.granted_);
+                }
+                it = block.offers_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        std::sort(block.free_.begin(), block.free_.end(), [](const GrantedAddr& a, const GrantedAddr& b) {
+            return a.expire_ < b.expire_;
+        });
+        while (!block.free_.empty() && block.free_.front().expire_ - now < min_grant_left_) {
+            expiring.push_back(block.free_.front().addr_);
+            block.free_.pop_front();
+        }
+        free_count = block.free_.size();
+    }
+
+    release(subnet_id, expiring);
+    if (free_count >= conf_.low_watermark_) {
+        return;
+    }
+
+    std::vector<uint32_t> addrs;
+    if (!acquire(subnet_id, addrs)) {
+        return;
+    }
+
+    GrantedAddr granted;
+    granted.expire_ = now + std::chrono::seconds(conf_.life_time_);
+    std::lock_guard<std::mutex> lock(block.mutex_);
+    for (auto addr : addrs) {
+        granted.addr_ = addr;
+        block.free_.push_back(granted);
+    }
+}
+
+bool
+AddrBlockMgr::acquire(uint32_t subnet_id, std::vector<uint32_t>& addrs) {
+    RequestFields fields;
+    fields.request_type_ = RT_ACQUIRE_BLOCK;
+    fields.subnet_id_ = subnet_id;
+    fields.block_size_ = conf_.block_size_;
+    fields.block_life_time_ = conf_.life_time_;
+
+    LeaseResultMsg result;
+    if (!AllocateBackend::instance().call(fields, result) || !result.succeed_) {
+        logWarning("AddrBlockMgr ", "Acquire address block in subnet $0 failed", subnet_id);
+        return false;
+    }
+
+    addrs.assign(result.addrs_, result.addrs_ + result.addr_count_);
+    logDebug("AddrBlockMgr ", "Acquire $0 addresses in subnet $1", addrs.size(), subnet_id);
+    return !addrs.empty();
+}
+
+void
+AddrBlockMgr::release(uint32_t subnet_id, const std::vector<uint32_t>& addrs) {
+    for (size_t begin = 0; begin < addrs.size(); begin += MAX_RELEASE_COUNT) {
+        RequestFields fields;
+        fields.request_type_ = RT_RELEASE_BLOCK;
+        fields.subnet_id_ = subnet_id;
+        fields.block_addrs_ = addrs.data() + begin;
+        fields.block_addr_count_ = std::min(MAX_RELEASE_COUNT, addrs.size() - begin);
+
+        // master takes an unreleased grant back once it expires
+        LeaseResultMsg result;
+        if (!AllocateBackend::instance().call(fields, result)) {
+            logWarning("AddrBlockMgr ", "Release $0 addresses in subnet $1 failed",
+                    fields.block_addr_count_, subnet_id);
+        }
+    }
+}
+
+};
+};
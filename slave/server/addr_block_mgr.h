@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace kea {
+namespace server {
+
+struct AddrBlockConf {
+    uint32_t block_size_;
+    uint32_t low_watermark_;
+    uint32_t life_time_;
+    uint32_t offer_timeout_;
+
+    AddrBlockConf()
+        : block_size_(64), low_watermark_(16), life_time_(600), offer_timeout_(10) {}
+};
+
+//blocks of addresses master granted to this slave for some subnets. a
+//discover is offered one of them without a round trip to master, the
+//request selecting it is acked locally and master only gets notified.
+//a background thread keeps every subnet above the low watermark, takes
+//back offers nobody requested and returns grants about to expire
+class AddrBlockMgr {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    AddrBlockMgr(const AddrBlockConf& conf, const std::vector<uint32_t>& subnet_ids);
+    ~AddrBlockMgr();
+
+    void start();
+    // return every address not committed yet to master
+    void stop();
+
+    // return false if subnet isn't served by blocks or no address left,
+    // a client asking again gets the address offered before
+    bool offer(const std::string& client_key, uint32_t subnet_id, uint32_t& addr);
+    // return true if addr was offered to client from a block, the offer is
+    // consumed and addr belongs to client from now on
+    bool commit(const std::string& client_key, uint32_t subnet_id, uint32_t addr);
+    // drop the offer of a conflict address, it's never offered again
+    void abandon(const std::string& client_key, uint32_t subnet_id);
+
+    size_t getFreeCount(uint32_t subnet_id);
+
+private:
+    struct GrantedAddr {
+        uint32_t addr_;
+        Clock::time_point expire_;
+    };
+
+    struct OfferedAddr {
+        GrantedAddr granted_;
+        Clock::time_point offer_expire_;
+    };
+
+    struct SubnetBlock {
+        std::mutex mutex_;
+        std::deque<GrantedAddr> free_;
+        std::unordered_map<std::string, OfferedAddr> offers_;
+    };
+
+    static const size_t MAX_RELEASE_COUNT = 512;
+
+    SubnetBlock* getSubnetBlock(uint32_t subnet_id);
+    void refillLoop();
+    void refill(uint32_t subnet_id, SubnetBlock& block);
+    bool acquire(uint32_t subnet_id, std::vector<uint32_t>& addrs);
+    void release(uint32_t subnet_id, const std::vector<uint32_t>& addrs);
+
+    AddrBlockConf conf_;
+    // keep a grant out of offers once it has less than this left
+    Clock::duration min_grant_left_;
+    // subnets are fixed after construction, only their blocks change
+    std::map<uint32_t, std::unique_ptr<SubnetBlock>> blocks_;
+    std::mutex refill_mutex_;
+    std::condition_variable refill_cond_;
+    bool stop_;
+    std::thread refill_thread_;
+};
+
+};
+};
@@ -0,0 +1,262 @@
+#include <kea/server/admission_queue.h>
+#include <kea/dhcp++/dhcp4.h>
+#include <algorithm>
+
+namespace kea {
+namespace server {
+
+// shared by every source beyond max buckets
+static const BucketKey OVERFLOW_BUCKET_KEY = {0xffffffff, 0xffffffff};
+
+AdmissionQueue::AdmissionQueue(const AdmissionConf& conf)
+    : conf_(conf), notifier_(nullptr), depth_(0), discover_depth_(0), high_water_(0),
+      stop_markers_(0), served_(0), wait_us_(0) {
+    shed_full_.store(0);
+    shed_evicted_.store(0);
+    shed_stale_.store(0);
+    promoted_.store(0);
+}
+
+BucketKey
+AdmissionQueue::getBucketKey(const Pkt& pkt, const PktHeader& header) {
+    BucketKey key;
+    key.relay_ = header.giaddr_;
+    key.ifindex_ = header.giaddr_ != 0 ? 0 : pkt.getIfaceIndex();
+    return key;
+}
+
+AdmissionQueue::Bucket&
+AdmissionQueue::getBucket(const BucketKey& key) {
+    auto it = buckets_.find(key);
+    if (it != buckets_.end()) {
+        return *it->second;
+    }
+
+    BucketKey bucket_key = key;
+    if (buckets_.size() >= conf_.max_buckets_) {
+        bucket_key = OVERFLOW_BUCKET_KEY;
+        it = buckets_.find(bucket_key);
+        if (it != buckets_.end()) {
+            return *it->second;
+        }
+    }
+
+    std::unique_ptr<Bucket> bucket(new Bucket());
+    bucket->key_ = bucket_key;
+    auto weight = conf_.weights_.find(bucket_key);
+    bucket->weight_ = weight != conf_.weights_.end() ? weight->second : 1;
+    bucket->deficit_ = 0;
+    bucket->active_ = false;
+    bucket->dropped_ = 0;
+    Bucket& result = *bucket;
+    buckets_.insert(std::make_pair(bucket_key, std::move(bucket)));
+    return result;
+}
+
+bool
+AdmissionQueue::makeRoom(Bucket& bucket, bool discover) {
+    Bucket* victim = &bucket;
+    for (auto active : active_) {
+        if (active->depth() > victim->depth()) {
+            victim = active;
+        }
+    }
+
+    // the longest bucket pays with its oldest discover, a request of
+    // another bucket is only pushed out for a request
+    if (!victim->discovers_.empty()) {
+        victim->discovers_.pop_front();
+        discover_depth_ -= 1;
+    } else if (!discover && victim != &bucket) {
+        victim->requests_.pop_front();
+    } else {
+        return false;
+    }
+
+    depth_ -= 1;
+    victim->dropped_ += 1;
+    if (victim->depth() == 0) {
+        active_.remove(victim);
+        victim->active_ = false;
+        victim->deficit_ = 0;
+    }
+    shed_evicted_.fetch_add(1);
+    return true;
+}
+
+bool
+AdmissionQueue::write(PktPtr pkt) {
+    if (pkt == nullptr) {
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            stop_markers_ += 1;
+        }
+        if (notifier_ != nullptr) {
+            notifier_->notify();
+        }
+        return true;
+    }
+
+    PktHeader header;
+    const kea::dhcp::OptionBuffer& data = pkt->getData();
+    bool known = !data.empty() && peekPktHeader(&data[0], data.size(), header);
+    return write(std::move(pkt), known ? &header : nullptr);
+}
+
+bool
+AdmissionQueue::write(PktPtr pkt, const PktHeader* header) {
+    bool discover = header != nullptr && header->msg_type_ == kea::dhcp::DHCPDISCOVER;
+    if (discover && conf_.secs_threshold_ != 0 && header->secs_ >= conf_.secs_threshold_) {
+        promoted_.fetch_add(1);
+        discover = false;
+    }
+    BucketKey key = {0, 0};
+    if (header != nullptr) {
+        key = getBucketKey(*pkt, *header);
+    } else {
+        key.ifindex_ = pkt->getIfaceIndex();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    Bucket& bucket = getBucket(key);
+    if ((discover && discover_depth_ >= conf_.discover_limit_) ||
+        (depth_ >= conf_.capacity_ && !makeRoom(bucket, discover))) {
+        bucket.dropped_ += 1;
+        shed_full_.fetch_add(1);
+        return false;
+    }
+
+    if (discover) {
+        bucket.discovers_.push_back(std::move(pkt));
+        discover_depth_ += 1;
+    } else {
+        bucket.requests_.push_back(std::move(pkt));
+    }
+    depth_ += 1;
+    high_water_ = std::max(high_water_, depth_);
+    if (!bucket.active_) {
+        bucket.active_ = true;
+        bucket.deficit_ = 0;
+        active_.push_back(&bucket);
+    }
+    lock.unlock();
+    if (notifier_ != nullptr) {
+        notifier_->notify();
+    }
+    return true;
+}
+
+bool
+AdmissionQueue::takeFresh(PktPtr& pkt) {
+    if (stop_markers_ != 0) {
+        stop_markers_ -= 1;
+        pkt = nullptr;
+        return true;
+    }
+
+    auto now = std::chrono::system_clock::now();
+    while (!active_.empty()) {
+        Bucket* bucket = active_.front();
+        if (bucket->deficit_ == 0) {
+            bucket->deficit_ = bucket->weight_;
+        }
+
+        if (!bucket->requests_.empty()) {
+            pkt = std::move(bucket->requests_.front());
+            bucket->requests_.pop_front();
+        } else {
+            pkt = std::move(bucket->discovers_.front());
+            bucket->discovers_.pop_front();
+            discover_depth_ -= 1;
+        }
+        depth_ -= 1;
+        bucket->deficit_ -= 1;
+
+        active_.pop_front();
+        if (bucket->depth() == 0) {
+            bucket->active_ = false;
+            bucket->deficit_ = 0;
+        } else if (bucket->deficit_ == 0) {
+            active_.push_back(bucket);
+        } else {
+            active_.push_front(bucket);
+        }
+
+        auto waited = now - pkt->getTimestamp();
+        if (conf_.max_age_.count() == 0 || waited <= conf_.max_age_) {
+            served_ += 1;
+            wait_us_ += std::chrono::duration_cast<std::chrono::microseconds>(waited).count();
+            return true;
+        }
+        bucket->dropped_ += 1;
+        shed_stale_.fetch_add(1);
+    }
+    return false;
+}
+
+bool
+AdmissionQueue::read(PktPtr& pkt) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return takeFresh(pkt);
+}
+
+size_t
+AdmissionQueue::readBatch(PktPtr* pkts, size_t max_count) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    size_t count = 0;
+    while (count < max_count && takeFresh(pkts[count])) {
+        if (pkts[count++] == nullptr) {
+            break;
+        }
+    }
+    return count;
+}
+
+bool
+AdmissionQueue::hasQueued() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    return depth_ != 0 || stop_markers_ != 0;
+}
+
+void
+AdmissionQueue::clear() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    for (auto& bucket : buckets_) {
+        bucket.second->requests_.clear();
+        bucket.second->discovers_.clear();
+        bucket.second->active_ = false;
+        bucket.second->deficit_ = 0;
+    }
+    active_.clear();
+    depth_ = 0;
+    discover_depth_ = 0;
+}
+
+AdmissionStats
+AdmissionQueue::getStats() {
+    AdmissionStats stats;
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stats.depth_ = depth_;
+        stats.discover_depth_ = discover_depth_;
+        stats.high_water_ = high_water_;
+        stats.served_ = served_;
+        stats.wait_us_ = wait_us_;
+        for (auto& bucket : buckets_) {
+            BucketStats bucket_stats;
+            bucket_stats.key_ = bucket.first;
+            bucket_stats.weight_ = bucket.second->weight_;
+            bucket_stats.depth_ = bucket.second->depth();
+            bucket_stats.dropped_ = bucket.second->dropped_;
+            stats.buckets_.push_back(bucket_stats);
+        }
+    }
+    stats.shed_full_ = shed_full_.load();
+    stats.shed_evicted_ = shed_evicted_.load();
+    stats.shed_stale_ = shed_stale_.load();
+    stats.promoted_ = promoted_.load();
+    return stats;
+}
+
+};
+};
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <kea/dhcp++/pkt.h>
+#include <kea/server/pkt_header.h>
+#include <kea/util/event_notifier.h>
+
+namespace kea {
+namespace server {
+
+using kea::dhcp::PktPtr;
+using kea::dhcp::Pkt;
+
+// where a query comes from, the relay for relayed queries otherwise the
+// interface it's received on
+struct BucketKey {
+    // in network order, zero for a query from a local client
+    uint32_t relay_;
+    uint32_t ifindex_;
+
+    bool operator<(const BucketKey& other) const {
+        return relay_ < other.relay_ || (relay_ == other.relay_ && ifindex_ < other.ifindex_);
+    }
+    bool operator==(const BucketKey& other) const {
+        return relay_ == other.relay_ && ifindex_ == other.ifindex_;
+    }
+};
+
+struct AdmissionConf {
+    size_t capacity_;
+    // discovers queued at most, the rest of the queue is kept for requests
+    size_t discover_limit_;
+    // a query which waited longer is dropped when a worker takes it, the
+    // client has retransmitted already. zero disables it
+    std::chrono::milliseconds max_age_;
+    // a discover whose client has been trying that many seconds is queued
+    // like a request, so it isn't shed forever under a storm. zero disables it
+    uint16_t secs_threshold_;
+    // queries a bucket may hand to workers per round, one if not listed
+    std::map<BucketKey, uint32_t> weights_;
+    // sources beyond that share one bucket
+    size_t max_buckets_;
+};
+
+struct BucketStats {
+    BucketKey key_;
+    uint32_t weight_;
+    size_t depth_;
+    uint64_t dropped_;
+};
+
+struct AdmissionStats {
+    size_t depth_;
+    size_t discover_depth_;
+    size_t high_water_;
+    // queries handed to the worker and the time they waited in total
+    uint64_t served_;
+    uint64_t wait_us_;
+    uint64_t shed_full_;
+    uint64_t shed_evicted_;
+    uint64_t shed_stale_;
+    uint64_t promoted_;
+    std::vector<BucketStats> buckets_;
+};
+
+//input queue between the receive thread and workers. the receive thread
+//never blocks, a query which doesn't fit is shed and counted instead of
+//being left to the kernel: discovers may only fill part of the queue, and
+//a full queue makes room at the expense of the longest bucket, taking its
+//oldest discover first. workers take queries bucket by bucket in deficit
+//round robin, up to the bucket weight per round and requests first within
+//a bucket, so one relay or vlan in a storm can't starve the others, and
+//drop whatever waited past max age
+class AdmissionQueue {
+public:
+    explicit AdmissionQueue(const AdmissionConf& conf);
+
+    // the worker reading the queue, it's woken up on every write
+    void setNotifier(kea::util::EventNotifier* notifier) { notifier_ = notifier; }
+
+    // nullptr is the stop marker of one worker, it's always queued
+    bool write(PktPtr pkt);
+    // with the header peeked already, nullptr if pkt couldn't be peeked
+    bool write(PktPtr pkt, const PktHeader* header);
+    // return false if nothing fresh is queued
+    bool read(PktPtr& pkt);
+    // up to max_count under one lock, a stop marker ends the batch
+    size_t readBatch(PktPtr* pkts, size_t max_count);
+    bool hasQueued();
+
+    void clear();
+    AdmissionStats getStats();
+
+    static BucketKey getBucketKey(const Pkt& pkt, const PktHeader& header);
+
+private:
+    struct Bucket {
+        BucketKey key_;
+        uint32_t weight_;
+        uint32_t deficit_;
+        bool active_;
+        uint64_t dropped_;
+        std::deque<PktPtr> requests_;
+        std::deque<PktPtr> discovers_;
+
+        size_t depth() const { return requests_.size() + discovers_.size(); }
+    };
+
+    Bucket& getBucket(const BucketKey& key);
+    bool makeRoom(Bucket& bucket, bool discover);
+    bool takeFresh(PktPtr& pkt);
+
+    AdmissionConf conf_;
+    std::mutex mutex_;
+    kea::util::EventNotifier* notifier_;
+    std::map<BucketKey, std::unique_ptr<Bucket>> buckets_;
+    // buckets with queries, the front one is served
+    std::list<Bucket*> active_;
+    size_t depth_;
+    size_t discover_depth_;
+    size_t high_water_;
+    size_t stop_markers_;
+    uint64_t served_;
+    uint64_t wait_us_;
+    std::atomic<uint64_t> shed_full_;
+    std::atomic<uint64_t> shed_evicted_;
+    std::atomic<uint64_t> shed_stale_;
+    std::atomic<uint64_t> promoted_;
+};
+
+};
+};
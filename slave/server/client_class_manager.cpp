@@ -1,18 +1,9 @@
 #include <kea/server/client_class_parser.h>
 #include <kea/server/client_class_manager.h>
 
-namespace {
-    static kea::server::ClientClassManager SingletonClientClassManager;
-}
-
 namespace kea {
 namespace server {
 
-ClientClassManager&
-ClientClassManager::instance() {
-    return SingletonClientClassManager;
-}
-
 void ClientClassManager::removeAll() {
     client_classes_.clear();
 }
@@ -27,7 +18,7 @@ void ClientClassManager::addClientClass(const std::string& name, const std::stri
     client_classes_.insert(std::make_pair(name, matcher));
 }
 
-std::vector<std::string> ClientClassManager::getMatchedClass(const Pkt& pkt) {
+std::vector<std::string> ClientClassManager::getMatchedClass(const Pkt& pkt) const {
     std::vector<std::string> classes;
     for(auto& pair : client_classes_) {
         if (pair.second(pkt)) {
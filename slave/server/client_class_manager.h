@@ -15,11 +15,10 @@ class DuplicateClientClassName : public Exception {
 
 class ClientClassManager {
     public:
-        static ClientClassManager& instance();
         ClientClassManager() {}
 
         void addClientClass(const std::string& name, const std::string& exp);
-        std::vector<std::string> getMatchedClass(const Pkt& pkt);
+        std::vector<std::string> getMatchedClass(const Pkt& pkt) const;
         void removeAll();
 
     private:
@@ -0,0 +1,59 @@
+#include <kea/server/config_snapshot.h>
+#include <atomic>
+
+namespace kea {
+namespace server {
+
+using kea::configure::JsonConf;
+
+static const char* SNAPSHOT_KEYS[] = {"subnet4", "client-classes"};
+
+ConfigSnapshotPtr
+ConfigHolder::acquire() const {
+    return std::atomic_load(&current_);
+}
+
+void
+ConfigHolder::publish(std::unique_ptr<ConfigSnapshot> snapshot) {
+    // only the control thread publishes
+    snapshot->version_ = ++version_;
+    std::atomic_store(&current_, ConfigSnapshotPtr(std::move(snapshot)));
+}
+
+uint64_t
+ConfigHolder::getVersion() const {
+    ConfigSnapshotPtr snapshot = acquire();
+    return snapshot != nullptr ? snapshot->version_ : 0;
+}
+
+static Json
+withoutSnapshot(const Json& root) {
+    Json::object items = root.object_items();
+    auto dhcp4 = items.find("dhcp4");
+    if (dhcp4 != items.end()) {
+        Json::object dhcp4_items = dhcp4->second.object_items();
+        for (auto key : SNAPSHOT_KEYS) {
+            dhcp4_items.erase(key);
+        }
+        dhcp4->second = Json(std::move(dhcp4_items));
+    }
+    return Json(std::move(items));
+}
+
+bool
+usesLocalEngine(const JsonConf& conf) {
+    return conf.root().hasKey("dhcp4.allocate-engine.type") &&
+        conf.root().getString("dhcp4.allocate-engine.type") == "local";
+}
+
+bool
+isSnapshotSwappable(const JsonConf& running, const JsonConf& next) {
+    if (usesLocalEngine(next)) {
+        return false;
+    }
+
+    return withoutSnapshot(*running.root().unwrapp()) == withoutSnapshot(*next.root().unwrapp());
+}
+
+};
+};
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <kea/configure/json_conf.h>
+#include <kea/server/subnet_mgr.h>
+#include <kea/server/hosts_in_mem.h>
+#include <kea/server/client_class_manager.h>
+#include <memory>
+#include <unordered_map>
+
+namespace kea {
+namespace server {
+
+//configuration a query is handled with. it is built completely before it
+//is published and never changes afterwards, an exchange waiting for master
+//or the ping check keeps the snapshot it started on until it's done. a
+//change to single subnets is made on a copy, which shares hosts, client
+//classes and the untouched subnets with the original
+struct ConfigSnapshot {
+    std::shared_ptr<const HostsInMem> host_mgr_;
+    SubnetMgr subnet_mgr_;
+    std::shared_ptr<const ClientClassManager> client_classes_;
+    // definitions the subnets were built from, keyed by subnet id
+    std::unordered_map<SubnetID, Json> subnet_confs_;
+    uint64_t version_;
+};
+
+typedef std::shared_ptr<const ConfigSnapshot> ConfigSnapshotPtr;
+
+//workers acquire the current snapshot per batch, reconfig publishes a new
+//one without stopping them. the old one goes away with its last reader
+class ConfigHolder {
+public:
+    ConfigHolder() : version_(0) {}
+
+    ConfigSnapshotPtr acquire() const;
+    // stamps the snapshot with the next version
+    void publish(std::unique_ptr<ConfigSnapshot> snapshot);
+    uint64_t getVersion() const;
+
+private:
+    ConfigSnapshotPtr current_;
+    uint64_t version_;
+};
+
+//sections a snapshot is built from, they're swapped while running. a
+//change anywhere else, option definitions and hook libraries included,
+//needs the server restarted
+bool isSnapshotSwappable(const kea::configure::JsonConf& running, const kea::configure::JsonConf& next);
+
+// the local engine allocates out of the subnets it was started with, so
+// they're never changed under it
+bool usesLocalEngine(const kea::configure::JsonConf& conf);
+
+};
+};
@@ -5,20 +5,34 @@ namespace kea {
 namespace server {
 
 static const int DEFAULT_QUEUE_SIZE = 1000;
+static const size_t SEND_BATCH_SIZE = 32;
+static const size_t PROCESS_BATCH_SIZE = 16;
 
-Dhcpv4SrvContext::Dhcpv4SrvContext(JsonConf& conf, SubnetMgr& subnet_mgr, 
-        BaseHostDataSource& host_mgr, PktQueue& in_queue, PktQueue& out_queue) 
+Dhcpv4SrvContext::Dhcpv4SrvContext(JsonConf& conf, const ConfigHolder& config_holder,
+        LeaseCache* lease_cache, OfferCache* offer_cache,
+        AddrBlockMgr* addr_block_mgr, std::shared_ptr<InflightTable> inflight_table,
+        ResponseCache* response_cache, InformCache* inform_cache, AdmissionQueue& in_queue, PktQueue& out_queue) 
     : in_queue_(in_queue), out_queue_(out_queue) {
-    server_.reset(new Dhcpv4Srv(&subnet_mgr, &host_mgr, out_queue));
+    server_ = kea::util::makeAligned<Dhcpv4Srv>(config_holder, lease_cache, offer_cache, addr_block_mgr, inflight_table,
+                response_cache, inform_cache, out_queue);
+    in_queue_.setNotifier(&server_->getNotifier());
 }
 
 void Dhcpv4SrvContext::run() {
-    PktPtr rsp(nullptr);
-    PktPtr query(nullptr);
+    PktPtr queries[PROCESS_BATCH_SIZE];
     while(true) {
-        in_queue_.blockingRead(query);
-        if (!query) { break; }
-        server_->processPacket(std::move(query));
+        server_->resumeCompleted();
+        size_t count = in_queue_.readBatch(queries, PROCESS_BATCH_SIZE);
+        if (count == 0) {
+            server_->getNotifier().wait([this]() {
+                return in_queue_.hasQueued() || server_->hasCompleted();
+            });
+            continue;
+        }
+
+        bool stop = (queries[count - 1] == nullptr);
+        server_->processBatch(queries, stop ? count - 1 : count);
+        if (stop) { break; }
     }
 }
 
@@ -33,6 +47,7 @@ ControlledDhcpv4Srv::ControlledDhcpv4Srv(const std::string& config_file_path)
     initStdOptions();
     initVendorOptions();
     initNic(*conf_);
+    initThreading(*conf_);
     Statistics::init();
 }
 
@@ -41,48 +56,89 @@ ControlledDhcpv4Srv::~ControlledDhcpv4Srv() {
 }
 
 void ControlledDhcpv4Srv::run() {
+    initThreading(*conf_);
     initCustomOptions(*conf_);
     initHooks(*conf_);
-    initClientClasses(*conf_);
-    initSubnetMgr();
+    initConfigSnapshot();
     initPingCheck(*conf_);
-    initRpcAllocateEngine(*conf_);
+    // the local engine is only started over again with the snapshot, never
+    // swapped under it
+    ConfigSnapshotPtr config = config_holder_.acquire();
+    initAllocateEngine(*conf_, config->subnet_mgr_, *config->host_mgr_);
+    lease_cache_ = createLeaseCache(*conf_);
+    offer_cache_ = createOfferCache(*conf_);
+    inflight_table_ = createInflightTable(*conf_);
+    response_cache_ = createResponseCache(*conf_);
+    inform_cache_ = createInformCache(*conf_);
+    addr_block_mgr_ = createAddrBlockMgr(*conf_);
+    if (addr_block_mgr_ != nullptr) {
+        addr_block_mgr_->start();
+    }
 
     createWorkers();
     runWorkers();
 }
 
 void
-ControlledDhcpv4Srv::initSubnetMgr() {
-    host_mgr_.reset(new HostsInMem());
-    subnet_mgr_ = createSubnetMgr(*conf_, *host_mgr_);
+ControlledDhcpv4Srv::initConfigSnapshot() {
+    config_holder_.publish(createConfigSnapshot(*conf_));
+}
+
+void
+ControlledDhcpv4Srv::publishConfig(std::unique_ptr<ConfigSnapshot> config) {
+    config_holder_.publish(std::move(config));
+    // entries are keyed by the version they were built on and never match
+    // again, a worker still on the old snapshot may add a few more of them
+    if (offer_cache_ != nullptr) {
+        offer_cache_->clear();
+    }
+    if (response_cache_ != nullptr) {
+        response_cache_->clear();
+    }
+    if (inform_cache_ != nullptr) {
+        inform_cache_->clear();
+    }
 }
 
 void ControlledDhcpv4Srv::runWorkers() {
-    for (auto& context : workers_) {
-        std::thread t(std::bind(&Dhcpv4SrvContext::run, context.get()));
+    for (size_t i = 0; i < workers_.size(); i++) {
+        std::thread t([i](Dhcpv4SrvContext* context) {
+            ThreadAffinity::instance().pinCurrent(TC_WORKER, static_cast<int>(i));
+            context->run();
+        }, workers_[i].get());
         worker_threads_.push_back(std::move(t));
     }
 
     std::thread send_pkt_thread([](PktQueue* out_queue) {
-        PktPtr rsp;
-        while(true) {
-            out_queue->blockingRead(rsp);
-            if (rsp == nullptr) {
-                break;
-            }
-            try {
-                logInfo("Dhcpv4Srv ", rsp->toText());
-                IfaceMgr::instance().send(*rsp);
-            } catch(kea::nic::SocketWriteError& e) {
-                logError("Dhcpv4Srv ", "!!socket write exception:$0", e.what());
+        ThreadAffinity::instance().pinCurrent(TC_TX);
+        PktPtr rsps[SEND_BATCH_SIZE];
+        bool stop = false;
+        while(!stop) {
+            size_t count = out_queue->blockingReadBatch(rsps, SEND_BATCH_SIZE);
+            for (size_t i = 0; i < count; i++) {
+                if (rsps[i] == nullptr) {
+                    stop = true;
+                    break;
+                }
+                try {
+                    logInfo("Dhcpv4Srv ", rsps[i]->toText());
+                    IfaceMgr::instance().send(*rsps[i]);
+                } catch(kea::nic::SocketWriteError& e) {
+                    logError("Dhcpv4Srv ", "!!socket write exception:$0", e.what());
+                }
+                rsps[i].reset();
             }
         } 
     }, out_queue_.get());
     send_pkt_thread_ = std::move(send_pkt_thread);
 
+    if (scaler_ != nullptr) {
+        scaler_->start();
+    }
+
     int stop_fd = pipefd_[0];
-    std::thread recv_pkt_thread([this](PktQueue* in_queue) {
+    std::thread recv_pkt_thread([this](PktDispatcher* dispatcher) {
+        ThreadAffinity::instance().pinCurrent(TC_RX);
         while(true) {
             PktPtr pkt = IfaceMgr::instance().receive4(this->pipefd_[0], 1000);
             if (this->stop_flag_.load()) {
@@ -90,10 +146,10 @@ void ControlledDhcpv4Srv::runWorkers() {
             }
 
             if (pkt) {
-                in_queue->blockingWrite(std::move(pkt));
+                dispatcher->dispatch(std::move(pkt));
             }
         }
-    }, in_queue_.get());
+    }, dispatcher_.get());
     recv_pkt_thread_ = std::move(recv_pkt_thread);
 }
 
@@ -105,17 +161,27 @@ void ControlledDhcpv4Srv::stop() {
     write(pipefd_[1], "1", 1);
     stop_flag_.store(true);
 
-    drainQueue(*in_queue_);
+    if (scaler_ != nullptr) {
+        scaler_->stop();
+    }
+
+    for (auto& in_queue : in_queues_) {
+        in_queue->clear();
+    }
     recv_pkt_thread_.join();
 
-    kea::rpc::RpcAllocateEngine::instance().stop();
+    // unused addresses go back to master while rpc still works
+    if (addr_block_mgr_ != nullptr) {
+        addr_block_mgr_->stop();
+    }
+    kea::rpc::AllocateBackend::instance().stop();
     Pinger::instance().stop();
 
     for(auto& context : workers_) {
         context->stop();
     }
 
-    drainQueue(*out_queue_);
+    // the send thread is the only reader, it flushes what workers left
     out_queue_->blockingWrite(nullptr);
     send_pkt_thread_.join();
 
@@ -135,20 +201,59 @@ ControlledDhcpv4Srv::createWorkers() {
     pipe(pipefd_);
     if (conf_->root().hasKey("dhcp4.worker-count")) {
         worker_count_ = conf_->root().getInt("dhcp4.worker-count");
+    } else if (!ThreadAffinity::instance().getCpus(TC_WORKER).empty()) {
+        worker_count_ = ThreadAffinity::instance().getCpus(TC_WORKER).size();
     } else {
         worker_count_ = std::thread::hardware_concurrency();
     }
-    in_queue_.reset(new PktQueue(worker_count_ * DEFAULT_QUEUE_SIZE));
-    out_queue_.reset(new PktQueue(worker_count_ * DEFAULT_QUEUE_SIZE));
-    for (int i = 0; i < worker_count_; i++) {
+    bool numa_local = numaLocalWorkers(*conf_);
+    // with scaling on every worker up to max runs, worker-count of them
+    // are active at first
+    WorkerScalerConf scaler_conf;
+    bool scaling = getWorkerScalerConf(*conf_, worker_count_, scaler_conf);
+    int pool_size = scaling ? static_cast<int>(scaler_conf.max_workers_) : worker_count_;
+    out_queue_ = kea::util::makeAligned<PktQueue>(pool_size * DEFAULT_QUEUE_SIZE);
+    in_queues_.clear();
+    std::vector<AdmissionQueue*> queues;
+    for (int i = 0; i < pool_size; i++) {
+        // queues and server state of the worker live on its node
+        NumaPreferred numa_preferred(numa_local ? ThreadAffinity::instance().getNumaNode(TC_WORKER, i) : -1);
+        in_queues_.push_back(createAdmissionQueue(*conf_, DEFAULT_QUEUE_SIZE));
+        queues.push_back(in_queues_.back().get());
         workers_.push_back(std::unique_ptr<Dhcpv4SrvContext>
-                (new Dhcpv4SrvContext(*conf_, *subnet_mgr_, *host_mgr_, *in_queue_, *out_queue_)));
+                (new Dhcpv4SrvContext(*conf_, config_holder_, lease_cache_.get(), offer_cache_.get(), addr_block_mgr_.get(), inflight_table_,
+                     response_cache_.get(), inform_cache_.get(), *in_queues_.back(), *out_queue_)));
+    }
+    dispatcher_.reset(new PktDispatcher(queues));
+
+    scaler_.reset();
+    if (scaling) {
+        dispatcher_->setActiveCount(std::max<size_t>(worker_count_, scaler_conf.min_workers_));
+        scaler_.reset(new WorkerScaler(scaler_conf, *dispatcher_, std::move(queues)));
     }
 }
 
 kea::controller::CmdResult ControlledDhcpv4Srv::handleCmd(const std::string& cmd_name, JsonObject params) {
     if (cmd_name == "reconfig") {
         return reconfigCmd();
+    } else if (cmd_name == "invalidate_lease_cache") {
+        return invalidateLeaseCacheCmd(params);
+    } else if (cmd_name == "inflight_stats") {
+        return inflightStatsCmd();
+    } else if (cmd_name == "admission_stats") {
+        return admissionStatsCmd();
+    } else if (cmd_name == "queue_stats") {
+        return queueStatsCmd();
+    } else if (cmd_name == "set_workers") {
+        return setWorkersCmd(params);
+    } else if (cmd_name == "subnet_add" || cmd_name == "subnet_update" || cmd_name == "subnet_del" ||
+            cmd_name == "subnet_option_set" || cmd_name == "subnet_option_del") {
+        return subnetCmd(cmd_name, params);
+    } else if (cmd_name == "pool_add" || cmd_name == "pool_del" ||
+            cmd_name == "host_add" || cmd_name == "host_del") {
+        // master allocates out of the pools and owns the reservations, its
+        // pool commands change both
+        return std::make_pair(cmd_name + " is handled by master", false);
     } else if (cmd_name == "stop") {
         stop();
         return std::make_pair(std::string("stop"), true);
@@ -157,13 +262,175 @@ kea::controller::CmdResult ControlledDhcpv4Srv::handleCmd(const std::string& cmd
     }
 }
 
+kea::controller::CmdResult 
+ControlledDhcpv4Srv::invalidateLeaseCacheCmd(JsonObject params) {
+    if (lease_cache_ == nullptr) {
+        return std::make_pair(std::string("lease cache isn't enabled"), false);
+    }
+
+    if (params.hasKey("ip")) {
+        size_t count = lease_cache_->eraseAddr(IOAddress::toLong(IOAddress(params.getString("ip"))));
+        return std::make_pair(std::to_string(count), true);
+    }
+
+    lease_cache_->clear();
+    return std::make_pair(std::string("invalidate_lease_cache"), true);
+}
+
+kea::controller::CmdResult 
+ControlledDhcpv4Srv::inflightStatsCmd() {
+    if (inflight_table_ == nullptr) {
+        return std::make_pair(std::string("inflight check isn't enabled"), false);
+    }
+
+    return std::make_pair(std::string("suppressed:") + std::to_string(inflight_table_->getSuppressedCount()) +
+            " inflight:" + std::to_string(inflight_table_->size()), true);
+}
+
+static std::string
+bucketsToText(const std::vector<BucketStats>& buckets) {
+    std::string text;
+    for (auto& bucket : buckets) {
+        if (bucket.key_.relay_ != 0) {
+            text += "\nrelay " + IOAddress::fromLong(bucket.key_.relay_).toText();
+        } else {
+            const Iface* iface = IfaceMgr::instance().getIface(static_cast<int>(bucket.key_.ifindex_));
+            text += "\ninterface " + (iface != nullptr ? iface->getName() : std::to_string(bucket.key_.ifindex_));
+        }
+        text += " weight:" + std::to_string(bucket.weight_) + " depth:" + std::to_string(bucket.depth_) +
+            " dropped:" + std::to_string(bucket.dropped_);
+    }
+    return text;
+}
+
+AdmissionStats
+ControlledDhcpv4Srv::sumAdmissionStats() {
+    AdmissionStats total = {0, 0, 0, 0, 0, 0, 0, 0, 0, {}};
+    std::map<BucketKey, BucketStats> buckets;
+    for (auto& in_queue : in_queues_) {
+        AdmissionStats stats = in_queue->getStats();
+        total.depth_ += stats.depth_;
+        total.discover_depth_ += stats.discover_depth_;
+        total.high_water_ += stats.high_water_;
+        total.served_ += stats.served_;
+        total.wait_us_ += stats.wait_us_;
+        total.shed_full_ += stats.shed_full_;
+        total.shed_evicted_ += stats.shed_evicted_;
+        total.shed_stale_ += stats.shed_stale_;
+        total.promoted_ += stats.promoted_;
+        for (auto& bucket : stats.buckets_) {
+            auto it = buckets.insert(std::make_pair(bucket.key_, bucket));
+            if (it.second == false) {
+                it.first->second.depth_ += bucket.depth_;
+                it.first->second.dropped_ += bucket.dropped_;
+            }
+        }
+    }
+
+    for (auto& bucket : buckets) {
+        total.buckets_.push_back(bucket.second);
+    }
+    return total;
+}
+
+kea::controller::CmdResult 
+ControlledDhcpv4Srv::admissionStatsCmd() {
+    AdmissionStats stats = sumAdmissionStats();
+    return std::make_pair(std::string("depth:") + std::to_string(stats.depth_) +
+            " discover_depth:" + std::to_string(stats.discover_depth_) +
+            " shed_full:" + std::to_string(stats.shed_full_) +
+            " shed_evicted:" + std::to_string(stats.shed_evicted_) +
+            " shed_stale:" + std::to_string(stats.shed_stale_) +
+            " promoted:" + std::to_string(stats.promoted_) + bucketsToText(stats.buckets_), true);
+}
+
+static std::string
+queueStatsToText(const kea::util::QueueStats& stats) {
+    return stats.name_ + " depth:" + std::to_string(stats.depth_) + " high_water:" + std::to_string(stats.high_water_);
+}
+
+kea::controller::CmdResult 
+ControlledDhcpv4Srv::queueStatsCmd() {
+    AdmissionStats input = sumAdmissionStats();
+    std::string text = "input depth:" + std::to_string(input.depth_) +
+        " high_water:" + std::to_string(input.high_water_) +
+        " wait_us:" + std::to_string(input.served_ != 0 ? input.wait_us_ / input.served_ : 0);
+    text += "\n" + queueStatsToText(kea::util::QueueStats{"output", out_queue_->size(), out_queue_->getHighWater()});
+
+    std::vector<kea::util::QueueStats> rpc_stats;
+    kea::rpc::AllocateBackend::instance().getQueueStats(rpc_stats);
+    for (auto& stats : rpc_stats) {
+        text += "\n" + queueStatsToText(stats);
+    }
+    text += "\n" + queueStatsToText(Pinger::instance().getQueueStats());
+    text += "\nworkers active:" + std::to_string(dispatcher_->getActiveCount()) +
+        " max:" + std::to_string(dispatcher_->getWorkerCount());
+    return std::make_pair(text, true);
+}
+
+kea::controller::CmdResult 
+ControlledDhcpv4Srv::setWorkersCmd(JsonObject params) {
+    if (!params.hasKey("count")) {
+        return std::make_pair(std::string("set_workers needs count"), false);
+    }
+
+    // the scaler, if on, keeps moving the count from here
+    dispatcher_->setActiveCount(params.getUint("count"));
+    return std::make_pair(std::string("active workers:") + std::to_string(dispatcher_->getActiveCount()), true);
+}
+
+kea::controller::CmdResult 
+ControlledDhcpv4Srv::subnetCmd(const std::string& cmd_name, JsonObject params) {
+    if (usesLocalEngine(*conf_)) {
+        return std::make_pair(std::string("subnets of the local allocate engine only change by reconfig"), false);
+    }
+
+    // the change is made on a copy of the running snapshot, which workers
+    // keep using until the copy is published
+    try {
+        std::unique_ptr<ConfigSnapshot> config(new ConfigSnapshot(*config_holder_.acquire()));
+        applySubnetDelta(cmd_name, params, *config);
+        size_t subnet_count = config->subnet_mgr_.size();
+        publishConfig(std::move(config));
+        logInfo("Dhcpv4Srv ", "$0 swapped to configure version $1", cmd_name, config_holder_.getVersion());
+        return std::make_pair(std::string("subnets:") + std::to_string(subnet_count), true);
+    } catch (const std::exception &e){
+        logError("Dhcpv4Srv ", "!!!$0 get exception: $1", cmd_name, e.what());
+        return std::make_pair(e.what(), false);
+    }
+}
+
 kea::controller::CmdResult 
 ControlledDhcpv4Srv::reconfigCmd() {
+    std::unique_ptr<JsonConf> conf;
+    try {
+        conf = JsonConf::parseFile(config_file_path_);
+    } catch (const std::exception &e){
+        logError("Dhcpv4Srv ", "!!!reconfig get exception: $0", e.what());
+        return std::make_pair(e.what(), false);
+    }
+
+    // workers keep serving on the old snapshot while the new one is built,
+    // exchanges already started finish on it
+    if (isSnapshotSwappable(*conf_, *conf)) {
+        try {
+            // the rest of conf is the same as the running one, which hook
+            // libraries still point into, so that one is kept
+            publishConfig(createConfigSnapshot(*conf));
+            logInfo("Dhcpv4Srv ", "reconfig swapped to configure version $0", config_holder_.getVersion());
+            return std::make_pair(std::string("reconfig"), true);
+        } catch (const std::exception &e){
+            logError("Dhcpv4Srv ", "!!!reconfig get exception: $0", e.what());
+            logWarning("Dhcpv4Srv ", "reconfig failed and using old configure to run");
+            return std::make_pair(e.what(), false);
+        }
+    }
+
     auto conf_backup = std::move(conf_);
     stop();
 
     try {
-        conf_ = JsonConf::parseFile(config_file_path_);
+        conf_ = std::move(conf);
         run();
         return std::make_pair(std::string("reconfig"), true);
     } catch (const std::exception &e){
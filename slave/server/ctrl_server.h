@@ -4,24 +4,26 @@
 
 #include <kea/configure/json_conf.h>
 #include <kea/server/server.h>
+#include <kea/server/admission_queue.h>
+#include <kea/server/pkt_dispatcher.h>
+#include <kea/server/worker_scaler.h>
 #include <kea/controller/cmd_server.h>
 #include <kea/util/encode/hex.h>
-#include <folly/MPMCQueue.h>
+#include <kea/util/aligned_ptr.h>
 
 namespace kea {
 namespace server {
 
-typedef folly::MPMCQueue<PktPtr> PktQueue;
-typedef std::unique_ptr<PktQueue> PktQueuePtr;
+typedef kea::util::AlignedPtr<PktQueue> PktQueuePtr;
 
 class Dhcpv4SrvContext {
 public:
-    explicit Dhcpv4SrvContext(kea::configure::JsonConf& conf, SubnetMgr& subnet_mgr, BaseHostDataSource& host_mgr, PktQueue& in_queue, PktQueue& out_queue);
+    explicit Dhcpv4SrvContext(kea::configure::JsonConf& conf, const ConfigHolder& config_holder, LeaseCache* lease_cache, OfferCache* offer_cache, AddrBlockMgr* addr_block_mgr, std::shared_ptr<InflightTable> inflight_table, ResponseCache* response_cache, InformCache* inform_cache, AdmissionQueue& in_queue, PktQueue& out_queue);
     void run();
     void stop();
 
-    std::unique_ptr<Dhcpv4Srv> server_;
-    PktQueue& in_queue_;
+    kea::util::AlignedPtr<Dhcpv4Srv> server_;
+    AdmissionQueue& in_queue_;
     PktQueue& out_queue_;
 };
 
@@ -37,8 +39,16 @@ public:
 private:
     void createWorkers();
     void runWorkers();
-    void initSubnetMgr();
+    void initConfigSnapshot();
+    void publishConfig(std::unique_ptr<ConfigSnapshot> config);
     kea::controller::CmdResult reconfigCmd();
+    kea::controller::CmdResult invalidateLeaseCacheCmd(kea::configure::JsonObject params);
+    kea::controller::CmdResult inflightStatsCmd();
+    kea::controller::CmdResult admissionStatsCmd();
+    kea::controller::CmdResult queueStatsCmd();
+    kea::controller::CmdResult setWorkersCmd(kea::configure::JsonObject params);
+    kea::controller::CmdResult subnetCmd(const std::string& cmd_name, kea::configure::JsonObject params);
+    AdmissionStats sumAdmissionStats();
 
     std::string config_file_path_;
     int   worker_count_;
@@ -49,9 +59,18 @@ private:
     std::unique_ptr<kea::configure::JsonConf> conf_; 
     int pipefd_[2];
     std::atomic<bool> stop_flag_;
-    std::unique_ptr<SubnetMgr> subnet_mgr_;
-    std::unique_ptr<BaseHostDataSource> host_mgr_;
-    PktQueuePtr in_queue_;
+    ConfigHolder config_holder_;
+    std::unique_ptr<LeaseCache> lease_cache_;
+    std::unique_ptr<OfferCache> offer_cache_;
+    std::unique_ptr<AddrBlockMgr> addr_block_mgr_;
+    std::shared_ptr<InflightTable> inflight_table_;
+    std::unique_ptr<ResponseCache> response_cache_;
+    std::unique_ptr<InformCache> inform_cache_;
+    // one per worker, filled by the dispatcher
+    std::vector<std::unique_ptr<AdmissionQueue>> in_queues_;
+    std::unique_ptr<PktDispatcher> dispatcher_;
+    // nullptr unless worker scaling is on
+    std::unique_ptr<WorkerScaler> scaler_;
     PktQueuePtr out_queue_;
 };
 }; 
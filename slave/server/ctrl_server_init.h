@@ -4,13 +4,24 @@
 #include <kea/server/ctrl_server.h>
 #include <kea/server/hosts_in_mem.h>
 #include <kea/server/subnet_mgr.h>
+#include <kea/server/lease_cache.h>
+#include <kea/server/offer_cache.h>
+#include <kea/server/inflight_table.h>
+#include <kea/server/response_cache.h>
+#include <kea/server/inform_cache.h>
+#include <kea/server/admission_queue.h>
+#include <kea/server/worker_scaler.h>
+#include <kea/server/addr_block_mgr.h>
+#include <kea/server/local_allocate_engine.h>
 #include <kea/server/client_class_manager.h>
+#include <kea/server/config_snapshot.h>
 #include <kea/dhcp++/std_option_defs.h>
 #include <kea/dhcp++/vendor_option_defs.h>
 #include <kea/dhcp++/dhcp4.h>
 #include <kea/dhcp++/libdhcp++.h>
 #include <kea/dhcp++/option_description.h>
 #include <kea/util/strutil.h>
+#include <kea/util/thread_affinity.h>
 #include <kea/hooks/hooks_manager.h>
 #include <kea/rpc/rpc_allocate_engine.h>
 #include <kea/logging/logging.h>
@@ -18,6 +29,7 @@
 #include <kea/ping/ping.h>
 
 #include <regex>
+#include <fstream>
 #include <string>
 #include <memory>
 #include <unistd.h>
@@ -45,6 +57,21 @@ using namespace kea::nic;
 
 static const string DEFAULT_KEA_MASTER_IP = "127.0.0.1";
 static const int DEFAULT_KEA_MASTER_PORT = 5555;
+static const int DEFAULT_LEASE_CACHE_SIZE = 1000000;
+static const int DEFAULT_LEASE_CACHE_MAX_STALENESS = 600;
+static const int DEFAULT_OFFER_CACHE_SIZE = 100000;
+static const int DEFAULT_OFFER_TIMEOUT = 60;
+static const int DEFAULT_INFLIGHT_MAX_AGE = 10;
+static const int DEFAULT_RESPONSE_CACHE_SIZE = 100000;
+static const int DEFAULT_RESPONSE_CACHE_WINDOW = 10;
+static const int DEFAULT_INFORM_CACHE_SIZE = 1024;
+static const int DEFAULT_DISCOVER_SHARE = 80;
+static const int DEFAULT_MAX_BUCKETS = 1024;
+static const int DEFAULT_SCALE_GROW_WAIT = 5;
+static const int DEFAULT_SCALE_SHRINK_WAIT = 1;
+static const int DEFAULT_SCALE_INTERVAL = 1000;
+static const uint32_t DEFAULT_PING_CONFLICT_CANDIDATES = 4;
+static const uint32_t MAX_PING_CONFLICT_CANDIDATES = 16;
 
 void 
 initNic(const JsonConf& conf) {
@@ -64,6 +91,59 @@ initNic(const JsonConf& conf) {
     }
 }
 
+// numa node of the device behind iface, -1 if unknown
+static int
+getIfaceNode(const std::string& iface_name) {
+    std::ifstream node_file("/sys/class/net/" + iface_name + "/device/numa_node");
+    int node = -1;
+    if (!(node_file >> node)) {
+        return -1;
+    }
+    return node;
+}
+
+void
+initThreading(const JsonConf& conf) {
+    static const char* class_keys[TC_COUNT] = {
+        "rx", "tx", "workers", "rpc", "ping", "statistics", "control"
+    };
+
+    ThreadAffinity& affinity = ThreadAffinity::instance();
+    affinity.clear();
+    if (conf.root().hasKey("dhcp4.threading") == false) {
+        return;
+    }
+
+    for (int i = 0; i < TC_COUNT; i++) {
+        string key = string("dhcp4.threading.") + class_keys[i];
+        if (conf.root().hasKey(key)) {
+            affinity.setCpus(static_cast<ThreadClass>(i), parseCpuList(conf.root().getString(key)));
+        }
+    }
+
+    // queries arrive on whatever cpu the nic interrupts, the rx thread is
+    // better off on the same node
+    int rx_node = affinity.getNumaNode(TC_RX);
+    if (rx_node < 0) {
+        return;
+    }
+    for (auto& iface : IfaceMgr::instance().getIfaces()) {
+        int iface_node = getIfaceNode(iface->getName());
+        if (iface_node >= 0 && iface_node != rx_node) {
+            logWarning("Dhcpv4Srv ", "rx thread is on numa node $0 but $1 is on node $2",
+                    rx_node, iface->getName(), iface_node);
+        }
+    }
+}
+
+bool
+numaLocalWorkers(const JsonConf& conf) {
+    if (conf.root().hasKey("dhcp4.threading.numa-local-memory")) {
+        return conf.root().getBool("dhcp4.threading.numa-local-memory");
+    }
+    return true;
+}
+
 void
 initLog(const JsonConf& conf) {
     string log_path = "";
@@ -90,6 +170,7 @@ void
 initPingCheck(const JsonConf& conf) {
     bool ping_enable = false;
     uint32_t time_out = 1;
+    uint32_t candidate_count = DEFAULT_PING_CONFLICT_CANDIDATES;
     if (conf.root().hasKey("dhcp4.ping-check")) {
         if (conf.root().hasKey("dhcp4.ping-check.enable")) {
             ping_enable = conf.root().getBool("dhcp4.ping-check.enable");
@@ -97,14 +178,54 @@ initPingCheck(const JsonConf& conf) {
                 if (conf.root().hasKey("dhcp4.ping-check.timeout")) {
                     time_out = conf.root().getInt("dhcp4.ping-check.timeout");
                 }
+                if (conf.root().hasKey("dhcp4.ping-check.conflict-candidates")) {
+                    candidate_count = conf.root().getInt("dhcp4.ping-check.conflict-candidates");
+                    if (candidate_count == 0 || candidate_count > MAX_PING_CONFLICT_CANDIDATES) {
+                        kea_throw(BadValue, "ping conflict candidates should be in [1, " << MAX_PING_CONFLICT_CANDIDATES << "]");
+                    }
+                }
             }
         }
     }
-    Pinger::init(ping_enable, time_out);
+    Pinger::init(ping_enable, time_out, candidate_count);
 }
 
 void 
 initRpcAllocateEngine(const JsonConf& conf) {
+    if (conf.root().hasKey("dhcp4.kea-masters")) {
+        std::vector<kea::rpc::RpcMasterConf> masters;
+        vector<JsonObject> master_confs = conf.root().getObjects("dhcp4.kea-masters");
+        for (auto& master_conf : master_confs) {
+            kea::rpc::RpcMasterConf master(DEFAULT_KEA_MASTER_IP, DEFAULT_KEA_MASTER_PORT);
+            if (master_conf.hasKey("ip")) {
+                master.ip_ = master_conf.getString("ip");
+            }
+            if (master_conf.hasKey("port")) {
+                master.port_ = master_conf.getInt("port");
+            }
+            if (master_conf.hasKey("subnet-ids")) {
+                for (auto subnet_id : master_conf.getUints("subnet-ids")) {
+                    master.subnet_ids_.push_back(subnet_id);
+                }
+            }
+            if (master_conf.hasKey("role")) {
+                string role = master_conf.getString("role");
+                if (role == "standby") {
+                    master.standby_ = true;
+                } else if (role != "primary") {
+                    kea_throw(BadValue, "unknown kea master role " << role);
+                }
+            }
+            masters.push_back(master);
+        }
+
+        if (masters.empty()) {
+            kea_throw(BadValue, "kea-masters is empty");
+        }
+        kea::rpc::RpcAllocateEngine::init(masters);
+        return;
+    }
+
     std::string kea_master_ip = DEFAULT_KEA_MASTER_IP;
     if (conf.root().hasKey("dhcp4.kea-master-ip")) {
             kea_master_ip = conf.root().getString("dhcp4.kea-master-ip");
@@ -117,6 +238,32 @@ initRpcAllocateEngine(const JsonConf& conf) {
     kea::rpc::RpcAllocateEngine::init(kea_master_ip, kea_master_port);
 }
 
+void
+initAllocateEngine(const JsonConf& conf, const SubnetMgr& subnet_mgr, const BaseHostDataSource& host_mgr) {
+    string type = "master";
+    if (conf.root().hasKey("dhcp4.allocate-engine.type")) {
+        type = conf.root().getString("dhcp4.allocate-engine.type");
+    }
+
+    if (type == "master") {
+        initRpcAllocateEngine(conf);
+    } else if (type == "local") {
+        LocalAllocateConf local_conf;
+        if (conf.root().hasKey("dhcp4.allocate-engine.journal")) {
+            local_conf.journal_path_ = conf.root().getString("dhcp4.allocate-engine.journal");
+        }
+        if (conf.root().hasKey("dhcp4.allocate-engine.journal-size")) {
+            local_conf.journal_capacity_ = conf.root().getInt("dhcp4.allocate-engine.journal-size");
+        }
+        if (conf.root().hasKey("dhcp4.allocate-engine.journal-sync")) {
+            local_conf.journal_sync_ = conf.root().getBool("dhcp4.allocate-engine.journal-sync");
+        }
+        LocalAllocateEngine::init(local_conf, subnet_mgr, host_mgr);
+    } else {
+        kea_throw(BadValue, "unknown allocate engine type " << type);
+    }
+}
+
 void 
 initHooks(const JsonConf& conf) {
     if (conf.root().hasKey("dhcp4.hooks-libraries")) {
@@ -124,16 +271,17 @@ initHooks(const JsonConf& conf) {
     }
 }
 
-void 
-initClientClasses(const JsonConf& conf) {
-    ClientClassManager::instance().removeAll();
+std::unique_ptr<ClientClassManager>
+createClientClasses(const JsonConf& conf) {
+    std::unique_ptr<ClientClassManager> client_class_mgr(new ClientClassManager());
     if (conf.root().hasKey("dhcp4.client-classes")) {
         vector<JsonObject> client_classes = conf.root().getObjects("dhcp4.client-classes");
         for(auto& client_class : client_classes) {
-            ClientClassManager::instance().addClientClass(client_class.getString("name"), 
+            client_class_mgr->addClientClass(client_class.getString("name"), 
                     client_class.getString("test"));
         }
     }
+    return client_class_mgr;
 }
 
 void 
@@ -257,6 +405,25 @@ createSubnet(const JsonObject& subnet) {
                 initOptionData(subnet4->getOptdata(), subnet);
             }
 
+            if (subnet.hasKey("rapid-commit")) {
+                subnet4->setRapidCommit(subnet.getBool("rapid-commit"));
+            }
+
+            Subnet::LeaseJitter jitter;
+            if (subnet.hasKey("renew-jitter")) {
+                jitter.renew_jitter_ = subnet.getUint("renew-jitter");
+            }
+            if (subnet.hasKey("lifetime-jitter")) {
+                jitter.lifetime_jitter_ = subnet.getUint("lifetime-jitter");
+            }
+            if (subnet.hasKey("renewal-smoothing-window")) {
+                jitter.smoothing_window_ = subnet.getUint("renewal-smoothing-window");
+            }
+            if (jitter.renew_jitter_ > 100 || jitter.lifetime_jitter_ > 100) {
+                kea_throw(BadValue, "jitter of subnet " << subnetID << " should be a percent in [0, 100]");
+            }
+            subnet4->setLeaseJitter(jitter);
+
             return subnet4;
         } else {
             logWarning("Dhcpv4Srv ", "The format of subnet should be address/mask");
@@ -267,30 +434,367 @@ createSubnet(const JsonObject& subnet) {
     return nullptr;
 }
 
-std::unique_ptr<SubnetMgr> 
-createSubnetMgr(const JsonConf& conf, BaseHostDataSource& host_mgr) {
-    SubnetMgr* subnet_mgr = new SubnetMgr();
+// reservations of a subnet, each is given by hw-address or duid. the local
+// allocate engine keeps them, with master a discover only asks for the
+// reserved address and master, which owns the reservations, decides
+void
+initReservations(const JsonObject& subnet, SubnetID subnet_id, HostsInMem& hosts) {
+    if (!subnet.hasKey("reservations")) {
+        return;
+    }
+
+    for (auto& reservation : subnet.getObjects("reservations")) {
+        string identifier_name = reservation.hasKey("hw-address") ? "hw-address" : "duid";
+        if (!reservation.hasKey(identifier_name) || !reservation.hasKey("ip-address")) {
+            kea_throw(BadValue, "reservation in subnet " << subnet_id <<
+                    " should have hw-address or duid and ip-address");
+        }
+        string hostname = reservation.hasKey("hostname") ? reservation.getString("hostname") : "";
+        hosts.add(std::unique_ptr<Host>(new Host(reservation.getString(identifier_name), identifier_name,
+                        subnet_id, IOAddress(reservation.getString("ip-address")), hostname)));
+    }
+}
+
+void
+initSubnets(const JsonConf& conf, ConfigSnapshot& snapshot) {
     vector<JsonObject> subnets = conf.root().getObjects("dhcp4.subnet4");
 
+    std::shared_ptr<HostsInMem> hosts(new HostsInMem());
     for (auto& subnet : subnets) {
         auto subnet_ptr = createSubnet(subnet);
         if ( subnet_ptr != nullptr) { 
-            if (!subnet_mgr->add(std::unique_ptr<Subnet>(subnet_ptr))) {
-                kea_throw(DuplicateSubnetID, "ID of the new IPv4 subnet '" << subnet_ptr->getID() << "' is already in use");
+            SubnetID subnet_id = subnet_ptr->getID();
+            if (!snapshot.subnet_mgr_.add(std::unique_ptr<Subnet>(subnet_ptr))) {
+                kea_throw(DuplicateSubnetID, "ID of the new IPv4 subnet '" << subnet_id << "' is already in use");
             }
+            snapshot.subnet_confs_[subnet_id] = *subnet.unwrapp();
+            initReservations(subnet, subnet_id, *hosts);
         }
     }
+    snapshot.host_mgr_ = std::move(hosts);
+}
 
-    return std::unique_ptr<SubnetMgr>(subnet_mgr);
+std::unique_ptr<ConfigSnapshot>
+createConfigSnapshot(const JsonConf& conf) {
+    std::unique_ptr<ConfigSnapshot> snapshot(new ConfigSnapshot());
+    initSubnets(conf, *snapshot);
+    snapshot->client_classes_ = createClientClasses(conf);
+    return snapshot;
 }
 
+// code of the option an option-data entry or a command names, by code or
+// by name
+int
+getOptionCode(const JsonObject& option) {
+    const OptionDefinition* def = nullptr;
+    if (option.hasKey("code")) {
+        def = LibDHCP::getStdOptionDef(option.getInt("code"));
+    } else if (option.hasKey("name")) {
+        def = LibDHCP::getStdOptionDef(option.getString("name"));
+    } else {
+        kea_throw(BadValue, "option should be given by code or name");
+    }
 
-void 
-drainQueue(PktQueue& queue) {
-    PktPtr query(nullptr);
-    while (queue.isEmpty() == false) {
-        queue.blockingRead(query);
+    if (def == nullptr) {
+        kea_throw(BadValue, "unknown option " << option);
+    }
+    return def->getCode();
+}
+
+Json
+changeSubnetOption(const Json& subnet_conf, const JsonObject& params, bool set) {
+    JsonObject key = set ? params.getObject("option") : params;
+    int code = getOptionCode(key);
+
+    Json::object items = subnet_conf.object_items();
+    Json::array options;
+    bool found = false;
+    for (auto& option : items["option-data"].array_items()) {
+        if (getOptionCode(JsonObject(&option)) != code) {
+            options.push_back(option);
+        } else if (!found) {
+            found = true;
+            if (set) {
+                options.push_back(*key.unwrapp());
+            }
+        }
+    }
+
+    if (!found) {
+        if (!set) {
+            kea_throw(BadValue, "option " << code << " isn't set");
+        }
+        options.push_back(*key.unwrapp());
+    }
+    items["option-data"] = Json(std::move(options));
+    return Json(std::move(items));
+}
+
+// subnet_add and subnet_update take a subnet the way subnet4 holds it,
+// reservations included, subnet_option_set an entry of its option-data. the
+// reservations only decide what gets offered and committed through master,
+// pools aren't read at all. only the changed subnet is built, the rest of
+// the snapshot is shared with the running one
+void
+applySubnetDelta(const string& cmd_name, const JsonObject& params, ConfigSnapshot& snapshot) {
+    if (cmd_name == "subnet_del") {
+        SubnetID subnet_id = params.getUint("id");
+        if (!snapshot.subnet_mgr_.del(subnet_id)) {
+            kea_throw(BadValue, "subnet " << subnet_id << " doesn't exist");
+        }
+        snapshot.subnet_confs_.erase(subnet_id);
+        std::shared_ptr<HostsInMem> hosts(new HostsInMem(*snapshot.host_mgr_));
+        hosts->del(subnet_id);
+        snapshot.host_mgr_ = std::move(hosts);
+        return;
+    }
+
+    Json subnet_conf;
+    if (cmd_name == "subnet_add" || cmd_name == "subnet_update") {
+        subnet_conf = *params.getObject("subnet").unwrapp();
+    } else {
+        SubnetID subnet_id = params.getUint("id");
+        auto running = snapshot.subnet_confs_.find(subnet_id);
+        if (running == snapshot.subnet_confs_.end()) {
+            kea_throw(BadValue, "subnet " << subnet_id << " doesn't exist");
+        }
+        subnet_conf = changeSubnetOption(running->second, params, cmd_name == "subnet_option_set");
+    }
+
+    std::unique_ptr<Subnet> subnet(createSubnet(JsonObject(&subnet_conf)));
+    if (subnet == nullptr) {
+        kea_throw(BadValue, "invalid subnet " << JsonObject(&subnet_conf));
+    }
+    SubnetID subnet_id = subnet->getID();
+    if (cmd_name == "subnet_add") {
+        if (!snapshot.subnet_mgr_.add(std::move(subnet))) {
+            kea_throw(DuplicateSubnetID, "ID of the new IPv4 subnet '" << subnet_id << "' is already in use");
+        }
+    } else if (!snapshot.subnet_mgr_.update(std::move(subnet))) {
+        kea_throw(BadValue, "subnet " << subnet_id << " doesn't exist");
+    }
+    snapshot.subnet_confs_[subnet_id] = subnet_conf;
+
+    // option changes keep the reservations, and the hosts stay shared
+    if (cmd_name == "subnet_add" || cmd_name == "subnet_update") {
+        std::shared_ptr<HostsInMem> hosts(new HostsInMem(*snapshot.host_mgr_));
+        hosts->del(subnet_id);
+        initReservations(JsonObject(&snapshot.subnet_confs_[subnet_id]), subnet_id, *hosts);
+        snapshot.host_mgr_ = std::move(hosts);
+    }
+}
+
+std::unique_ptr<LeaseCache>
+createLeaseCache(const JsonConf& conf) {
+    if (!conf.root().hasKey("dhcp4.lease-cache") ||
+        !conf.root().getBool("dhcp4.lease-cache.enable")) {
+        return nullptr;
+    }
+
+    int max_size = DEFAULT_LEASE_CACHE_SIZE;
+    if (conf.root().hasKey("dhcp4.lease-cache.max-size")) {
+        max_size = conf.root().getInt("dhcp4.lease-cache.max-size");
+    }
+    int max_staleness = DEFAULT_LEASE_CACHE_MAX_STALENESS;
+    if (conf.root().hasKey("dhcp4.lease-cache.max-staleness")) {
+        max_staleness = conf.root().getInt("dhcp4.lease-cache.max-staleness");
+    }
+    return std::unique_ptr<LeaseCache>(new LeaseCache(max_size, max_staleness));
+}
+
+std::unique_ptr<OfferCache>
+createOfferCache(const JsonConf& conf) {
+    if (!conf.root().hasKey("dhcp4.offer-cache") ||
+        !conf.root().getBool("dhcp4.offer-cache.enable")) {
+        return nullptr;
+    }
+
+    int max_size = DEFAULT_OFFER_CACHE_SIZE;
+    if (conf.root().hasKey("dhcp4.offer-cache.max-size")) {
+        max_size = conf.root().getInt("dhcp4.offer-cache.max-size");
+    }
+    int offer_timeout = DEFAULT_OFFER_TIMEOUT;
+    if (conf.root().hasKey("dhcp4.offer-cache.offer-timeout")) {
+        offer_timeout = conf.root().getInt("dhcp4.offer-cache.offer-timeout");
+    }
+    return std::unique_ptr<OfferCache>(new OfferCache(max_size, offer_timeout));
+}
+
+std::shared_ptr<InflightTable>
+createInflightTable(const JsonConf& conf) {
+    if (!conf.root().hasKey("dhcp4.inflight-check") ||
+        !conf.root().getBool("dhcp4.inflight-check.enable")) {
+        return nullptr;
+    }
+
+    int max_age = DEFAULT_INFLIGHT_MAX_AGE;
+    if (conf.root().hasKey("dhcp4.inflight-check.max-age")) {
+        max_age = conf.root().getInt("dhcp4.inflight-check.max-age");
+    }
+    return std::make_shared<InflightTable>(max_age);
+}
+
+std::unique_ptr<ResponseCache>
+createResponseCache(const JsonConf& conf) {
+    if (!conf.root().hasKey("dhcp4.response-cache") ||
+        !conf.root().getBool("dhcp4.response-cache.enable")) {
+        return nullptr;
+    }
+
+    int max_size = DEFAULT_RESPONSE_CACHE_SIZE;
+    if (conf.root().hasKey("dhcp4.response-cache.max-size")) {
+        max_size = conf.root().getInt("dhcp4.response-cache.max-size");
+    }
+    int window = DEFAULT_RESPONSE_CACHE_WINDOW;
+    if (conf.root().hasKey("dhcp4.response-cache.window")) {
+        window = conf.root().getInt("dhcp4.response-cache.window");
+    }
+    return std::unique_ptr<ResponseCache>(new ResponseCache(max_size, window));
+}
+
+std::unique_ptr<InformCache>
+createInformCache(const JsonConf& conf) {
+    if (!conf.root().hasKey("dhcp4.inform-cache") ||
+        !conf.root().getBool("dhcp4.inform-cache.enable")) {
+        return nullptr;
+    }
+
+    int max_size = DEFAULT_INFORM_CACHE_SIZE;
+    if (conf.root().hasKey("dhcp4.inform-cache.max-size")) {
+        max_size = conf.root().getInt("dhcp4.inform-cache.max-size");
+    }
+    return std::unique_ptr<InformCache>(new InformCache(max_size));
+}
+
+std::unique_ptr<AddrBlockMgr>
+createAddrBlockMgr(const JsonConf& conf) {
+    if (!conf.root().hasKey("dhcp4.address-block") ||
+        !conf.root().getBool("dhcp4.address-block.enable")) {
+        return nullptr;
+    }
+
+    AddrBlockConf block_conf;
+    if (conf.root().hasKey("dhcp4.address-block.block-size")) {
+        block_conf.block_size_ = conf.root().getInt("dhcp4.address-block.block-size");
+    }
+    if (conf.root().hasKey("dhcp4.address-block.low-watermark")) {
+        block_conf.low_watermark_ = conf.root().getInt("dhcp4.address-block.low-watermark");
+    }
+    if (conf.root().hasKey("dhcp4.address-block.life-time")) {
+        block_conf.life_time_ = conf.root().getInt("dhcp4.address-block.life-time");
+    }
+    if (conf.root().hasKey("dhcp4.address-block.offer-timeout")) {
+        block_conf.offer_timeout_ = conf.root().getInt("dhcp4.address-block.offer-timeout");
+    }
+
+    if (block_conf.block_size_ == 0 || block_conf.block_size_ > kea::rpc::LeaseResultMsg::MAX_ADDRS) {
+        kea_throw(BadValue, "address block size should be in [1, " << kea::rpc::LeaseResultMsg::MAX_ADDRS << "]");
+    }
+    if (block_conf.life_time_ <= 4 * block_conf.offer_timeout_) {
+        kea_throw(BadValue, "address block life time should be longer than 4 times of offer timeout");
+    }
+
+    // reservations are only known by master, so leave subnets with
+    // reserved clients out
+    vector<uint32_t> subnet_ids;
+    for (auto subnet_id : conf.root().getUints("dhcp4.address-block.subnet-ids")) {
+        subnet_ids.push_back(subnet_id);
+    }
+    return std::unique_ptr<AddrBlockMgr>(new AddrBlockMgr(block_conf, subnet_ids));
+}
+
+std::unique_ptr<AdmissionQueue>
+createAdmissionQueue(const JsonConf& conf, size_t capacity) {
+    AdmissionConf admission_conf;
+    admission_conf.capacity_ = capacity;
+    admission_conf.max_age_ = std::chrono::milliseconds(0);
+    admission_conf.secs_threshold_ = 0;
+    admission_conf.max_buckets_ = DEFAULT_MAX_BUCKETS;
+    int discover_share = DEFAULT_DISCOVER_SHARE;
+    if (conf.root().hasKey("dhcp4.admission")) {
+        if (conf.root().hasKey("dhcp4.admission.discover-share")) {
+            discover_share = conf.root().getInt("dhcp4.admission.discover-share");
+        }
+        if (conf.root().hasKey("dhcp4.admission.max-age")) {
+            admission_conf.max_age_ = std::chrono::milliseconds(conf.root().getUint("dhcp4.admission.max-age"));
+        }
+        if (conf.root().hasKey("dhcp4.admission.secs-threshold")) {
+            admission_conf.secs_threshold_ = conf.root().getUint("dhcp4.admission.secs-threshold");
+        }
+        if (conf.root().hasKey("dhcp4.admission.max-buckets")) {
+            admission_conf.max_buckets_ = conf.root().getUint("dhcp4.admission.max-buckets");
+        }
+        if (conf.root().hasKey("dhcp4.admission.weights")) {
+            for (auto& weight_conf : conf.root().getObjects("dhcp4.admission.weights")) {
+                BucketKey key = {0, 0};
+                if (weight_conf.hasKey("relay")) {
+                    key.relay_ = IOAddress::toLong(IOAddress(weight_conf.getString("relay")));
+                } else if (weight_conf.hasKey("interface")) {
+                    const Iface* iface = IfaceMgr::instance().getIface(weight_conf.getString("interface"));
+                    if (iface == nullptr) {
+                        kea_throw(BadValue, "unknown interface " << weight_conf.getString("interface") << " in admission weights");
+                    }
+                    key.ifindex_ = iface->getIndex();
+                } else {
+                    kea_throw(BadValue, "admission weight needs relay or interface");
+                }
+
+                uint32_t weight = weight_conf.getUint("weight");
+                if (weight == 0) {
+                    kea_throw(BadValue, "admission weight should be positive");
+                }
+                admission_conf.weights_[key] = weight;
+            }
+        }
+    }
+
+    if (discover_share <= 0 || discover_share > 100) {
+        kea_throw(BadValue, "discover share of input queue should be in [1, 100]");
+    }
+    admission_conf.discover_limit_ = capacity * discover_share / 100;
+    return std::unique_ptr<AdmissionQueue>(new AdmissionQueue(admission_conf));
+}
+
+// return false if worker scaling is off, worker_count is where the active
+// count starts, it decides the bounds left out
+bool
+getWorkerScalerConf(const JsonConf& conf, int worker_count, WorkerScalerConf& scaler_conf) {
+    if (!conf.root().hasKey("dhcp4.worker-scaling.enable") ||
+        !conf.root().getBool("dhcp4.worker-scaling.enable")) {
+        return false;
+    }
+
+    scaler_conf.min_workers_ = 1;
+    scaler_conf.max_workers_ = worker_count;
+    scaler_conf.grow_wait_ = std::chrono::milliseconds(DEFAULT_SCALE_GROW_WAIT);
+    scaler_conf.shrink_wait_ = std::chrono::milliseconds(DEFAULT_SCALE_SHRINK_WAIT);
+    scaler_conf.interval_ = std::chrono::milliseconds(DEFAULT_SCALE_INTERVAL);
+    if (conf.root().hasKey("dhcp4.worker-scaling.min-workers")) {
+        scaler_conf.min_workers_ = conf.root().getUint("dhcp4.worker-scaling.min-workers");
+    }
+    if (conf.root().hasKey("dhcp4.worker-scaling.max-workers")) {
+        scaler_conf.max_workers_ = conf.root().getUint("dhcp4.worker-scaling.max-workers");
+    }
+    if (conf.root().hasKey("dhcp4.worker-scaling.grow-wait")) {
+        scaler_conf.grow_wait_ = std::chrono::milliseconds(conf.root().getUint("dhcp4.worker-scaling.grow-wait"));
+    }
+    if (conf.root().hasKey("dhcp4.worker-scaling.shrink-wait")) {
+        scaler_conf.shrink_wait_ = std::chrono::milliseconds(conf.root().getUint("dhcp4.worker-scaling.shrink-wait"));
+    }
+    if (conf.root().hasKey("dhcp4.worker-scaling.interval")) {
+        scaler_conf.interval_ = std::chrono::milliseconds(conf.root().getUint("dhcp4.worker-scaling.interval"));
+    }
+
+    if (scaler_conf.min_workers_ == 0 || scaler_conf.min_workers_ > scaler_conf.max_workers_) {
+        kea_throw(BadValue, "worker scaling needs 0 < min-workers <= max-workers");
+    }
+    if (scaler_conf.shrink_wait_ >= scaler_conf.grow_wait_) {
+        kea_throw(BadValue, "worker scaling shrink-wait should be below grow-wait");
+    }
+    if (scaler_conf.interval_.count() == 0) {
+        kea_throw(BadValue, "worker scaling interval should be positive");
     }
+    return true;
 }
 
 }
@@ -1,5 +1,6 @@
 #include <kea/server/hosts_in_mem.h>
 #include <kea/exceptions/exceptions.h>
+#include <algorithm>
 #include <ostream>
 
 namespace kea {
@@ -25,67 +26,92 @@ HostCollection HostsInMem::getAll4(const IOAddress& address) const {
                   " for a host, specified address was " << address.toText());
     }
 
-    HostCollection hosts;
-    for (auto& host : hosts_) {
-        if (host->getIPv4Reservation() == address) {
-            hosts.push_back(host.get());
-        }
+    auto hosts = addrs_.find(static_cast<uint32_t>(address.toV4().to_ulong()));
+    if (hosts == addrs_.end()) {
+        return HostCollection();
     }
-    return std::move(hosts);
+    return hosts->second;
 }
 
 const Host* HostsInMem::get4(SubnetID subnet_id, const IOAddress& address) const {
-    for (auto& host : hosts_) {
-        if (host->getIPv4SubnetID() == subnet_id && host->getIPv4Reservation() == address) {
-            return (host.get());
-        }
-    }
-    return (nullptr);
+    auto host = subnet_addrs_.find(getAddressKey(subnet_id, address));
+    return (host != subnet_addrs_.end() ? host->second : nullptr);
 }
 
 const Host* HostsInMem::get4(SubnetID subnet_id, Host::IdentifierType type, 
         const uint8_t* identifier, size_t len) const {
-    for (auto& host : hosts_) {
-        if (host->getIPv4SubnetID() != subnet_id) {
-            continue;
-        }
-        
-        if (host->getIdentifierType() != type) {
-            continue;
-        }
+    auto host = identifiers_.find(getIdentifierKey(subnet_id, type, identifier, len));
+    return (host != identifiers_.end() ? host->second : nullptr);
+}
 
-        const std::vector<uint8_t> identifierVec = host->getIdentifier();
-        if (len != identifierVec.size()) {
-            continue;
+const Host* HostsInMem::get4(SubnetID subnet_id, const HWAddr* hwaddr, 
+        const DUID* duid) const {
+    if (hwaddr != nullptr) {
+        const Host* host = getByIdentifier(subnet_id, Host::IDENT_HWADDR, hwaddr->hwaddr_);
+        if (host != nullptr && *host->getHWAddress() == *hwaddr) {
+            return (host);
         }
+    }
 
-        if (memcmp(identifier, &identifierVec[0], len) == 0) {
-            return (host.get());
-        }
+    if (duid != nullptr) {
+        return (getByIdentifier(subnet_id, Host::IDENT_DUID, duid->getDuid()));
     }
     return (nullptr);
 }
 
-const Host* HostsInMem::get4(SubnetID subnet_id, const HWAddr* hwaddr, 
-        const DUID* duid) const {
-    for (auto& host : hosts_) {
-        if (subnet_id != host->getIPv4SubnetID()) {
-            continue;
-        }
+const Host* HostsInMem::getByIdentifier(SubnetID subnet_id, Host::IdentifierType type,
+        const std::vector<uint8_t>& identifier) const {
+    return (get4(subnet_id, type, identifier.empty() ? nullptr : &identifier[0], identifier.size()));
+}
 
-        const HWAddr *hhwaddr = host->getHWAddress();
-        if (hwaddr != nullptr && hhwaddr != nullptr && *hhwaddr == *hwaddr) {
-            return (host.get());
-        } 
-        
-        const DUID *hduid = host->getDuid();
-        if (duid != nullptr && hduid != nullptr && *hduid == *duid) {
-            return (host.get());
-        } 
+std::string HostsInMem::getIdentifierKey(SubnetID subnet_id, Host::IdentifierType type,
+        const uint8_t* identifier, size_t len) {
+    std::string key(reinterpret_cast<const char*>(&subnet_id), sizeof(subnet_id));
+    key.push_back(static_cast<char>(type));
+    key.append(reinterpret_cast<const char*>(identifier), len);
+    return key;
+}
+
+uint64_t HostsInMem::getAddressKey(SubnetID subnet_id, const IOAddress& address) {
+    return (static_cast<uint64_t>(subnet_id) << 32) | address.toV4().to_ulong();
+}
+
+void HostsInMem::index(const Host* host) {
+    identifiers_[getIdentifierKey(host->getIPv4SubnetID(), host->getIdentifierType(),
+            host->getIdentifier().data(), host->getIdentifier().size())] = host;
+    if (!host->getIPv4Reservation().isV4Zero()) {
+        subnet_addrs_[getAddressKey(host->getIPv4SubnetID(), host->getIPv4Reservation())] = host;
+        addrs_[static_cast<uint32_t>(host->getIPv4Reservation().toV4().to_ulong())].push_back(host);
+    }
+}
+
+void HostsInMem::unindex(const Host* host) {
+    identifiers_.erase(getIdentifierKey(host->getIPv4SubnetID(), host->getIdentifierType(),
+            host->getIdentifier().data(), host->getIdentifier().size()));
+    if (!host->getIPv4Reservation().isV4Zero()) {
+        subnet_addrs_.erase(getAddressKey(host->getIPv4SubnetID(), host->getIPv4Reservation()));
+        auto hosts = addrs_.find(static_cast<uint32_t>(host->getIPv4Reservation().toV4().to_ulong()));
+        if (hosts != addrs_.end()) {
+            hosts->second.erase(std::remove(hosts->second.begin(), hosts->second.end(), host),
+                    hosts->second.end());
+            if (hosts->second.empty()) {
+                addrs_.erase(hosts);
+            }
+        }
     }
-    return (nullptr);
 }
 
+void HostsInMem::del(SubnetID subnet_id) {
+    // the hosts of the subnet are moved to the end in one piece
+    auto last = std::stable_partition(hosts_.begin(), hosts_.end(),
+            [subnet_id](const std::shared_ptr<const Host>& host) {
+                return host->getIPv4SubnetID() != subnet_id;
+            });
+    for (auto host = last; host != hosts_.end(); ++host) {
+        unindex(host->get());
+    }
+    hosts_.erase(last, hosts_.end());
+}
 
 void HostsInMem::add(std::unique_ptr<Host> host) {
     if (host->getIPv4SubnetID() == 0) {
@@ -129,6 +155,7 @@ void HostsInMem::add(std::unique_ptr<Host> host) {
                 << ": There's already a reservation for this address");
     }
 
+    index(host.get());
     hosts_.push_back(std::move(host));
 }
 
@@ -4,6 +4,8 @@
 #include <kea/server/host.h>
 #include <kea/server/subnet_id.h>
 #include <kea/server/base_host_data_source.h>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 using namespace kea::dhcp;
@@ -11,6 +13,9 @@ using namespace kea::dhcp;
 namespace kea {
 namespace server {
 
+//reservations are found by hash on (subnet, identifier), (subnet, address)
+//and address. a copy shares the hosts and copies the indexes, so the hosts
+//of a subnet can be changed on a copy while the original is read
 class HostsInMem : public BaseHostDataSource {
 public:
     virtual ~HostsInMem() { }
@@ -27,10 +32,26 @@ public:
 
     virtual void add(std::unique_ptr<Host>) ;
 
+    // drops every reservation of the subnet
+    void del(SubnetID subnet_id);
+    size_t size() const { return hosts_.size(); }
+
     virtual std::string getType() const { return (std::string("in memory")); }
 
 private:
-    std::vector<std::unique_ptr<Host>> hosts_;
+    static std::string getIdentifierKey(SubnetID subnet_id, Host::IdentifierType type,
+            const uint8_t* identifier, size_t len);
+    static uint64_t getAddressKey(SubnetID subnet_id, const IOAddress& address);
+    const Host* getByIdentifier(SubnetID subnet_id, Host::IdentifierType type,
+            const std::vector<uint8_t>& identifier) const;
+    void index(const Host* host);
+    void unindex(const Host* host);
+
+    std::vector<std::shared_ptr<const Host>> hosts_;
+    std::unordered_map<std::string, const Host*> identifiers_;
+    std::unordered_map<uint64_t, const Host*> subnet_addrs_;
+    // in the order hosts were added
+    std::unordered_map<uint32_t, HostCollection> addrs_;
 };
 };
 };
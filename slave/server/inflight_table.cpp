@@ -0,0 +1,97 @@
+#include <kea/server/inflight_table.h>
+#include <functional>
+
+namespace kea {
+namespace server {
+
+const size_t InflightTable::SHARD_COUNT;
+const size_t InflightTable::PRUNE_THRESHOLD;
+
+InflightTable::InflightTable(uint32_t max_age)
+    : max_age_(std::chrono::seconds(max_age)) {
+    suppressed_count_.store(0);
+}
+
+std::string
+InflightTable::getExchangeKey(const std::string& client_key, uint32_t xid, uint8_t msg_type) {
+    if (client_key.empty()) {
+        return client_key;
+    }
+
+    std::string exchange_key(client_key);
+    exchange_key.append(reinterpret_cast<const char*>(&xid), sizeof(xid));
+    exchange_key.push_back(static_cast<char>(msg_type));
+    return exchange_key;
+}
+
+InflightTable::Shard&
+InflightTable::getShard(const std::string& exchange_key) {
+    return shards_[std::hash<std::string>()(exchange_key) % SHARD_COUNT];
+}
+
+InflightTable::Token
+InflightTable::begin(const std::string& exchange_key) {
+    Clock::time_point now = Clock::now();
+    if (!exchange_key.empty()) {
+        Shard& shard = getShard(exchange_key);
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        auto result = shard.exchanges_.insert(std::make_pair(exchange_key, now));
+        if (!result.second) {
+            if (now - result.first->second < max_age_) {
+                suppressed_count_.fetch_add(1);
+                return nullptr;
+            }
+            result.first->second = now;
+        }
+
+        if (shard.exchanges_.size() > PRUNE_THRESHOLD) {
+            pruneExchanges(shard, now);
+        }
+    }
+
+    // the token owns nothing, its deleter ends the exchange. keeping the
+    // table alive through it lets a context outlive the server it came from
+    std::shared_ptr<InflightTable> table = shared_from_this();
+    return Token(static_cast<void*>(this), [table, exchange_key, now](void*) {
+        table->finish(exchange_key, now);
+    });
+}
+
+void
+InflightTable::finish(const std::string& exchange_key, Clock::time_point started) {
+    if (exchange_key.empty()) {
+        return;
+    }
+
+    Shard& shard = getShard(exchange_key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    auto iter = shard.exchanges_.find(exchange_key);
+    // a newer copy took over an exchange which was thought lost
+    if (iter != shard.exchanges_.end() && iter->second == started) {
+        shard.exchanges_.erase(iter);
+    }
+}
+
+void
+InflightTable::pruneExchanges(Shard& shard, Clock::time_point now) {
+    for (auto iter = shard.exchanges_.begin(); iter != shard.exchanges_.end(); ) {
+        if (now - iter->second >= max_age_) {
+            iter = shard.exchanges_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+size_t
+InflightTable::size() {
+    size_t count = 0;
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        std::lock_guard<std::mutex> lock(shards_[i].mutex_);
+        count += shards_[i].exchanges_.size();
+    }
+    return count;
+}
+
+};
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <unordered_map>
+
+namespace kea {
+namespace server {
+
+//exchanges being handled, keyed by client key, xid and message type. a
+//retransmission arriving while the first copy still waits for master or
+//the ping check is dropped, the answer to the first copy carries the same
+//xid and serves both. an exchange stays in flight until the token begin
+//returned is gone, or max_age passed in case it got lost
+class InflightTable : public std::enable_shared_from_this<InflightTable> {
+public:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::shared_ptr<void> Token;
+
+    explicit InflightTable(uint32_t max_age);
+
+    static std::string getExchangeKey(const std::string& client_key, uint32_t xid, uint8_t msg_type);
+
+    // return nullptr if the same exchange is already in flight
+    Token begin(const std::string& exchange_key);
+
+    size_t size();
+    uint64_t getSuppressedCount() const { return suppressed_count_.load(); }
+
+private:
+    struct Shard {
+        std::mutex mutex_;
+        std::unordered_map<std::string, Clock::time_point> exchanges_;
+    };
+
+    static const size_t SHARD_COUNT = 16;
+    static const size_t PRUNE_THRESHOLD = 4096;
+
+    Shard& getShard(const std::string& exchange_key);
+    void finish(const std::string& exchange_key, Clock::time_point started);
+    void pruneExchanges(Shard& shard, Clock::time_point now);
+
+    Clock::duration max_age_;
+    std::atomic<uint64_t> suppressed_count_;
+    Shard shards_[SHARD_COUNT];
+};
+
+};
+};
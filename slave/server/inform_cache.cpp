@@ -0,0 +1,129 @@
+#include <kea/server/inform_cache.h>
+#include <kea/dhcp++/dhcp4.h>
+#include <kea/dhcp++/option_int_array.h>
+#include <functional>
+
+namespace kea {
+namespace server {
+
+using namespace kea::dhcp;
+
+const size_t InformCache::SHARD_COUNT;
+
+namespace {
+
+// header, sname, file and magic cookie
+const size_t OPTIONS_OFFSET = Pkt::DHCPV4_PKT_HDR_LEN + 4;
+
+};
+
+InformCache::InformCache(size_t max_size) {
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        shards_[i].reset(new Shard(max_size / SHARD_COUNT + 1));
+    }
+}
+
+bool
+InformCache::isPerClientOption(uint8_t code) {
+    return code == DHO_DHCP_MESSAGE_TYPE || code == DHO_DHCP_CLIENT_IDENTIFIER ||
+        code == DHO_DHCP_AGENT_OPTIONS || code == DHO_SUBNET_SELECTION;
+}
+
+std::string
+InformCache::getInformKey(uint64_t config_version, uint32_t subnet_id, const Pkt& query) {
+    // server identifier is the address of the socket the query came in by
+    uint32_t local_addr = query.getLocalAddr().toV4().to_ulong();
+    std::string inform_key(reinterpret_cast<const char*>(&config_version), sizeof(config_version));
+    inform_key.append(reinterpret_cast<const char*>(&subnet_id), sizeof(subnet_id));
+    inform_key.append(reinterpret_cast<const char*>(&local_addr), sizeof(local_addr));
+    inform_key.append(query.getIface());
+    inform_key.push_back(0);
+
+    const OptionUint8Array* option_prl = dynamic_cast<const OptionUint8Array*>
+        (query.getOption(DHO_DHCP_PARAMETER_REQUEST_LIST));
+    if (option_prl != nullptr) {
+        const std::vector<uint8_t>& prl = option_prl->getValues();
+        inform_key.push_back(static_cast<char>(prl.size()));
+        inform_key.append(prl.begin(), prl.end());
+    } else {
+        inform_key.push_back(0);
+    }
+    inform_key.append(query.getClasses().toText(","));
+    return inform_key;
+}
+
+InformCache::Shard&
+InformCache::getShard(const std::string& inform_key) {
+    return *shards_[std::hash<std::string>()(inform_key) % SHARD_COUNT];
+}
+
+void
+InformCache::put(const std::string& inform_key, Pkt& rsp) {
+    const kea::util::OutputBuffer& buffer = rsp.getBuffer();
+    const uint8_t* data = static_cast<const uint8_t*>(buffer.getData());
+    size_t len = buffer.getLength();
+    if (len < OPTIONS_OFFSET) {
+        return;
+    }
+
+    std::vector<uint8_t> section;
+    section.reserve(len - OPTIONS_OFFSET);
+    size_t offset = OPTIONS_OFFSET;
+    while (offset < len) {
+        uint8_t code = data[offset];
+        if (code == DHO_END) {
+            break;
+        }
+        if (code == DHO_PAD) {
+            offset++;
+            continue;
+        }
+        if (offset + 2 > len || offset + 2 + data[offset + 1] > len) {
+            return;
+        }
+
+        size_t option_len = 2 + data[offset + 1];
+        if (!isPerClientOption(code)) {
+            section.insert(section.end(), data + offset, data + offset + option_len);
+        }
+        offset += option_len;
+    }
+
+    Shard& shard = getShard(inform_key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    shard.sections_.put(inform_key, section);
+}
+
+bool
+InformCache::get(const std::string& inform_key, std::vector<uint8_t>& options) {
+    Shard& shard = getShard(inform_key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    std::vector<uint8_t>* section = nullptr;
+    if (!shard.sections_.find(inform_key, &section)) {
+        return false;
+    }
+
+    options.assign(section->begin(), section->end());
+    return true;
+}
+
+void
+InformCache::clear() {
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        std::lock_guard<std::mutex> lock(shards_[i]->mutex_);
+        shards_[i]->sections_.clear();
+    }
+}
+
+size_t
+InformCache::size() {
+    size_t count = 0;
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        std::lock_guard<std::mutex> lock(shards_[i]->mutex_);
+        count += shards_[i]->sections_.size();
+    }
+    return count;
+}
+
+};
+};
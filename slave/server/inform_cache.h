@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <kea/dhcp++/pkt.h>
+#include <kea/util/buffer.h>
+#include <kea/util/lru_cache.h>
+
+namespace kea {
+namespace server {
+
+using kea::dhcp::Pkt;
+
+//packed option sections of inform acks, keyed by configure version, subnet,
+//server identifier, parameter request list and client classes. options echoed from the query
+//(client identifier, subnet selection, relay agent information) and the
+//message type are left out, they are packed with each response together
+//with its header
+class InformCache {
+public:
+    explicit InformCache(size_t max_size);
+
+    // sections packed on an older configure never match again
+    static std::string getInformKey(uint64_t config_version, uint32_t subnet_id, const Pkt& query);
+
+    // store the shareable options of a packed ack
+    void put(const std::string& inform_key, Pkt& rsp);
+
+    // return false if nothing is cached for inform_key
+    bool get(const std::string& inform_key, std::vector<uint8_t>& options);
+
+    void clear();
+    size_t size();
+
+    static bool isPerClientOption(uint8_t code);
+
+private:
+    struct Shard {
+        std::mutex mutex_;
+        kea::util::LruCache<std::string, std::vector<uint8_t>> sections_;
+
+        explicit Shard(size_t max_size) : sections_(max_size) {}
+    };
+
+    static const size_t SHARD_COUNT = 16;
+
+    Shard& getShard(const std::string& inform_key);
+
+    std::unique_ptr<Shard> shards_[SHARD_COUNT];
+};
+
+};
+};
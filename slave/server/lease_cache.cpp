@@ -0,0 +1,196 @@
+#include <kea/server/lease_cache.h>
+#include <functional>
+
+namespace kea {
+namespace server {
+
+const size_t LeaseCache::SHARD_COUNT;
+
+LeaseCache::LeaseCache(size_t max_size, uint32_t max_staleness)
+    : max_shard_size_(max_size / SHARD_COUNT + 1),
+    max_staleness_(std::chrono::seconds(max_staleness)) {
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        shards_[i].reset(new Shard(max_shard_size_));
+        addr_shards_[i].reset(new AddrShard());
+    }
+}
+
+LeaseCache::Shard&
+LeaseCache::getShard(const std::string& client_key) {
+    return *shards_[std::hash<std::string>()(client_key) % SHARD_COUNT];
+}
+
+LeaseCache::AddrShard&
+LeaseCache::getAddrShard(uint32_t addr) {
+    return *addr_shards_[addr % SHARD_COUNT];
+}
+
+void
+LeaseCache::put(const std::string& client_key, uint32_t addr, uint32_t subnet_id, uint32_t valid_lifetime) {
+    if (client_key.empty()) {
+        return;
+    }
+
+    Clock::time_point now = Clock::now();
+    CachedLease lease;
+    lease.addr_ = addr;
+    lease.subnet_id_ = subnet_id;
+    lease.expire_ = now + std::chrono::seconds(valid_lifetime);
+    lease.confirmed_ = now;
+
+    std::string old_owner;
+    {
+        Shard& shard = getShard(client_key);
+        std::lock_guard<std::mutex> lock(shard.mutex_);
+        CachedLease* old_lease = nullptr;
+        if (shard.leases_.find(client_key, &old_lease)) {
+            if (old_lease->addr_ != addr) {
+                dropOwner(client_key, old_lease->addr_);
+            }
+        } else if (shard.leases_.size() >= max_shard_size_) {
+            auto evicted = shard.leases_.oldest();
+            dropOwner(evicted->first, evicted->second.addr_);
+        }
+        shard.leases_.put(client_key, lease);
+
+        AddrShard& addr_shard = getAddrShard(addr);
+        std::lock_guard<std::mutex> addr_lock(addr_shard.mutex_);
+        std::string& owner = addr_shard.owners_[addr];
+        if (owner != client_key) {
+            old_owner.swap(owner);
+            owner = client_key;
+        }
+    }
+
+    // master moved the address to another client
+    if (!old_owner.empty()) {
+        evictOwner(old_owner, addr);
+    }
+}
+
+bool
+LeaseCache::renew(const std::string& client_key, uint32_t addr, uint32_t subnet_id, uint32_t valid_lifetime) {
+    if (client_key.empty()) {
+        return false;
+    }
+
+    Clock::time_point now = Clock::now();
+    Shard& shard = getShard(client_key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    CachedLease* lease = nullptr;
+    if (!shard.leases_.find(client_key, &lease)) {
+        return false;
+    }
+
+    if (lease->addr_ != addr || lease->subnet_id_ != subnet_id ||
+        lease->expire_ <= now || now - lease->confirmed_ >= max_staleness_) {
+        return false;
+    }
+
+    {
+        // the address went to another client and the old lease isn't
+        // evicted yet
+        AddrShard& addr_shard = getAddrShard(addr);
+        std::lock_guard<std::mutex> addr_lock(addr_shard.mutex_);
+        auto owner = addr_shard.owners_.find(addr);
+        if (owner == addr_shard.owners_.end() || owner->second != client_key) {
+            shard.leases_.erase(client_key);
+            return false;
+        }
+    }
+
+    lease->expire_ = now + std::chrono::seconds(valid_lifetime);
+    return true;
+}
+
+void
+LeaseCache::erase(const std::string& client_key) {
+    if (client_key.empty()) {
+        return;
+    }
+
+    Shard& shard = getShard(client_key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    CachedLease* lease = nullptr;
+    if (shard.leases_.find(client_key, &lease)) {
+        dropOwner(client_key, lease->addr_);
+        shard.leases_.erase(client_key);
+    }
+}
+
+size_t
+LeaseCache::eraseAddr(uint32_t addr) {
+    std::string owner;
+    {
+        AddrShard& addr_shard = getAddrShard(addr);
+        std::lock_guard<std::mutex> addr_lock(addr_shard.mutex_);
+        auto iter = addr_shard.owners_.find(addr);
+        if (iter == addr_shard.owners_.end()) {
+            return 0;
+        }
+        owner = iter->second;
+    }
+
+    Shard& shard = getShard(owner);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    CachedLease* lease = nullptr;
+    if (!shard.leases_.find(owner, &lease) || lease->addr_ != addr) {
+        return 0;
+    }
+    dropOwner(owner, addr);
+    shard.leases_.erase(owner);
+    return 1;
+}
+
+void
+LeaseCache::clear() {
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        std::lock_guard<std::mutex> lock(shards_[i]->mutex_);
+        shards_[i]->leases_.clear();
+    }
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        std::lock_guard<std::mutex> lock(addr_shards_[i]->mutex_);
+        addr_shards_[i]->owners_.clear();
+    }
+}
+
+size_t
+LeaseCache::size() {
+    size_t count = 0;
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        std::lock_guard<std::mutex> lock(shards_[i]->mutex_);
+        count += shards_[i]->leases_.size();
+    }
+    return count;
+}
+
+void
+LeaseCache::dropOwner(const std::string& client_key, uint32_t addr) {
+    AddrShard& addr_shard = getAddrShard(addr);
+    std::lock_guard<std::mutex> addr_lock(addr_shard.mutex_);
+    auto owner = addr_shard.owners_.find(addr);
+    if (owner != addr_shard.owners_.end() && owner->second == client_key) {
+        addr_shard.owners_.erase(owner);
+    }
+}
+
+void
+LeaseCache::evictOwner(const std::string& client_key, uint32_t addr) {
+    Shard& shard = getShard(client_key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    CachedLease* lease = nullptr;
+    if (!shard.leases_.find(client_key, &lease) || lease->addr_ != addr) {
+        return;
+    }
+
+    // the client may have got the address back meanwhile
+    AddrShard& addr_shard = getAddrShard(addr);
+    std::lock_guard<std::mutex> addr_lock(addr_shard.mutex_);
+    auto owner = addr_shard.owners_.find(addr);
+    if (owner == addr_shard.owners_.end() || owner->second != client_key) {
+        shard.leases_.erase(client_key);
+    }
+}
+
+};
+};
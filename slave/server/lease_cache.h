@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <kea/util/lru_cache.h>
+
+namespace kea {
+namespace server {
+
+//leases the master granted, keyed by client key. a renewing client whose
+//address is still cached can be acked by the slave without asking master.
+//an entry is only trusted for max_staleness seconds after master confirmed
+//it, local renewals extend the lease but not the confirmation. which client
+//owns an address is kept apart, sharded by address, so a lease master moved
+//to another client is never renewed for the old one
+class LeaseCache {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    LeaseCache(size_t max_size, uint32_t max_staleness);
+
+    // record a lease master just granted
+    void put(const std::string& client_key, uint32_t addr, uint32_t subnet_id, uint32_t valid_lifetime);
+
+    // return true and extend the lease if client may keep addr in subnet
+    // without asking master
+    bool renew(const std::string& client_key, uint32_t addr, uint32_t subnet_id, uint32_t valid_lifetime);
+
+    void erase(const std::string& client_key);
+    // return the count of erased leases
+    size_t eraseAddr(uint32_t addr);
+    void clear();
+    size_t size();
+
+private:
+    struct CachedLease {
+        uint32_t addr_;
+        uint32_t subnet_id_;
+        Clock::time_point expire_;
+        Clock::time_point confirmed_;
+    };
+
+    // a shard lock is always taken before an address shard lock, never
+    // the other way around
+    struct Shard {
+        std::mutex mutex_;
+        kea::util::LruCache<std::string, CachedLease> leases_;
+
+        explicit Shard(size_t max_size) : leases_(max_size) {}
+    };
+
+    struct AddrShard {
+        std::mutex mutex_;
+        std::unordered_map<uint32_t, std::string> owners_;
+    };
+
+    static const size_t SHARD_COUNT = 16;
+
+    Shard& getShard(const std::string& client_key);
+    AddrShard& getAddrShard(uint32_t addr);
+    // forget client owns addr unless another client took it over
+    void dropOwner(const std::string& client_key, uint32_t addr);
+    // erase the lease of a client master moved addr away from
+    void evictOwner(const std::string& client_key, uint32_t addr);
+
+    size_t max_shard_size_;
+    Clock::duration max_staleness_;
+    std::unique_ptr<Shard> shards_[SHARD_COUNT];
+    std::unique_ptr<AddrShard> addr_shards_[SHARD_COUNT];
+};
+
+};
+};
@@ -0,0 +1,220 @@
+#include <kea/server/lease_journal.h>
+#include <kea/exceptions/exceptions.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace kea {
+namespace server {
+
+const size_t LeaseRecord::MAX_CLIENT_ID_LEN;
+const size_t LeaseRecord::MAX_MAC_LEN;
+
+namespace {
+
+const char JOURNAL_MAGIC[8] = {'K', 'E', 'A', 'L', 'J', 'N', 'L', '1'};
+const size_t HEADER_LEN = 64;
+const uint32_t OP_PUT = 1;
+const uint32_t OP_DELETE = 2;
+
+};
+
+struct LeaseJournal::Header {
+    char magic_[8];
+    uint32_t slot_size_;
+    uint32_t capacity_;
+};
+
+struct LeaseJournal::Slot {
+    uint32_t checksum_;
+    uint32_t op_;
+    uint64_t seq_;
+    LeaseRecord record_;
+};
+
+LeaseJournal::LeaseJournal(const std::string& path, size_t capacity, bool sync)
+    : path_(path), sync_(sync), fd_(-1), map_(nullptr), map_len_(0),
+    capacity_(0), next_slot_(0), next_seq_(1) {
+    open(path, capacity);
+}
+
+LeaseJournal::~LeaseJournal() {
+    close();
+}
+
+void
+LeaseJournal::open(const std::string& path, size_t capacity) {
+    if (capacity == 0) {
+        kea_throw(BadValue, "lease journal " << path << " should hold at least one record");
+    }
+
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd_ < 0) {
+        kea_throw(Unexpected, "open lease journal " << path << " failed: " << strerror(errno));
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        close();
+        kea_throw(Unexpected, "stat lease journal " << path << " failed: " << strerror(errno));
+    }
+
+    bool created = st.st_size == 0;
+    if (created) {
+        map_len_ = HEADER_LEN + capacity * sizeof(Slot);
+        if (ftruncate(fd_, map_len_) != 0) {
+            close();
+            kea_throw(Unexpected, "resize lease journal " << path << " failed: " << strerror(errno));
+        }
+    } else {
+        map_len_ = st.st_size;
+    }
+
+    void* map = mmap(nullptr, map_len_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (map == MAP_FAILED) {
+        close();
+        kea_throw(Unexpected, "map lease journal " << path << " failed: " << strerror(errno));
+    }
+    map_ = static_cast<uint8_t*>(map);
+
+    Header* header = reinterpret_cast<Header*>(map_);
+    if (created) {
+        memcpy(header->magic_, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+        header->slot_size_ = sizeof(Slot);
+        header->capacity_ = capacity;
+        msync(map_, HEADER_LEN, MS_SYNC);
+    } else if (map_len_ < HEADER_LEN ||
+               memcmp(header->magic_, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) != 0 ||
+               header->slot_size_ != sizeof(Slot) ||
+               HEADER_LEN + header->capacity_ * sizeof(Slot) > map_len_) {
+        close();
+        kea_throw(BadValue, "lease journal " << path << " is broken or of another version");
+    }
+    capacity_ = header->capacity_;
+
+    Slot* slots = reinterpret_cast<Slot*>(map_ + HEADER_LEN);
+    next_slot_ = 0;
+    while (next_slot_ < capacity_) {
+        const Slot& slot = slots[next_slot_];
+        if ((slot.op_ != OP_PUT && slot.op_ != OP_DELETE) ||
+            slot.seq_ != next_slot_ + 1 || slot.checksum_ != checksum(slot)) {
+            break;
+        }
+        next_slot_++;
+    }
+    next_seq_ = next_slot_ + 1;
+}
+
+void
+LeaseJournal::close() {
+    if (map_ != nullptr) {
+        msync(map_, map_len_, MS_SYNC);
+        munmap(map_, map_len_);
+        map_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+size_t
+LeaseJournal::replay(ReplayHandler handler) {
+    const Slot* slots = reinterpret_cast<const Slot*>(map_ + HEADER_LEN);
+    for (size_t i = 0; i < next_slot_; i++) {
+        handler(slots[i].op_ == OP_PUT, slots[i].record_);
+    }
+    return next_slot_;
+}
+
+bool
+LeaseJournal::appendPut(const LeaseRecord& record) {
+    return append(OP_PUT, record);
+}
+
+bool
+LeaseJournal::appendDelete(const LeaseRecord& record) {
+    return append(OP_DELETE, record);
+}
+
+bool
+LeaseJournal::append(uint32_t op, const LeaseRecord& record) {
+    if (next_slot_ >= capacity_) {
+        return false;
+    }
+
+    Slot* slot = reinterpret_cast<Slot*>(map_ + HEADER_LEN) + next_slot_;
+    writeSlot(*slot, op, next_seq_, record);
+    if (sync_) {
+        uintptr_t page_size = sysconf(_SC_PAGESIZE);
+        uintptr_t begin = reinterpret_cast<uintptr_t>(slot) & ~(page_size - 1);
+        uintptr_t end = reinterpret_cast<uintptr_t>(slot + 1);
+        msync(reinterpret_cast<void*>(begin), end - begin, MS_SYNC);
+    }
+    next_slot_++;
+    next_seq_++;
+    return true;
+}
+
+void
+LeaseJournal::compact(const std::vector<LeaseRecord>& leases) {
+    size_t capacity = std::max(capacity_, 2 * leases.size());
+    std::string tmp_path = path_ + ".tmp";
+    unlink(tmp_path.c_str());
+    {
+        LeaseJournal tmp(tmp_path, capacity, false);
+        for (auto& lease : leases) {
+            tmp.appendPut(lease);
+        }
+        msync(tmp.map_, tmp.map_len_, MS_SYNC);
+        fsync(tmp.fd_);
+    }
+
+    // the old journal stays valid until the new one is complete on disk
+    if (rename(tmp_path.c_str(), path_.c_str()) != 0) {
+        kea_throw(Unexpected, "replace lease journal " << path_ << " failed: " << strerror(errno));
+    }
+    close();
+    open(path_, capacity);
+}
+
+void
+LeaseJournal::writeSlot(Slot& slot, uint32_t op, uint64_t seq, const LeaseRecord& record) {
+    // padding is zeroed so the checksum only depends on the fields, the
+    // constructors only set the fields and leave the zeroed bytes around
+    alignas(Slot) uint8_t buf[sizeof(Slot)] = {};
+    Slot& tmp = *new (buf) Slot;
+    tmp.op_ = op;
+    tmp.seq_ = seq;
+    tmp.record_.addr_ = record.addr_;
+    tmp.record_.subnet_id_ = record.subnet_id_;
+    tmp.record_.expire_ = record.expire_;
+    tmp.record_.state_ = record.state_;
+    tmp.record_.client_id_len_ = record.client_id_len_;
+    tmp.record_.mac_len_ = record.mac_len_;
+    memcpy(tmp.record_.client_id_, record.client_id_, record.client_id_len_);
+    memcpy(tmp.record_.mac_, record.mac_, record.mac_len_);
+    tmp.checksum_ = checksum(tmp);
+    memcpy(&slot, &tmp, sizeof(tmp));
+}
+
+uint32_t
+LeaseJournal::checksum(const Slot& slot) {
+    // fnv-1a over everything behind the checksum itself
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&slot) + sizeof(slot.checksum_);
+    size_t len = sizeof(Slot) - sizeof(slot.checksum_);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+};
+};
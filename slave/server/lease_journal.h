@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace kea {
+namespace server {
+
+// A lease as persisted by the in-process allocate engine
+struct LeaseRecord {
+    static const size_t MAX_CLIENT_ID_LEN = 255;
+    static const size_t MAX_MAC_LEN = 20;
+
+    enum State {
+        NORMAL = 0,
+        DECLINED = 1
+    };
+
+    uint32_t addr_;
+    uint32_t subnet_id_;
+    int64_t expire_;
+    uint8_t state_;
+    uint8_t client_id_len_;
+    uint8_t mac_len_;
+    uint8_t client_id_[MAX_CLIENT_ID_LEN];
+    uint8_t mac_[MAX_MAC_LEN];
+
+    LeaseRecord()
+        : addr_(0), subnet_id_(0), expire_(0), state_(NORMAL),
+          client_id_len_(0), mac_len_(0) {}
+};
+
+//append only lease log in a memory mapped file of fixed size slots. a slot
+//carries a sequence number and a checksum, replay stops at the first slot
+//which isn't the next valid one, so a record torn by a crash is dropped
+//with everything after it. a full journal is compacted into a new file
+//holding only live leases, which replaces the old one by rename
+class LeaseJournal {
+public:
+    typedef std::function<void(bool put, const LeaseRecord& record)> ReplayHandler;
+
+    // sync forces every record to disk before append returns
+    LeaseJournal(const std::string& path, size_t capacity, bool sync);
+    ~LeaseJournal();
+
+    LeaseJournal(const LeaseJournal&) = delete;
+    LeaseJournal& operator=(const LeaseJournal&) = delete;
+
+    // call handler for every valid record in order, return the count
+    size_t replay(ReplayHandler handler);
+
+    // return false if journal is full, compact and append again
+    bool appendPut(const LeaseRecord& record);
+    bool appendDelete(const LeaseRecord& record);
+
+    // rewrite journal with leases, capacity grows to keep half of it free
+    void compact(const std::vector<LeaseRecord>& leases);
+
+    size_t size() const { return next_slot_; }
+    size_t capacity() const { return capacity_; }
+
+private:
+    struct Header;
+    struct Slot;
+
+    bool append(uint32_t op, const LeaseRecord& record);
+    void open(const std::string& path, size_t capacity);
+    void close();
+    static void writeSlot(Slot& slot, uint32_t op, uint64_t seq, const LeaseRecord& record);
+    static uint32_t checksum(const Slot& slot);
+
+    std::string path_;
+    bool sync_;
+    int fd_;
+    uint8_t* map_;
+    size_t map_len_;
+    size_t capacity_;
+    size_t next_slot_;
+    uint64_t next_seq_;
+};
+
+};
+};
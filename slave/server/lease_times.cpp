@@ -0,0 +1,47 @@
+#include <kea/server/lease_times.h>
+#include <algorithm>
+
+namespace kea {
+namespace server {
+
+LeaseTimes
+jitterLeaseTimes(uint32_t valid, uint32_t min_valid, const Subnet::LeaseJitter& jitter,
+                 uint64_t client_hash, uint64_t random) {
+    LeaseTimes times;
+    times.valid_ = valid;
+    if (jitter.lifetime_jitter_ != 0 && valid > min_valid) {
+        uint64_t cut = std::min<uint64_t>(static_cast<uint64_t>(valid) * jitter.lifetime_jitter_ / 100,
+                                          valid - min_valid);
+        times.valid_ = valid - static_cast<uint32_t>(random % (cut + 1));
+        random /= (cut + 1);
+    }
+
+    times.t1_ = times.valid_ / 2;
+    times.t2_ = static_cast<uint32_t>(static_cast<uint64_t>(times.valid_) * 3 / 4);
+
+    int64_t offset = 0;
+    // the farthest the settings move T1 either way
+    int64_t reach = 0;
+    if (jitter.smoothing_window_ != 0) {
+        offset += static_cast<int64_t>(client_hash % jitter.smoothing_window_) - jitter.smoothing_window_ / 2;
+        reach += jitter.smoothing_window_ / 2;
+    }
+    if (jitter.renew_jitter_ != 0) {
+        int64_t span = static_cast<int64_t>(times.t1_) * jitter.renew_jitter_ / 100;
+        offset += static_cast<int64_t>(random % (2 * span + 1)) - span;
+        reach += span;
+    }
+
+    // scaled rather than cut, so clients past the limit don't all pile up
+    // on it
+    int64_t max_offset = times.valid_ / 8;
+    if (reach > max_offset) {
+        offset = offset * max_offset / reach;
+    }
+    times.t1_ = static_cast<uint32_t>(times.t1_ + offset);
+    times.t2_ = static_cast<uint32_t>(times.t2_ + offset);
+    return times;
+}
+
+};
+};
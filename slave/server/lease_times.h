@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <kea/dhcp++/subnet.h>
+
+namespace kea {
+namespace server {
+
+using kea::dhcp::Subnet;
+
+struct LeaseTimes {
+    uint32_t valid_;
+    uint32_t t1_;
+    uint32_t t2_;
+};
+
+// T1 and T2 are valid/2 and valid*3/4 moved by the same offset: the
+// client's place in the smoothing window plus a random part of the renew
+// jitter. settings reaching further than valid/8 are scaled down to it, so
+// T1 < T2 < valid holds whatever the configuration. valid is only ever shortened, never below
+// min_valid, so master's record of the lease outlives the client's view
+LeaseTimes jitterLeaseTimes(uint32_t valid, uint32_t min_valid, const Subnet::LeaseJitter& jitter,
+                            uint64_t client_hash, uint64_t random);
+
+};
+};
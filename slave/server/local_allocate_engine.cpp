@@ -0,0 +1,550 @@
+#include <kea/server/local_allocate_engine.h>
+#include <kea/logging/logging.h>
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <arpa/inet.h>
+
+using namespace kea::logging;
+using namespace kea::rpc;
+
+namespace kea {
+namespace server {
+
+namespace {
+
+std::string
+toKey(const uint8_t* data, size_t len) {
+    return std::string(reinterpret_cast<const char*>(data), len);
+}
+
+bool
+isOwner(const LeaseRecord& lease, const RequestFields& fields) {
+    if (fields.client_id_len_ != 0 && lease.client_id_len_ == fields.client_id_len_ &&
+        memcmp(lease.client_id_, fields.client_id_, fields.client_id_len_) == 0) {
+        return true;
+    }
+    return fields.mac_len_ != 0 && lease.mac_len_ == fields.mac_len_ &&
+        memcmp(lease.mac_, fields.mac_, fields.mac_len_) == 0;
+}
+
+bool
+isExpired(const LeaseRecord& lease, int64_t now) {
+    return lease.expire_ <= now;
+}
+
+bool
+hostMatches(const Host& host, const RequestFields& fields) {
+    const std::vector<uint8_t>& identifier = host.getIdentifier();
+    switch (host.getIdentifierType()) {
+        case Host::IDENT_HWADDR:
+            return identifier.size() == fields.mac_len_ &&
+                memcmp(identifier.data(), fields.mac_, fields.mac_len_) == 0;
+        case Host::IDENT_DUID:
+        case Host::IDENT_CLIENT_ID:
+            return fields.client_id_len_ != 0 && identifier.size() == fields.client_id_len_ &&
+                memcmp(identifier.data(), fields.client_id_, fields.client_id_len_) == 0;
+        default:
+            return false;
+    }
+}
+
+};
+
+LocalAllocateEngine::LocalAllocateEngine(const LocalAllocateConf& conf, const SubnetMgr& subnet_mgr,
+                                         const BaseHostDataSource& host_mgr)
+    : subnet_mgr_(subnet_mgr),
+    host_mgr_(host_mgr) {
+    journal_.reset(new LeaseJournal(conf.journal_path_, conf.journal_capacity_, conf.journal_sync_));
+    size_t count = journal_->replay([this](bool put, const LeaseRecord& record) {
+        if (put) {
+            leases_[record.addr_] = record;
+        } else {
+            leases_.erase(record.addr_);
+        }
+    });
+    logInfo("LocalEngine ", "Replay $0 records with $1 leases from $2", count, leases_.size(), conf.journal_path_);
+}
+
+void
+LocalAllocateEngine::allocateAddr(ClientContextPtr client_ctx, Continuation callback) {
+    RequestFields fields;
+    LeaseResultMsg result;
+    if (!RpcCodec::getRequestFields(*client_ctx, fields) || !handle(fields, result)) {
+        result.succeed_ = false;
+    }
+
+    client_ctx->setYourAddr(IOAddress::fromLong(result.succeed_ ? result.addr_ : 0));
+    client_ctx->setSharedSubnetID(result.succeed_ ? result.subnet_id_ : 0);
+    std::vector<IOAddress> candidates;
+    if (result.succeed_ && result.addr_count_ > 1) {
+        for (size_t i = 0; i < result.addr_count_; i++) {
+            candidates.push_back(IOAddress::fromLong(result.addrs_[i]));
+        }
+    }
+    client_ctx->setCandidates(std::move(candidates));
+
+    if (callback.isValid()) {
+        callback(std::move(client_ctx));
+    }
+}
+
+void
+LocalAllocateEngine::notify(ClientContext& client_ctx) {
+    RequestFields fields;
+    LeaseResultMsg result;
+    if (!RpcCodec::getRequestFields(client_ctx, fields)) {
+        logError("LocalEngine ", "Msg type $0 isn't a notification", client_ctx.getQueryType());
+        return;
+    }
+    handle(fields, result);
+}
+
+bool
+LocalAllocateEngine::call(const RequestFields& fields, LeaseResultMsg&) {
+    logWarning("LocalEngine ", "Request type $0 needs a kea master", static_cast<int>(fields.request_type_));
+    return false;
+}
+
+void
+LocalAllocateEngine::stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    journal_.reset();
+}
+
+size_t
+LocalAllocateEngine::getLeaseCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return leases_.size();
+}
+
+bool
+LocalAllocateEngine::handle(const RequestFields& fields, LeaseResultMsg& result) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (journal_ == nullptr) {
+        return false;
+    }
+
+    SubnetState* state = getSubnetState(fields.subnet_id_);
+    if (state == nullptr) {
+        logWarning("LocalEngine ", "Unknown subnet with id $0", fields.subnet_id_);
+        return false;
+    }
+
+    // addresses on the wire are in network order, the engine works in
+    // host order so pool ranges compare and count naturally
+    RequestFields request = fields;
+    request.request_addr_ = ntohl(fields.request_addr_);
+    result.subnet_id_ = fields.subnet_id_;
+    switch (request.request_type_) {
+        case RT_DISCOVER:
+            result.succeed_ = planLease(*state, request, result);
+            break;
+        case RT_REQUEST:
+        case RT_COMMIT_OFFER:
+            result.succeed_ = commitLease(*state, request, result);
+            break;
+        case RT_RAPID_COMMIT:
+            // only one address is committed, so no candidates are planned
+            // the slave could pick another one from
+            request.candidate_count_ = 0;
+            result.succeed_ = planLease(*state, request, result);
+            if (result.succeed_) {
+                request.request_addr_ = result.addr_;
+                result.succeed_ = commitLease(*state, request, result);
+            }
+            break;
+        case RT_RELEASE:
+            result.succeed_ = releaseLease(*state, request);
+            break;
+        case RT_DECLINE:
+            result.succeed_ = declineLease(*state, request);
+            break;
+        case RT_CONFLICT_IP:
+            result.succeed_ = declineConflictIP(*state, request);
+            break;
+        default:
+            result.succeed_ = false;
+    }
+
+    result.addr_ = htonl(result.addr_);
+    for (size_t i = 0; i < result.addr_count_; i++) {
+        result.addrs_[i] = htonl(result.addrs_[i]);
+    }
+    return result.succeed_;
+}
+
+LocalAllocateEngine::SubnetState*
+LocalAllocateEngine::getSubnetState(uint32_t subnet_id) {
+    auto it = subnets_.find(subnet_id);
+    if (it != subnets_.end()) {
+        return it->second.get();
+    }
+
+    const Subnet* subnet = subnet_mgr_.getSubnet(subnet_id);
+    if (subnet == nullptr) {
+        return nullptr;
+    }
+
+    std::unique_ptr<SubnetState> state(new SubnetState());
+    state->subnet_ = subnet;
+    state->capacity_ = 0;
+    state->cursor_ = 0;
+    for (auto& pool : subnet->getPools()) {
+        uint32_t first = pool->getFirstAddress().toV4().to_ulong();
+        uint32_t last = pool->getLastAddress().toV4().to_ulong();
+        state->pools_.push_back(std::make_pair(first, last));
+        state->capacity_ += last - first + 1;
+    }
+    state->bitmap_.assign((state->capacity_ + 63) / 64, 0);
+
+    for (auto& lease : leases_) {
+        if (lease.second.subnet_id_ == subnet_id) {
+            setBit(*state, lease.first, true);
+            if (lease.second.client_id_len_ != 0) {
+                state->client_id_index_[toKey(lease.second.client_id_, lease.second.client_id_len_)] = lease.first;
+            }
+            if (lease.second.mac_len_ != 0) {
+                state->mac_index_[toKey(lease.second.mac_, lease.second.mac_len_)] = lease.first;
+            }
+        }
+    }
+
+    SubnetState* result = state.get();
+    subnets_[subnet_id] = std::move(state);
+    return result;
+}
+
+bool
+LocalAllocateEngine::toBit(const SubnetState& state, uint32_t addr, uint32_t& bit) const {
+    uint32_t offset = 0;
+    for (auto& pool : state.pools_) {
+        if (addr >= pool.first && addr <= pool.second) {
+            bit = offset + addr - pool.first;
+            return true;
+        }
+        offset += pool.second - pool.first + 1;
+    }
+    return false;
+}
+
+uint32_t
+LocalAllocateEngine::fromBit(const SubnetState& state, uint32_t bit) const {
+    for (auto& pool : state.pools_) {
+        uint32_t size = pool.second - pool.first + 1;
+        if (bit < size) {
+            return pool.first + bit;
+        }
+        bit -= size;
+    }
+    return 0;
+}
+
+void
+LocalAllocateEngine::setBit(SubnetState& state, uint32_t addr, bool used) {
+    uint32_t bit = 0;
+    if (!toBit(state, addr, bit)) {
+        return;
+    }
+
+    if (used) {
+        state.bitmap_[bit / 64] |= (uint64_t(1) << (bit % 64));
+    } else {
+        state.bitmap_[bit / 64] &= ~(uint64_t(1) << (bit % 64));
+    }
+}
+
+const LeaseRecord*
+LocalAllocateEngine::findOwnLease(SubnetState& state, const RequestFields& fields) {
+    std::unordered_map<std::string, uint32_t>::const_iterator it = state.client_id_index_.end();
+    if (fields.client_id_len_ != 0) {
+        it = state.client_id_index_.find(toKey(fields.client_id_, fields.client_id_len_));
+    }
+    if (it == state.client_id_index_.end() && fields.mac_len_ != 0) {
+        it = state.mac_index_.find(toKey(fields.mac_, fields.mac_len_));
+        if (it == state.mac_index_.end()) {
+            return nullptr;
+        }
+    } else if (it == state.client_id_index_.end()) {
+        return nullptr;
+    }
+
+    auto lease = leases_.find(it->second);
+    if (lease == leases_.end() || !isOwner(lease->second, fields)) {
+        return nullptr;
+    }
+    return &lease->second;
+}
+
+const Host*
+LocalAllocateEngine::findOwnHost(const SubnetState& state, const RequestFields& fields) const {
+    const Host* host = nullptr;
+    if (fields.mac_len_ != 0) {
+        host = host_mgr_.get4(state.subnet_->getID(), Host::IDENT_HWADDR, fields.mac_, fields.mac_len_);
+    }
+    if (host == nullptr && fields.client_id_len_ != 0) {
+        host = host_mgr_.get4(state.subnet_->getID(), Host::IDENT_CLIENT_ID, fields.client_id_, fields.client_id_len_);
+    }
+    if (host == nullptr && fields.client_id_len_ != 0) {
+        host = host_mgr_.get4(state.subnet_->getID(), Host::IDENT_DUID, fields.client_id_, fields.client_id_len_);
+    }
+    return host;
+}
+
+bool
+LocalAllocateEngine::isReservedForOthers(const SubnetState& state, uint32_t addr, const RequestFields& fields) const {
+    const Host* host = host_mgr_.get4(state.subnet_->getID(), IOAddress(addr));
+    return host != nullptr && !hostMatches(*host, fields);
+}
+
+bool
+LocalAllocateEngine::isAvailable(uint32_t addr, const RequestFields& fields) const {
+    auto it = leases_.find(addr);
+    if (it == leases_.end()) {
+        return true;
+    }
+
+    const LeaseRecord& lease = it->second;
+    if (isExpired(lease, std::time(nullptr))) {
+        return true;
+    }
+    return lease.state_ == LeaseRecord::NORMAL && isOwner(lease, fields);
+}
+
+bool
+LocalAllocateEngine::pickFreeAddr(SubnetState& state, const RequestFields& fields, uint32_t& cursor, uint32_t& addr) {
+    for (uint32_t i = 0; i < state.capacity_; i++) {
+        uint32_t bit = cursor;
+        cursor = (cursor + 1) % state.capacity_;
+        if ((state.bitmap_[bit / 64] & (uint64_t(1) << (bit % 64))) != 0) {
+            continue;
+        }
+
+        addr = fromBit(state, bit);
+        if (!isReservedForOthers(state, addr, fields)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t
+LocalAllocateEngine::reclaimExpired(SubnetState& state) {
+    int64_t now = std::time(nullptr);
+    std::vector<uint32_t> expired;
+    for (auto& lease : leases_) {
+        if (lease.second.subnet_id_ == state.subnet_->getID() && isExpired(lease.second, now)) {
+            expired.push_back(lease.first);
+        }
+    }
+
+    for (auto addr : expired) {
+        eraseLease(state, addr);
+    }
+    return expired.size();
+}
+
+bool
+LocalAllocateEngine::planLease(SubnetState& state, const RequestFields& fields, LeaseResultMsg& result) {
+    const LeaseRecord* own_lease = findOwnLease(state, fields);
+    const Host* host = findOwnHost(state, fields);
+    uint32_t planned = 0;
+
+    if (host != nullptr) {
+        uint32_t reserved = host->getIPv4Reservation().toV4().to_ulong();
+        if (reserved != 0 && isAvailable(reserved, fields)) {
+            planned = reserved;
+        }
+    }
+
+    if (planned == 0 && own_lease != nullptr && own_lease->state_ == LeaseRecord::NORMAL) {
+        planned = own_lease->addr_;
+    }
+
+    //user want last assigned address
+    uint32_t bit = 0;
+    if (planned == 0 && fields.request_addr_ != 0 && toBit(state, fields.request_addr_, bit) &&
+        !isReservedForOthers(state, fields.request_addr_, fields) && isAvailable(fields.request_addr_, fields)) {
+        planned = fields.request_addr_;
+    }
+
+    uint32_t cursor = state.cursor_;
+    if (planned == 0 && !pickFreeAddr(state, fields, cursor, planned)) {
+        if (reclaimExpired(state) == 0 || !pickFreeAddr(state, fields, cursor, planned)) {
+            return false;
+        }
+    }
+    state.cursor_ = cursor;
+
+    result.addr_ = planned;
+    result.addr_count_ = 0;
+    if (fields.candidate_count_ > 1) {
+        // candidates are a plan as well, none of them is marked used
+        size_t count = std::min<size_t>(fields.candidate_count_, LeaseResultMsg::MAX_ADDRS);
+        result.addrs_[result.addr_count_++] = planned;
+        uint32_t addr = 0;
+        while (result.addr_count_ < count && pickFreeAddr(state, fields, cursor, addr)) {
+            if (std::find(result.addrs_, result.addrs_ + result.addr_count_, addr) !=
+                result.addrs_ + result.addr_count_) {
+                break;
+            }
+            result.addrs_[result.addr_count_++] = addr;
+        }
+    }
+    return true;
+}
+
+bool
+LocalAllocateEngine::commitLease(SubnetState& state, const RequestFields& fields, LeaseResultMsg& result) {
+    uint32_t addr = fields.request_addr_;
+    if (addr == 0 || isReservedForOthers(state, addr, fields)) {
+        return false;
+    }
+
+    const Host* host = findOwnHost(state, fields);
+    uint32_t reserved = host != nullptr ? host->getIPv4Reservation().toV4().to_ulong() : 0;
+    if (reserved != 0 && reserved != addr && isAvailable(reserved, fields)) {
+        return false;
+    }
+
+    uint32_t bit = 0;
+    if ((addr != reserved && !toBit(state, addr, bit)) || !isAvailable(addr, fields)) {
+        return false;
+    }
+
+    const LeaseRecord* own_lease = findOwnLease(state, fields);
+    if (own_lease != nullptr && own_lease->addr_ != addr) {
+        eraseLease(state, own_lease->addr_);
+    }
+
+    LeaseRecord lease;
+    lease.addr_ = addr;
+    lease.subnet_id_ = state.subnet_->getID();
+    lease.expire_ = std::time(nullptr) + static_cast<uint32_t>(state.subnet_->getValid());
+    lease.state_ = LeaseRecord::NORMAL;
+    lease.client_id_len_ = std::min(fields.client_id_len_, LeaseRecord::MAX_CLIENT_ID_LEN);
+    memcpy(lease.client_id_, fields.client_id_, lease.client_id_len_);
+    lease.mac_len_ = std::min(fields.mac_len_, LeaseRecord::MAX_MAC_LEN);
+    memcpy(lease.mac_, fields.mac_, lease.mac_len_);
+    putLease(state, lease);
+
+    result.addr_ = addr;
+    return true;
+}
+
+bool
+LocalAllocateEngine::releaseLease(SubnetState& state, const RequestFields& fields) {
+    const LeaseRecord* own_lease = findOwnLease(state, fields);
+    if (own_lease == nullptr || own_lease->addr_ != fields.request_addr_) {
+        return false;
+    }
+
+    eraseLease(state, own_lease->addr_);
+    return true;
+}
+
+bool
+LocalAllocateEngine::declineLease(SubnetState& state, const RequestFields& fields) {
+    const LeaseRecord* own_lease = findOwnLease(state, fields);
+    if (own_lease == nullptr || own_lease->addr_ != fields.request_addr_) {
+        return false;
+    }
+
+    return declineConflictIP(state, fields);
+}
+
+bool
+LocalAllocateEngine::declineConflictIP(SubnetState& state, const RequestFields& fields) {
+    uint32_t addr = fields.request_addr_;
+    auto it = leases_.find(addr);
+    if (it != leases_.end()) {
+        unindexLease(state, it->second);
+    } else if (!state.subnet_->inRange(IOAddress(addr))) {
+        return false;
+    }
+
+    LeaseRecord lease;
+    lease.addr_ = addr;
+    lease.subnet_id_ = state.subnet_->getID();
+    lease.expire_ = std::time(nullptr) + static_cast<uint32_t>(state.subnet_->getValid());
+    lease.state_ = LeaseRecord::DECLINED;
+    putLease(state, lease);
+    return true;
+}
+
+void
+LocalAllocateEngine::putLease(SubnetState& state, const LeaseRecord& lease) {
+    auto it = leases_.find(lease.addr_);
+    if (it != leases_.end()) {
+        unindexLease(state, it->second);
+    }
+
+    leases_[lease.addr_] = lease;
+    setBit(state, lease.addr_, true);
+    if (lease.client_id_len_ != 0) {
+        state.client_id_index_[toKey(lease.client_id_, lease.client_id_len_)] = lease.addr_;
+    }
+    if (lease.mac_len_ != 0) {
+        state.mac_index_[toKey(lease.mac_, lease.mac_len_)] = lease.addr_;
+    }
+    writeJournal(true, lease);
+}
+
+void
+LocalAllocateEngine::eraseLease(SubnetState& state, uint32_t addr) {
+    auto it = leases_.find(addr);
+    if (it == leases_.end()) {
+        return;
+    }
+
+    LeaseRecord lease = it->second;
+    unindexLease(state, lease);
+    leases_.erase(it);
+    setBit(state, addr, false);
+    writeJournal(false, lease);
+}
+
+void
+LocalAllocateEngine::unindexLease(SubnetState& state, const LeaseRecord& lease) {
+    if (lease.client_id_len_ != 0) {
+        auto it = state.client_id_index_.find(toKey(lease.client_id_, lease.client_id_len_));
+        if (it != state.client_id_index_.end() && it->second == lease.addr_) {
+            state.client_id_index_.erase(it);
+        }
+    }
+    if (lease.mac_len_ != 0) {
+        auto it = state.mac_index_.find(toKey(lease.mac_, lease.mac_len_));
+        if (it != state.mac_index_.end() && it->second == lease.addr_) {
+            state.mac_index_.erase(it);
+        }
+    }
+}
+
+void
+LocalAllocateEngine::writeJournal(bool put, const LeaseRecord& lease) {
+    bool written = put ? journal_->appendPut(lease) : journal_->appendDelete(lease);
+    if (written) {
+        return;
+    }
+
+    // the change is already in leases_, so the compacted journal holds it
+    std::vector<LeaseRecord> leases;
+    leases.reserve(leases_.size());
+    for (auto& live : leases_) {
+        leases.push_back(live.second);
+    }
+    journal_->compact(leases);
+    logInfo("LocalEngine ", "Compact lease journal to $0 leases", leases.size());
+}
+
+void
+LocalAllocateEngine::init(const LocalAllocateConf& conf, const SubnetMgr& subnet_mgr,
+                          const BaseHostDataSource& host_mgr) {
+    // the journal is released by the previous engine before it's opened again
+    kea::rpc::AllocateBackend::init(nullptr);
+    kea::rpc::AllocateBackend::init(std::unique_ptr<kea::rpc::AllocateBackend>(
+                new LocalAllocateEngine(conf, subnet_mgr, host_mgr)));
+}
+
+};
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <kea/rpc/allocate_backend.h>
+#include <kea/server/subnet_mgr.h>
+#include <kea/server/base_host_data_source.h>
+#include <kea/server/lease_journal.h>
+
+namespace kea {
+namespace server {
+
+using kea::rpc::RequestFields;
+using kea::rpc::LeaseResultMsg;
+using kea::client::ClientContext;
+using kea::client::ClientContextPtr;
+using kea::client::Continuation;
+
+struct LocalAllocateConf {
+    std::string journal_path_;
+    size_t journal_capacity_;
+    bool journal_sync_;
+
+    LocalAllocateConf()
+        : journal_path_("kea_lease.journal"), journal_capacity_(65536), journal_sync_(false) {}
+};
+
+//allocate addresses in process for a slave deployed without master. it
+//follows the master engine: a client gets its reservation, then its old
+//lease, then the address it asks for, then the next free one in the pools.
+//every subnet keeps a bitmap of leased pool addresses, leases are indexed
+//by client id and mac and every change is written to a lease journal
+//before the answer goes out. shared networks are master only
+class LocalAllocateEngine : public kea::rpc::AllocateBackend {
+public:
+    LocalAllocateEngine(const LocalAllocateConf& conf, const SubnetMgr& subnet_mgr,
+                        const BaseHostDataSource& host_mgr);
+
+    virtual void allocateAddr(ClientContextPtr client_ctx, Continuation callback);
+    virtual void notify(ClientContext& client_ctx);
+    // address blocks only make sense with a master, never succeeds
+    virtual bool call(const RequestFields& fields, LeaseResultMsg& result);
+    virtual void stop();
+
+    // serve one request as master would
+    bool handle(const RequestFields& fields, LeaseResultMsg& result);
+
+    size_t getLeaseCount();
+
+    static void init(const LocalAllocateConf& conf, const SubnetMgr& subnet_mgr,
+                     const BaseHostDataSource& host_mgr);
+
+private:
+    struct SubnetState {
+        const Subnet* subnet_;
+        // pool ranges, bit i of the bitmap is the i-th pool address
+        std::vector<std::pair<uint32_t, uint32_t>> pools_;
+        std::vector<uint64_t> bitmap_;
+        uint32_t capacity_;
+        uint32_t cursor_;
+        std::unordered_map<std::string, uint32_t> client_id_index_;
+        std::unordered_map<std::string, uint32_t> mac_index_;
+    };
+
+    SubnetState* getSubnetState(uint32_t subnet_id);
+    bool toBit(const SubnetState& state, uint32_t addr, uint32_t& bit) const;
+    uint32_t fromBit(const SubnetState& state, uint32_t bit) const;
+    void setBit(SubnetState& state, uint32_t addr, bool used);
+
+    bool planLease(SubnetState& state, const RequestFields& fields, LeaseResultMsg& result);
+    bool commitLease(SubnetState& state, const RequestFields& fields, LeaseResultMsg& result);
+    bool releaseLease(SubnetState& state, const RequestFields& fields);
+    bool declineLease(SubnetState& state, const RequestFields& fields);
+    bool declineConflictIP(SubnetState& state, const RequestFields& fields);
+
+    const LeaseRecord* findOwnLease(SubnetState& state, const RequestFields& fields);
+    const Host* findOwnHost(const SubnetState& state, const RequestFields& fields) const;
+    bool isReservedForOthers(const SubnetState& state, uint32_t addr, const RequestFields& fields) const;
+    bool isAvailable(uint32_t addr, const RequestFields& fields) const;
+    bool pickFreeAddr(SubnetState& state, const RequestFields& fields, uint32_t& cursor, uint32_t& addr);
+    size_t reclaimExpired(SubnetState& state);
+
+    void putLease(SubnetState& state, const LeaseRecord& lease);
+    void eraseLease(SubnetState& state, uint32_t addr);
+    void unindexLease(SubnetState& state, const LeaseRecord& lease);
+    void writeJournal(bool put, const LeaseRecord& lease);
+
+    const SubnetMgr& subnet_mgr_;
+    const BaseHostDataSource& host_mgr_;
+    std::mutex mutex_;
+    std::unique_ptr<LeaseJournal> journal_;
+    std::unordered_map<uint32_t, LeaseRecord> leases_;
+    std::unordered_map<uint32_t, std::unique_ptr<SubnetState>> subnets_;
+};
+
+};
+};
@@ -0,0 +1,87 @@
+#include <kea/server/offer_cache.h>
+#include <functional>
+
+namespace kea {
+namespace server {
+
+const size_t OfferCache::SHARD_COUNT;
+
+OfferCache::OfferCache(size_t max_size, uint32_t offer_timeout)
+    : offer_timeout_(std::chrono::seconds(offer_timeout)) {
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        shards_[i].reset(new Shard(max_size / SHARD_COUNT + 1));
+    }
+}
+
+std::string
+OfferCache::getOfferKey(const std::string& client_key, uint32_t xid) {
+    std::string offer_key(client_key);
+    offer_key.append(reinterpret_cast<const char*>(&xid), sizeof(xid));
+    return offer_key;
+}
+
+OfferCache::Shard&
+OfferCache::getShard(const std::string& offer_key) {
+    return *shards_[std::hash<std::string>()(offer_key) % SHARD_COUNT];
+}
+
+void
+OfferCache::put(const std::string& client_key, uint32_t xid, const OfferedLease& offer) {
+    if (client_key.empty()) {
+        return;
+    }
+
+    CachedOffer cached_offer;
+    cached_offer.offer_ = offer;
+    cached_offer.expire_ = Clock::now() + offer_timeout_;
+
+    std::string offer_key = getOfferKey(client_key, xid);
+    Shard& shard = getShard(offer_key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    shard.offers_.put(offer_key, cached_offer);
+}
+
+bool
+OfferCache::take(const std::string& client_key, uint32_t xid, uint32_t addr, OfferedLease& offer) {
+    if (client_key.empty()) {
+        return false;
+    }
+
+    std::string offer_key = getOfferKey(client_key, xid);
+    Shard& shard = getShard(offer_key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    CachedOffer* cached_offer = nullptr;
+    if (!shard.offers_.find(offer_key, &cached_offer)) {
+        return false;
+    }
+
+    // the client picked another server's offer or waited too long, either
+    // way the entry is of no use any more
+    bool valid = cached_offer->offer_.addr_ == addr && cached_offer->expire_ > Clock::now();
+    if (valid) {
+        offer = cached_offer->offer_;
+    }
+    shard.offers_.erase(offer_key);
+    return valid;
+}
+
+void
+OfferCache::clear() {
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        std::lock_guard<std::mutex> lock(shards_[i]->mutex_);
+        shards_[i]->offers_.clear();
+    }
+}
+
+size_t
+OfferCache::size() {
+    size_t count = 0;
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        std::lock_guard<std::mutex> lock(shards_[i]->mutex_);
+        count += shards_[i]->offers_.size();
+    }
+    return count;
+}
+
+};
+};
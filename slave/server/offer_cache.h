@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <kea/util/lru_cache.h>
+
+namespace kea {
+namespace server {
+
+struct OfferedLease {
+    uint32_t addr_;
+    uint32_t subnet_id_;
+    uint32_t shared_subnet_id_;
+    // subnets may have changed since another configure version
+    uint64_t config_version_;
+};
+
+//offers sent recently, keyed by client key and transaction id. the request
+//of a selecting client carries the same xid and asks for the offered
+//address, so it can reuse the subnet the discover selected and let master
+//commit the offer instead of allocating again. an offer is used at most once
+class OfferCache {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    OfferCache(size_t max_size, uint32_t offer_timeout);
+
+    void put(const std::string& client_key, uint32_t xid, const OfferedLease& offer);
+
+    // return true and remove the offer if client got addr offered in
+    // transaction xid and the offer hasn't timed out
+    bool take(const std::string& client_key, uint32_t xid, uint32_t addr, OfferedLease& offer);
+
+    void clear();
+    size_t size();
+
+private:
+    struct CachedOffer {
+        OfferedLease offer_;
+        Clock::time_point expire_;
+    };
+
+    struct Shard {
+        std::mutex mutex_;
+        kea::util::LruCache<std::string, CachedOffer> offers_;
+
+        explicit Shard(size_t max_size) : offers_(max_size) {}
+    };
+
+    static const size_t SHARD_COUNT = 16;
+
+    static std::string getOfferKey(const std::string& client_key, uint32_t xid);
+    Shard& getShard(const std::string& offer_key);
+
+    Clock::duration offer_timeout_;
+    std::unique_ptr<Shard> shards_[SHARD_COUNT];
+};
+
+};
+};
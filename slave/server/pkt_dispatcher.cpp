@@ -0,0 +1,55 @@
+#include <kea/server/pkt_dispatcher.h>
+#include <algorithm>
+
+namespace kea {
+namespace server {
+
+PktDispatcher::PktDispatcher(std::vector<AdmissionQueue*> queues)
+    : queues_(std::move(queues)) {
+    active_count_.store(queues_.size());
+}
+
+void
+PktDispatcher::setActiveCount(size_t count) {
+    active_count_.store(std::max<size_t>(1, std::min(count, queues_.size())));
+}
+
+// jump consistent hash of Lamping and Veach: going from n to n + 1 buckets
+// only moves the keys which land in the new one, the rest stay where they
+// were
+static size_t
+jumpHash(uint64_t key, size_t bucket_count) {
+    int64_t bucket = -1;
+    int64_t next = 0;
+    while (next < static_cast<int64_t>(bucket_count)) {
+        bucket = next;
+        key = key * 2862933555777941757ULL + 1;
+        next = static_cast<int64_t>((bucket + 1) * (static_cast<double>(1LL << 31) /
+                    static_cast<double>((key >> 33) + 1)));
+    }
+    return static_cast<size_t>(bucket);
+}
+
+size_t
+PktDispatcher::getWorker(const PktHeader& header) const {
+    // low bits of fnv hash depend on few input bits, fold the high ones in
+    uint32_t hash = getClientHash(header);
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3b;
+    hash ^= hash >> 16;
+    return jumpHash(hash, active_count_.load(std::memory_order_relaxed));
+}
+
+bool
+PktDispatcher::dispatch(PktPtr pkt) {
+    PktHeader header;
+    const kea::dhcp::OptionBuffer& data = pkt->getData();
+    if (data.empty() || !peekPktHeader(&data[0], data.size(), header)) {
+        // the worker drops it when unpack fails
+        return queues_[0]->write(std::move(pkt), nullptr);
+    }
+    return queues_[getWorker(header)]->write(std::move(pkt), &header);
+}
+
+};
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <kea/server/admission_queue.h>
+
+namespace kea {
+namespace server {
+
+//runs in the receive thread and hands each query to the input queue of one
+//worker, chosen by client, so retransmissions of a client are handled in
+//order by the same worker. only the header and a scan for message type and
+//client identifier are read, the worker unpacks the rest
+//clients are spread over the first active workers only, the rest are
+//parked: they finish what is already queued for them and then sleep. a
+//change of the active count only moves the clients of the parked workers,
+//or the share the newly active ones take over, the rest keep their worker
+class PktDispatcher {
+public:
+    explicit PktDispatcher(std::vector<AdmissionQueue*> queues);
+
+    // return false if the query is shed by the queue of its worker
+    bool dispatch(PktPtr pkt);
+
+    size_t getWorker(const PktHeader& header) const;
+
+    // count is clamped to [1, worker count]
+    void setActiveCount(size_t count);
+    size_t getActiveCount() const { return active_count_.load(); }
+    size_t getWorkerCount() const { return queues_.size(); }
+
+private:
+    std::vector<AdmissionQueue*> queues_;
+    std::atomic<size_t> active_count_;
+};
+
+};
+};
@@ -0,0 +1,94 @@
+#include <kea/server/pkt_header.h>
+#include <kea/dhcp++/dhcp4.h>
+#include <cstring>
+
+namespace kea {
+namespace server {
+
+namespace {
+
+const size_t XID_OFFSET = 4;
+const size_t SECS_OFFSET = 8;
+const size_t CIADDR_OFFSET = 12;
+const size_t GIADDR_OFFSET = 24;
+const size_t CHADDR_OFFSET = 28;
+const size_t MAX_CHADDR_LEN = 16;
+const size_t COOKIE_OFFSET = 236;
+const size_t OPTIONS_OFFSET = 240;
+
+uint16_t readUint16(const uint8_t* data) {
+    return (static_cast<uint16_t>(data[0]) << 8) | data[1];
+}
+
+uint32_t fnv1a(uint32_t hash, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint32_t readUint32(const uint8_t* data) {
+    return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) |
+        (static_cast<uint32_t>(data[2]) << 8) | data[3];
+}
+
+};
+
+bool
+peekPktHeader(const uint8_t* data, size_t len, PktHeader& header) {
+    if (len < OPTIONS_OFFSET || readUint32(data + COOKIE_OFFSET) != kea::dhcp::DHCP_OPTIONS_COOKIE) {
+        return false;
+    }
+
+    header.op_ = data[0];
+    header.htype_ = data[1];
+    header.hlen_ = data[2] < MAX_CHADDR_LEN ? data[2] : MAX_CHADDR_LEN;
+    header.chaddr_ = data + CHADDR_OFFSET;
+    header.xid_ = readUint32(data + XID_OFFSET);
+    header.secs_ = readUint16(data + SECS_OFFSET);
+    memcpy(&header.ciaddr_, data + CIADDR_OFFSET, sizeof(header.ciaddr_));
+    memcpy(&header.giaddr_, data + GIADDR_OFFSET, sizeof(header.giaddr_));
+    header.msg_type_ = 0;
+    header.client_id_ = nullptr;
+    header.client_id_len_ = 0;
+
+    size_t offset = OPTIONS_OFFSET;
+    while (offset < len) {
+        uint8_t code = data[offset++];
+        if (code == kea::dhcp::DHO_PAD) {
+            continue;
+        } else if (code == kea::dhcp::DHO_END || offset == len) {
+            break;
+        }
+
+        uint8_t option_len = data[offset++];
+        if (offset + option_len > len) {
+            break;
+        }
+        if (code == kea::dhcp::DHO_DHCP_MESSAGE_TYPE && option_len == 1) {
+            header.msg_type_ = data[offset];
+        } else if (code == kea::dhcp::DHO_DHCP_CLIENT_IDENTIFIER && option_len != 0) {
+            header.client_id_ = data + offset;
+            header.client_id_len_ = option_len;
+        }
+        if (header.msg_type_ != 0 && header.client_id_ != nullptr) {
+            break;
+        }
+        offset += option_len;
+    }
+    return true;
+}
+
+uint32_t
+getClientHash(const PktHeader& header) {
+    uint32_t hash = 2166136261u;
+    if (header.client_id_ != nullptr) {
+        return fnv1a(hash, header.client_id_, header.client_id_len_);
+    }
+    hash = fnv1a(hash, &header.htype_, sizeof(header.htype_));
+    return fnv1a(hash, header.chaddr_, header.hlen_);
+}
+
+};
+};
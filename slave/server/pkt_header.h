@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace kea {
+namespace server {
+
+//fields of a received query read straight from the wire, for decisions the
+//receive thread makes before any worker unpacks the packet
+struct PktHeader {
+    uint8_t op_;
+    // zero if the query has no message type option
+    uint8_t msg_type_;
+    uint16_t secs_;
+    uint32_t xid_;
+    // in network order
+    uint32_t ciaddr_;
+    uint32_t giaddr_;
+    uint8_t htype_;
+    uint8_t hlen_;
+    // point into the peeked data, client_id_ is nullptr without option 61
+    const uint8_t* chaddr_;
+    const uint8_t* client_id_;
+    uint8_t client_id_len_;
+};
+
+// return false if data is too short or misses the magic cookie
+bool peekPktHeader(const uint8_t* data, size_t len, PktHeader& header);
+
+// fnv-1a over the client identifier, or hardware type and address if the
+// query has no client identifier, the same fields getClientKey uses
+uint32_t getClientHash(const PktHeader& header);
+
+};
+};
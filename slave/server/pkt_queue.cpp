@@ -0,0 +1,55 @@
+#include <kea/server/pkt_queue.h>
+#include <thread>
+
+namespace kea {
+namespace server {
+
+PktQueue::PktQueue(size_t capacity)
+    : ring_(capacity) {
+}
+
+void
+PktQueue::blockingWrite(PktPtr pkt) {
+    while (!ring_.write(std::move(pkt))) {
+        std::this_thread::yield();
+    }
+    high_water_.update(ring_.size());
+    notifier_.notify();
+}
+
+void
+PktQueue::blockingWriteBatch(PktPtr* pkts, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        while (!ring_.write(std::move(pkts[i]))) {
+            // the send thread may have gone to sleep before the batch
+            // started, it has to empty the ring for the rest to fit
+            notifier_.notify();
+            std::this_thread::yield();
+        }
+    }
+    high_water_.update(ring_.size());
+    notifier_.notify();
+}
+
+size_t
+PktQueue::blockingReadBatch(PktPtr* pkts, size_t max_count) {
+    while (true) {
+        size_t count = ring_.readBatch(pkts, max_count);
+        if (count != 0) {
+            return count;
+        }
+        notifier_.wait([this]() { return !ring_.isEmpty(); });
+    }
+}
+
+bool
+PktQueue::read(PktPtr& pkt) {
+    return ring_.read(pkt);
+}
+
+};
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <kea/dhcp++/pkt.h>
+#include <kea/util/mpsc_ring.h>
+#include <kea/util/event_notifier.h>
+#include <kea/util/queue_stats.h>
+
+namespace kea {
+namespace server {
+
+using kea::dhcp::PktPtr;
+
+//responses of every worker to the send thread. nullptr stops the send
+//thread
+class PktQueue {
+public:
+    explicit PktQueue(size_t capacity);
+
+    // yields while the ring is full
+    void blockingWrite(PktPtr pkt);
+    // the send thread is woken once for all of them, or whenever the ring
+    // fills up on the way
+    void blockingWriteBatch(PktPtr* pkts, size_t count);
+    // send thread only, waits until something is queued and takes up to
+    // max_count packets
+    size_t blockingReadBatch(PktPtr* pkts, size_t max_count);
+    bool read(PktPtr& pkt);
+
+    size_t size() const { return ring_.size(); }
+    size_t getHighWater() const { return high_water_.get(); }
+
+private:
+    kea::util::MpscRing<PktPtr> ring_;
+    kea::util::EventNotifier notifier_;
+    kea::util::HighWaterMark high_water_;
+};
+
+};
+};
@@ -0,0 +1,110 @@
+#include <kea/server/response_cache.h>
+#include <functional>
+
+namespace kea {
+namespace server {
+
+const size_t ResponseCache::SHARD_COUNT;
+
+ResponseCache::ResponseCache(size_t max_size, uint32_t window)
+    : window_(std::chrono::seconds(window)) {
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        shards_[i].reset(new Shard(max_size / SHARD_COUNT + 1));
+    }
+}
+
+std::string
+ResponseCache::getResponseKey(const std::string& client_key, uint32_t xid, uint8_t query_type,
+        uint64_t config_version) {
+    if (client_key.empty()) {
+        return client_key;
+    }
+
+    std::string response_key(client_key);
+    response_key.append(reinterpret_cast<const char*>(&xid), sizeof(xid));
+    response_key.push_back(static_cast<char>(query_type));
+    response_key.append(reinterpret_cast<const char*>(&config_version), sizeof(config_version));
+    return response_key;
+}
+
+ResponseCache::Shard&
+ResponseCache::getShard(const std::string& response_key) {
+    return *shards_[std::hash<std::string>()(response_key) % SHARD_COUNT];
+}
+
+void
+ResponseCache::put(const std::string& response_key, Pkt& rsp) {
+    if (response_key.empty()) {
+        return;
+    }
+
+    const kea::util::OutputBuffer& buffer = rsp.getBuffer();
+    const uint8_t* data = static_cast<const uint8_t*>(buffer.getData());
+    CachedResponse response;
+    response.data_.assign(data, data + buffer.getLength());
+    response.type_ = rsp.getType();
+    response.transid_ = rsp.getTransid();
+    response.local_addr_ = rsp.getLocalAddr();
+    response.remote_addr_ = rsp.getRemoteAddr();
+    response.local_port_ = rsp.getLocalPort();
+    response.remote_port_ = rsp.getRemotePort();
+    response.iface_ = rsp.getIface();
+    response.ifindex_ = rsp.getIfaceIndex();
+    response.expire_ = Clock::now() + window_;
+
+    Shard& shard = getShard(response_key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    shard.responses_.put(response_key, response);
+}
+
+PktPtr
+ResponseCache::get(const std::string& response_key) {
+    if (response_key.empty()) {
+        return nullptr;
+    }
+
+    Shard& shard = getShard(response_key);
+    std::lock_guard<std::mutex> lock(shard.mutex_);
+    CachedResponse* response = nullptr;
+    if (!shard.responses_.find(response_key, &response)) {
+        return nullptr;
+    }
+
+    if (response->expire_ <= Clock::now()) {
+        shard.responses_.erase(response_key);
+        return nullptr;
+    }
+
+    // only the type option is filled, the bytes on the wire come from the
+    // stored buffer
+    PktPtr rsp(new Pkt(response->type_, response->transid_));
+    rsp->setLocalAddr(response->local_addr_);
+    rsp->setRemoteAddr(response->remote_addr_);
+    rsp->setLocalPort(response->local_port_);
+    rsp->setRemotePort(response->remote_port_);
+    rsp->setIface(response->iface_);
+    rsp->setIfaceIndex(response->ifindex_);
+    rsp->getBuffer().writeData(response->data_.data(), response->data_.size());
+    return rsp;
+}
+
+void
+ResponseCache::clear() {
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        std::lock_guard<std::mutex> lock(shards_[i]->mutex_);
+        shards_[i]->responses_.clear();
+    }
+}
+
+size_t
+ResponseCache::size() {
+    size_t count = 0;
+    for (size_t i = 0; i < SHARD_COUNT; i++) {
+        std::lock_guard<std::mutex> lock(shards_[i]->mutex_);
+        count += shards_[i]->responses_.size();
+    }
+    return count;
+}
+
+};
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <kea/dhcp++/pkt.h>
+#include <kea/util/lru_cache.h>
+
+namespace kea {
+namespace server {
+
+using kea::dhcp::Pkt;
+using kea::dhcp::PktPtr;
+
+//packed responses sent recently, keyed by client key, xid, query type and
+//the configure version they were built on.
+//a client whose answer got lost on the way retransmits the same query, it
+//is answered with the stored bytes and destination without handling the
+//query again. entries live for a short window only
+class ResponseCache {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    ResponseCache(size_t max_size, uint32_t window);
+
+    static std::string getResponseKey(const std::string& client_key, uint32_t xid, uint8_t query_type,
+            uint64_t config_version);
+
+    // rsp has to be packed already
+    void put(const std::string& response_key, Pkt& rsp);
+
+    // return a copy of the stored response ready to send, or nullptr
+    PktPtr get(const std::string& response_key);
+
+    void clear();
+    size_t size();
+
+private:
+    struct CachedResponse {
+        std::vector<uint8_t> data_;
+        uint8_t type_;
+        uint32_t transid_;
+        IOAddress local_addr_;
+        IOAddress remote_addr_;
+        uint16_t local_port_;
+        uint16_t remote_port_;
+        std::string iface_;
+        uint32_t ifindex_;
+        Clock::time_point expire_;
+
+        CachedResponse() : local_addr_(0), remote_addr_(0) {}
+    };
+
+    struct Shard {
+        std::mutex mutex_;
+        kea::util::LruCache<std::string, CachedResponse> responses_;
+
+        explicit Shard(size_t max_size) : responses_(max_size) {}
+    };
+
+    static const size_t SHARD_COUNT = 16;
+
+    Shard& getShard(const std::string& response_key);
+
+    Clock::duration window_;
+    std::unique_ptr<Shard> shards_[SHARD_COUNT];
+};
+
+};
+};
@@ -5,6 +5,10 @@
 #include <kea/dhcp++/option4_addrlst.h>
 #include <kea/dhcp++/option_int_array.h>
 #include <kea/util/ipaddress_extend.h>
+#include <kea/server/lease_times.h>
+#include <kea/client/client_key.h>
+#include <functional>
+#include <random>
 using namespace std;
 using namespace kea::nic;
 
@@ -56,6 +60,21 @@ PktPtr initResponse(const Pkt& req) {
 	return move(resp);
 }
 
+LeaseTimes getLeaseTimes(const Pkt& query, uint32_t valid_lft, const Subnet& subnet) {
+    static thread_local std::mt19937_64 random_engine((std::random_device())());
+
+    const Subnet::LeaseJitter& jitter = subnet.getLeaseJitter();
+    uint64_t client_hash = 0;
+    if (jitter.smoothing_window_ != 0) {
+        client_hash = std::hash<std::string>()(kea::client::getClientKey(query));
+    }
+    uint64_t random = 0;
+    if (jitter.renew_jitter_ != 0 || jitter.lifetime_jitter_ != 0) {
+        random = random_engine();
+    }
+    return jitterLeaseTimes(valid_lft, subnet.getValid().getMin(), jitter, client_hash, random);
+}
+
 void appendBasicOptions(const Pkt& query, Pkt& resp, const Subnet& subnet) {
 	resp.setSiaddr(subnet.getSiaddr());
 	if (query.getType() != DHCPDISCOVER) {
@@ -70,14 +89,15 @@ void appendBasicOptions(const Pkt& query, Pkt& resp, const Subnet& subnet) {
             valid_lft = subnet.getValid().get(opt_lease_time->getValue());
         }
 
-        resp.addOption(unique_ptr<Option>(new OptionUint32(DHO_DHCP_LEASE_TIME, valid_lft)));
+        LeaseTimes times = getLeaseTimes(query, valid_lft, subnet);
+        resp.addOption(unique_ptr<Option>(new OptionUint32(DHO_DHCP_LEASE_TIME, times.valid_)));
 
         if (!subnet.getT1().unspecified()) {
-            resp.addOption(unique_ptr<Option>(new OptionUint32(DHO_DHCP_RENEWAL_TIME, valid_lft/2)));
+            resp.addOption(unique_ptr<Option>(new OptionUint32(DHO_DHCP_RENEWAL_TIME, times.t1_)));
         }
 
         if (!subnet.getT2().unspecified()) {
-            resp.addOption(unique_ptr<Option>(new OptionUint32(DHO_DHCP_REBINDING_TIME, valid_lft*3/4)));
+            resp.addOption(unique_ptr<Option>(new OptionUint32(DHO_DHCP_REBINDING_TIME, times.t2_)));
         }
     }
 
@@ -167,7 +187,7 @@ void adjustRemoteAddr(const Pkt& query, Pkt& resp) {
 	}
 }
 
-void appendIfaceData(const Pkt& query, Pkt& resp) {
+void setIfaceData(const Pkt& query, Pkt& resp) {
 	adjustRemoteAddr(query, resp);
 	resp.setRemotePort(query.isRelayed() ? DHCP4_SERVER_PORT : DHCP4_CLIENT_PORT);
 	//resp.setRemotePort(query.getRemotePort());
@@ -181,6 +201,10 @@ void appendIfaceData(const Pkt& query, Pkt& resp) {
 	resp.setLocalPort(query.getLocalPort());
 	resp.setIface(query.getIface());
 	resp.setIfaceIndex(query.getIfaceIndex());
+}
+
+void appendIfaceData(const Pkt& query, Pkt& resp) {
+	setIfaceData(query, resp);
 	Option* opt_srvid = new Option4AddrLst(DHO_DHCP_SERVER_IDENTIFIER, resp.getLocalAddr());
 	resp.addOption(unique_ptr<Option>(opt_srvid));
 }
@@ -202,5 +226,21 @@ PktPtr genAckResponse(const Pkt& query, IOAddress ip_addr, const Subnet& subnet)
     return move(resp);
 }
 
+PktPtr genInformResponse(const Pkt& query, const Subnet& subnet, const std::vector<uint8_t>& options) {
+    PktPtr resp = initResponse(query);
+    resp->setSiaddr(subnet.getSiaddr());
+    resp->setCiaddr(query.getCiaddr());
+    setIfaceData(query, *resp);
+    resp->pack(options.data(), options.size());
+    return move(resp);
+}
+
+PktPtr genRapidCommitResponse(const Pkt& query, IOAddress ip_addr, const Subnet& subnet) {
+    PktPtr resp = genAckResponse(query, ip_addr, subnet);
+    resp->setType(DHCPACK);
+    resp->addOption(unique_ptr<Option>(new Option(DHO_RAPID_COMMIT)));
+    return move(resp);
+}
+
 }
 }
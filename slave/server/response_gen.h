@@ -11,5 +11,9 @@ namespace server {
 
     PktPtr genNakResponse(const Pkt& req);
     PktPtr genAckResponse(const Pkt& req, IOAddress ip_addr, const Subnet& subnet);
+    // ack to an inform whose shared options are packed already, see InformCache
+    PktPtr genInformResponse(const Pkt& req, const Subnet& subnet, const std::vector<uint8_t>& options);
+    // ack to a discover carrying rapid commit, the lease is already committed
+    PktPtr genRapidCommitResponse(const Pkt& req, IOAddress ip_addr, const Subnet& subnet);
 };
 }
@@ -17,7 +17,8 @@
 #include <kea/hooks/hooks_manager.h>
 #include <kea/hooks/callout_handle.h>
 #include <kea/ping/ping.h>
-#include <kea/rpc/rpc_allocate_engine.h>
+#include <kea/rpc/allocate_backend.h>
+#include <kea/client/client_key.h>
 #include <kea/server/response_gen.h>
 #include <kea/logging/logging.h>
 #include <kea/statistics/pkt_statistic.h>
@@ -39,6 +40,10 @@ namespace server {
 const uint32_t MAX_RETRY_COUNT = 5;
 const uint32_t DECLINE_CONFLICT_TRANS_ID = 1234;
 const std::string VENDOR_CLASS_PREFIX("VENDOR_CLASS_");
+const size_t COMPLETION_QUEUE_SIZE = 4096;
+// responses of resumed exchanges are flushed at least this often, a full
+// completion queue would outgrow the output ring
+const size_t RESUME_FLUSH_COUNT = 64;
 
 struct Dhcp4Hooks {
     int hook_index_pkt4_receive_;   
@@ -52,12 +57,23 @@ struct Dhcp4Hooks {
 
 Dhcp4Hooks Hooks;
 
-Dhcpv4Srv::Dhcpv4Srv(SubnetMgr* subnet_mgr,
-                     BaseHostDataSource* host_mgr,
+Dhcpv4Srv::Dhcpv4Srv(const ConfigHolder& config_holder,
+                     LeaseCache* lease_cache,
+                     OfferCache* offer_cache,
+                     AddrBlockMgr* addr_block_mgr,
+                     std::shared_ptr<InflightTable> inflight_table,
+                     ResponseCache* response_cache,
+                     InformCache* inform_cache,
                      PktQueue& out_queue)
-    : subnet_mgr_(subnet_mgr), 
-      host_mgr_(host_mgr),
-      out_queue_(out_queue){
+    : config_holder_(config_holder),
+      lease_cache_(lease_cache),
+      offer_cache_(offer_cache),
+      addr_block_mgr_(addr_block_mgr),
+      inflight_table_(std::move(inflight_table)),
+      response_cache_(response_cache),
+      inform_cache_(inform_cache),
+      out_queue_(out_queue),
+      completion_queue_(COMPLETION_QUEUE_SIZE, &notifier_) {
 }
 
 Subnet*
@@ -92,11 +108,17 @@ Dhcpv4Srv::selectSubnet(const Pkt& query) const {
         }
     }
 
-    return const_cast<Subnet*>(subnet_mgr_->selectSubnet(selector));
+    return const_cast<Subnet*>(subnetMgr().selectSubnet(selector));
 }
 
 void 
 Dhcpv4Srv::beforePktSent(Pkt* query, Pkt* rsp) {
+    if (response_cache_ != nullptr &&
+        (query->getType() == DHCPDISCOVER || query->getType() == DHCPREQUEST)) {
+        response_cache_->put(ResponseCache::getResponseKey(kea::client::getClientKey(*query),
+                    query->getTransid(), query->getType(), config_->version_), *rsp);
+    }
+
     if (HooksManager::instance().calloutsPresent(Hooks.hook_index_pkt4_send_)) {
         std::unique_ptr<CalloutHandle> callout_handle = HooksManager::instance().createCalloutHandle();
         callout_handle->setArgument("query4", query);
@@ -115,6 +137,46 @@ Dhcpv4Srv::stop() {
 
 void
 Dhcpv4Srv::processPacket(PktPtr query) {
+    processBatch(&query, 1);
+}
+
+void
+Dhcpv4Srv::processBatch(PktPtr* queries, size_t count) {
+    useConfig(config_holder_.acquire());
+    BatchState batch;
+    batch.recv_hooks_ = HooksManager::instance().calloutsPresent(Hooks.hook_index_pkt4_receive_);
+    batch.log_queries_ = Logger::get()->isEnabled(LogLevel::kInfo);
+    batch.discovers_ = 0;
+    batch.requests_ = 0;
+    if (batch.recv_hooks_) {
+        batch.callout_handle_ = HooksManager::instance().createCalloutHandle();
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        processQuery(std::move(queries[i]), batch);
+    }
+
+    Statistics::instance().count_recv(batch.discovers_, batch.requests_);
+    flushResponses();
+    // an idle worker doesn't hold an old snapshot back
+    config_.reset();
+}
+
+void
+Dhcpv4Srv::sendResponse(PktPtr rsp) {
+    responses_.push_back(std::move(rsp));
+}
+
+void
+Dhcpv4Srv::flushResponses() {
+    if (!responses_.empty()) {
+        out_queue_.blockingWriteBatch(&responses_[0], responses_.size());
+        responses_.clear();
+    }
+}
+
+void
+Dhcpv4Srv::processQuery(PktPtr query, BatchState& batch) {
     try{
         query->unpack();
     } catch (const std::exception& e) {
@@ -127,18 +189,32 @@ Dhcpv4Srv::processPacket(PktPtr query) {
         return; 
     }
 
-    if (HooksManager::instance().calloutsPresent(Hooks.hook_index_pkt4_receive_)) {
-        std::unique_ptr<CalloutHandle> callout_handle = HooksManager::instance().createCalloutHandle();
-        callout_handle->setArgument("query4", query.get());
-        HooksManager::instance().callCallouts(Hooks.hook_index_pkt4_receive_, *callout_handle);
-        if (callout_handle->getStatus() == CalloutHandle::NEXT_STEP_SKIP) {
+    if (batch.recv_hooks_) {
+        CalloutHandle& callout_handle = *batch.callout_handle_;
+        callout_handle.deleteAllArguments();
+        callout_handle.setStatus(CalloutHandle::NEXT_STEP_CONTINUE);
+        callout_handle.setArgument("query4", query.get());
+        HooksManager::instance().callCallouts(Hooks.hook_index_pkt4_receive_, callout_handle);
+        if (callout_handle.getStatus() == CalloutHandle::NEXT_STEP_SKIP) {
             return;
         }
     }
-    Statistics::instance().count_recv(query.get());
+    if (query->getType() == DHCPDISCOVER) {
+        batch.discovers_ += 1;
+    } else if (query->getType() == DHCPREQUEST) {
+        batch.requests_ += 1;
+    }
+
+    // only a query that got through accept and the receive callouts may
+    // be answered from the cache, a hook dropping it must still drop it
+    if (replayResponse(*query)) {
+        return;
+    }
 
     try {
-        logInfo("Dhcpv4Srv ", query->toText().c_str());
+        if (batch.log_queries_) {
+            logInfo("Dhcpv4Srv ", query->toText().c_str());
+        }
         switch (query->getType()) {
             case DHCPDISCOVER:
             case DHCPREQUEST:
@@ -165,31 +241,65 @@ Dhcpv4Srv::processPacket(PktPtr query) {
     }
 }
 
+size_t
+Dhcpv4Srv::resumeCompleted() {
+    size_t count = 0;
+    Completion completion;
+    while (completion_queue_.read(completion)) {
+        count++;
+        useConfig(std::static_pointer_cast<const ConfigSnapshot>(completion.client_ctx_->getConfig()));
+        try {
+            switch (completion.stage_) {
+                case kea::client::CS_RPC_FINISH:
+                    onRPCFinish(std::move(completion.client_ctx_));
+                    break;
+
+                case kea::client::CS_PING_FINISH:
+                    onPingFinish(std::move(completion.client_ctx_));
+                    break;
+            }
+        } catch (const std::exception& e) {
+            logError("Dhcpv4Srv ", "Resume client context get exception: $0", e.what());
+        }
+        completion.client_ctx_.reset();
+        if (count % RESUME_FLUSH_COUNT == 0) {
+            flushResponses();
+        }
+    }
+    flushResponses();
+    config_.reset();
+    return count;
+}
+
 void Dhcpv4Srv::allocateLease(ClientContextPtr client_ctx) {
-    using namespace std::placeholders;
     if (client_ctx->getRetryCount() > MAX_RETRY_COUNT) {
         return;
     }
 
+    if (offerReserved(client_ctx) || offerLocally(client_ctx)) {
+        onRPCFinish(std::move(client_ctx));
+        return;
+    }
 
-    kea::rpc::RpcAllocateEngine::instance().allocateAddr(std::move(client_ctx),
-                                   std::bind(&Dhcpv4Srv::onRPCFinish, this, _1));
+    kea::rpc::AllocateBackend::instance().allocateAddr(std::move(client_ctx),
+            Continuation(&completion_queue_, kea::client::CS_RPC_FINISH));
 }
 
 void 
 Dhcpv4Srv::onRPCFinish(ClientContextPtr client_ctx) {
-    using namespace std::placeholders;
-
     IOAddress allocated_addr = client_ctx->getYourAddr();
     if (allocated_addr.isV4Bcast() || allocated_addr.isV4Zero()) {
         logDebug("Dhcpv4Srv ", "Send NAK when onRPCFinish got ip: $0", allocated_addr.toText());
+        if (lease_cache_ != nullptr && client_ctx->getQueryType() == DHCPREQUEST) {
+            lease_cache_->erase(kea::client::getClientKey(client_ctx->getQuery()));
+        }
         denyRequest(client_ctx->getQuery());
         return;
     }
 
     if (client_ctx->getQueryType() == DHCPDISCOVER && client_ctx->getQuery().getCiaddr() != allocated_addr) {
-        Pinger::instance().ping(std::move(client_ctx),
-                                std::bind(&Dhcpv4Srv::onPingFinish, this, _1));
+        Pinger::instance().pingCandidates(std::move(client_ctx),
+                Continuation(&completion_queue_, kea::client::CS_PING_FINISH));
     } else {
         allocateSubnet(std::move(client_ctx));
     }
@@ -197,16 +307,31 @@ Dhcpv4Srv::onRPCFinish(ClientContextPtr client_ctx) {
 
 void 
 Dhcpv4Srv::onPingFinish(ClientContextPtr client_ctx) {
-    if (client_ctx->isRequestAddrConflict()) {
-        logWarning("Dhcpv4Srv ", "IP: $0 which discover allocated has being used", client_ctx->getYourAddr().toText().c_str());
-        auto decline_ip = client_ctx->getYourAddr();
-        auto subnet = subnet_mgr_->selectSubnet(decline_ip, client_ctx->getQuery().getClasses());
+    for (auto& conflict_ip : client_ctx->getConflictAddrs()) {
+        logWarning("Dhcpv4Srv ", "IP: $0 which discover allocated has being used", conflict_ip.toText().c_str());
+        auto subnet = subnetMgr().selectSubnet(conflict_ip, client_ctx->getQuery().getClasses());
         if (subnet != nullptr) {
             PktPtr decline(new Pkt(DHCPCONFLICTIP, DECLINE_CONFLICT_TRANS_ID));
-            decline->setCiaddr(decline_ip);
-            kea::rpc::RpcAllocateEngine::instance().allocateAddr(ClientContextPtr(new ClientContext(std::move(decline), *subnet)), nullptr);
+            decline->setCiaddr(conflict_ip);
+            ClientContext decline_ctx(std::move(decline), *subnet);
+            kea::rpc::AllocateBackend::instance().notify(decline_ctx);
         } else {
-            logWarning("Dhcpv4Srv ", "Not found subnet when process decline with IP $0", decline_ip.toText()); 
+            logWarning("Dhcpv4Srv ", "Not found subnet when process decline with IP $0", conflict_ip.toText()); 
+        }
+    }
+    client_ctx->clearConflictAddrs();
+
+    if (client_ctx->isRequestAddrConflict()) {
+        // somebody answers on the reserved address, master picks another
+        client_ctx->setReservedAddr(IOAddress(0));
+        if (addr_block_mgr_ != nullptr) {
+            addr_block_mgr_->abandon(kea::client::getClientKey(client_ctx->getQuery()), client_ctx->getSubnetID());
+        }
+        // retry with several candidates, so another conflict costs no more
+        // than one round trip and one ping window. a rapid commit gets the
+        // one address master commits
+        if (!client_ctx->isRapidCommit()) {
+            client_ctx->setCandidateCount(Pinger::instance().getCandidateCount());
         }
         client_ctx->addRetryCount();
         allocateLease(std::move(client_ctx));
@@ -219,7 +344,7 @@ void
 Dhcpv4Srv::allocateSubnet(ClientContextPtr client_ctx) {
     auto shared_subnet_id = client_ctx->getSharedSubnetID();
     if ( shared_subnet_id  && shared_subnet_id != client_ctx->getSubnetID()) {
-        auto subnet = subnet_mgr_->getSubnet(shared_subnet_id);
+        auto subnet = subnetMgr().getSubnet(shared_subnet_id);
         if (subnet == nullptr) {
             logWarning("Dhcpv4Srv ", "Not found shared subnet by subnet_id $0", shared_subnet_id);
             denyRequest(client_ctx->getQuery());
@@ -233,10 +358,49 @@ Dhcpv4Srv::allocateSubnet(ClientContextPtr client_ctx) {
 
 void
 Dhcpv4Srv::assignLease(ClientContextPtr client_ctx, const Subnet& subnet){
-    PktPtr resp = genAckResponse(client_ctx->getQuery(), client_ctx->getYourAddr(), subnet);
+    bool committed = client_ctx->getQueryType() == DHCPREQUEST || client_ctx->isRapidCommit();
+    if (lease_cache_ != nullptr && committed) {
+        lease_cache_->put(kea::client::getClientKey(client_ctx->getQuery()),
+                IOAddress::toLong(client_ctx->getYourAddr()), subnet.getID(), subnet.getValid());
+    }
+
+    if (offer_cache_ != nullptr && !committed) {
+        OfferedLease offer;
+        offer.addr_ = IOAddress::toLong(client_ctx->getYourAddr());
+        offer.subnet_id_ = client_ctx->getSubnetID();
+        offer.shared_subnet_id_ = subnet.getID() != offer.subnet_id_ ? subnet.getID() : 0;
+        offer.config_version_ = config_->version_;
+        offer_cache_->put(kea::client::getClientKey(client_ctx->getQuery()),
+                client_ctx->getQuery().getTransid(), offer);
+    }
+
+    PktPtr resp = client_ctx->isRapidCommit() ?
+        genRapidCommitResponse(client_ctx->getQuery(), client_ctx->getYourAddr(), subnet) :
+        genAckResponse(client_ctx->getQuery(), client_ctx->getYourAddr(), subnet);
     resp->pack();
     beforePktSent(&client_ctx->getQuery(), resp.get());
-    out_queue_.blockingWrite(std::move(resp));
+    sendResponse(std::move(resp));
+}
+
+bool
+Dhcpv4Srv::replayResponse(Pkt& query) {
+    if (response_cache_ == nullptr ||
+        (query.getType() != DHCPDISCOVER && query.getType() != DHCPREQUEST)) {
+        return false;
+    }
+
+    PktPtr rsp = response_cache_->get(ResponseCache::getResponseKey(kea::client::getClientKey(query),
+                query.getTransid(), query.getType(), config_->version_));
+    if (rsp == nullptr) {
+        return false;
+    }
+
+    if (Logger::get()->isEnabled(LogLevel::kDebug)) {
+        logDebug("Dhcpv4Srv ", "Replay response to retransmitted query $0", query.toText().c_str());
+    }
+    Statistics::instance().count_send(&query, rsp.get());
+    sendResponse(std::move(rsp));
+    return true;
 }
 
 void 
@@ -245,13 +409,195 @@ Dhcpv4Srv::processRequest(PktPtr query) {
         sanityCheck(*query, FORBIDDEN);
     }
 
+    InflightTable::Token inflight_token;
+    if (inflight_table_ != nullptr) {
+        inflight_token = inflight_table_->begin(InflightTable::getExchangeKey(
+                    kea::client::getClientKey(*query), query->getTransid(), query->getType()));
+        if (inflight_token == nullptr) {
+            logDebug("Dhcpv4Srv ", "Drop retransmitted query $0 still in flight", query->toText().c_str());
+            return;
+        }
+    }
+
+    if (query->getType() == DHCPREQUEST && requestOffered(query, inflight_token)) {
+        return;
+    }
+
     auto subnet = selectSubnet(*query);
     if (subnet == nullptr) {
         logWarning("Dhcpv4Srv ", "Not found subnet when process discover or request by query $0", query->toText().c_str());
         denyRequest(*query);
+    } else if (query->getType() == DHCPREQUEST &&
+            (renewLocally(query, *subnet) || commitLocally(query, *subnet))) {
+        return;
     } else {
-        allocateLease(ClientContextPtr(new ClientContext(std::move(query), *subnet)));
+        bool rapid_commit = query->getType() == DHCPDISCOVER && subnet->getRapidCommit() &&
+            query->getOption(DHO_RAPID_COMMIT) != nullptr;
+        const Host* host = findHost(*query, *subnet);
+        ClientContextPtr client_ctx(new ClientContext(std::move(query), *subnet));
+        if (host != nullptr) {
+            client_ctx->setReservedAddr(host->getIPv4Reservation());
+            // the reservation was offered by this slave, master only
+            // commits it unless another client holds the address
+            if (client_ctx->getQueryType() == DHCPREQUEST &&
+                client_ctx->getRequestAddr() == host->getIPv4Reservation()) {
+                client_ctx->setOfferCommit(true);
+            }
+        }
+        client_ctx->setRapidCommit(rapid_commit);
+        client_ctx->setInflightToken(std::move(inflight_token));
+        client_ctx->setConfig(config_);
+        allocateLease(std::move(client_ctx));
+    }
+}
+
+bool
+Dhcpv4Srv::requestOffered(PktPtr& query, InflightTable::Token& inflight_token) {
+    // only a selecting client asks for an address with ciaddr left empty
+    if (offer_cache_ == nullptr || !query->getCiaddr().isV4Zero()) {
+        return false;
+    }
+
+    const OptionCustom* opt_requested_address = dynamic_cast<const OptionCustom*>
+        (query->getOption(DHO_DHCP_REQUESTED_ADDRESS));
+    if (opt_requested_address == nullptr) {
+        return false;
     }
+
+    OfferedLease offer;
+    if (!offer_cache_->take(kea::client::getClientKey(*query), query->getTransid(),
+                IOAddress::toLong(opt_requested_address->readAddress()), offer) ||
+            offer.config_version_ != config_->version_) {
+        return false;
+    }
+
+    auto subnet = subnetMgr().getSubnet(offer.subnet_id_);
+    if (subnet == nullptr) {
+        return false;
+    }
+
+    if (commitLocally(query, *subnet)) {
+        return true;
+    }
+
+    ClientContextPtr client_ctx(new ClientContext(std::move(query), *subnet));
+    client_ctx->setSharedSubnetID(offer.shared_subnet_id_);
+    client_ctx->setOfferCommit(true);
+    client_ctx->setInflightToken(std::move(inflight_token));
+    client_ctx->setConfig(config_);
+    allocateLease(std::move(client_ctx));
+    return true;
+}
+
+const Host*
+Dhcpv4Srv::findHost(const Pkt& query, const Subnet& subnet) const {
+    const HostsInMem& host_mgr = *config_->host_mgr_;
+    if (host_mgr.size() == 0) {
+        return nullptr;
+    }
+
+    const std::vector<uint8_t>& mac = query.getHWAddr().hwaddr_;
+    const Host* host = nullptr;
+    if (!mac.empty()) {
+        host = host_mgr.get4(subnet.getID(), Host::IDENT_HWADDR, &mac[0], mac.size());
+    }
+    const Option* client_id = query.getOption(DHO_DHCP_CLIENT_IDENTIFIER);
+    if (host == nullptr && client_id != nullptr && !client_id->getData().empty()) {
+        const OptionBuffer& id = client_id->getData();
+        host = host_mgr.get4(subnet.getID(), Host::IDENT_DUID, &id[0], id.size());
+    }
+    return host;
+}
+
+bool
+Dhcpv4Srv::renewLocally(PktPtr& query, const Subnet& subnet) {
+    // only a renewing or rebinding client fills ciaddr and leaves requested
+    // address out
+    if (lease_cache_ == nullptr || query->getCiaddr().isV4Zero() ||
+        query->getOption(DHO_DHCP_REQUESTED_ADDRESS) != nullptr) {
+        return false;
+    }
+
+    if (!lease_cache_->renew(kea::client::getClientKey(*query), IOAddress::toLong(query->getCiaddr()),
+                subnet.getID(), subnet.getValid())) {
+        return false;
+    }
+
+    IOAddress renew_addr = query->getCiaddr();
+    ackLocally(std::move(query), renew_addr, subnet);
+    return true;
+}
+
+bool
+Dhcpv4Srv::offerReserved(ClientContextPtr& client_ctx) {
+    // the reserved address is offered without asking master and is probed
+    // like any other offer. the request commits it through master
+    if (client_ctx->getQueryType() != DHCPDISCOVER || client_ctx->isRapidCommit() ||
+        client_ctx->getReservedAddr().isV4Zero()) {
+        return false;
+    }
+
+    client_ctx->setYourAddr(client_ctx->getReservedAddr());
+    client_ctx->setCandidates(std::vector<IOAddress>());
+    return true;
+}
+
+bool
+Dhcpv4Srv::offerLocally(ClientContextPtr& client_ctx) {
+    // a client asking for its previous address or having a reservation is
+    // left to master, so is rapid commit which needs the lease committed
+    // before the ack
+    if (addr_block_mgr_ == nullptr || !client_ctx->acceptsAnyAddr()) {
+        return false;
+    }
+
+    uint32_t addr = 0;
+    if (!addr_block_mgr_->offer(kea::client::getClientKey(client_ctx->getQuery()),
+                client_ctx->getSubnetID(), addr)) {
+        return false;
+    }
+
+    client_ctx->setYourAddr(IOAddress::fromLong(addr));
+    client_ctx->setCandidates(std::vector<IOAddress>());
+    return true;
+}
+
+bool
+Dhcpv4Srv::commitLocally(PktPtr& query, const Subnet& subnet) {
+    if (addr_block_mgr_ == nullptr) {
+        return false;
+    }
+
+    const OptionCustom* opt_requested_address = dynamic_cast<const OptionCustom*>
+        (query->getOption(DHO_DHCP_REQUESTED_ADDRESS));
+    if (opt_requested_address == nullptr) {
+        return false;
+    }
+
+    IOAddress request_addr(opt_requested_address->readAddress());
+    if (!addr_block_mgr_->commit(kea::client::getClientKey(*query), subnet.getID(),
+                IOAddress::toLong(request_addr))) {
+        return false;
+    }
+
+    if (lease_cache_ != nullptr) {
+        lease_cache_->put(kea::client::getClientKey(*query), IOAddress::toLong(request_addr),
+                subnet.getID(), subnet.getValid());
+    }
+    ackLocally(std::move(query), request_addr, subnet);
+    return true;
+}
+
+void
+Dhcpv4Srv::ackLocally(PktPtr query, const IOAddress& addr, const Subnet& subnet) {
+    PktPtr resp = genAckResponse(*query, addr, subnet);
+    resp->pack();
+    beforePktSent(query.get(), resp.get());
+    sendResponse(std::move(resp));
+
+    // master still records the lease, but nobody waits for it
+    ClientContext ack_ctx(std::move(query), subnet);
+    kea::rpc::AllocateBackend::instance().notify(ack_ctx);
 }
 
 void 
@@ -259,13 +605,18 @@ Dhcpv4Srv::denyRequest(Pkt& req) {
     PktPtr resp = genNakResponse(req);
     resp->pack();
     beforePktSent(&req, resp.get());
-    out_queue_.blockingWrite(std::move(resp));
+    sendResponse(std::move(resp));
 }
 
 void Dhcpv4Srv::processRelease(PktPtr release) {
-    auto subnet = subnet_mgr_->selectSubnet(release->getCiaddr(), release->getClasses());
+    if (lease_cache_ != nullptr) {
+        lease_cache_->erase(kea::client::getClientKey(*release));
+    }
+
+    auto subnet = subnetMgr().selectSubnet(release->getCiaddr(), release->getClasses());
     if (subnet != nullptr) {
-        kea::rpc::RpcAllocateEngine::instance().allocateAddr(ClientContextPtr(new ClientContext(std::move(release), *subnet)), nullptr);
+        ClientContext release_ctx(std::move(release), *subnet);
+        kea::rpc::AllocateBackend::instance().notify(release_ctx);
     } else {
         logWarning("Dhcpv4Srv ", "Not found subnet when process release with Ciaddr $0", release->getCiaddr().toText());
     }
@@ -276,9 +627,13 @@ Dhcpv4Srv::processDecline(PktPtr decline) {
     const OptionCustom* opt_requested_address = dynamic_cast<const OptionCustom*> (decline->getOption(DHO_DHCP_REQUESTED_ADDRESS));
     if (opt_requested_address) {
         IOAddress request_ip(opt_requested_address->readAddress());
-        auto subnet = subnet_mgr_->selectSubnet(request_ip, decline->getClasses());
+        if (lease_cache_ != nullptr) {
+            lease_cache_->erase(kea::client::getClientKey(*decline));
+        }
+        auto subnet = subnetMgr().selectSubnet(request_ip, decline->getClasses());
         if (subnet != nullptr) {
-            kea::rpc::RpcAllocateEngine::instance().allocateAddr(ClientContextPtr(new ClientContext(std::move(decline), *subnet)), nullptr);
+            ClientContext decline_ctx(std::move(decline), *subnet);
+            kea::rpc::AllocateBackend::instance().notify(decline_ctx);
         } else {
             logWarning("Dhcpv4Srv ", "Not found subnet when process decline with IP $0", request_ip.toText()); 
         }
@@ -290,15 +645,28 @@ Dhcpv4Srv::processDecline(PktPtr decline) {
 void
 Dhcpv4Srv::processInform(PktPtr inform) {
     sanityCheck(*inform, FORBIDDEN);
-    auto subnet = subnet_mgr_->selectSubnet(inform->getCiaddr(), inform->getClasses());
+    auto subnet = subnetMgr().selectSubnet(inform->getCiaddr(), inform->getClasses());
     if (subnet == nullptr) {
         logWarning("Dhcpv4Srv ", "Not found subnet when process inform with Ciaddr $0", inform->getCiaddr().toText());
         denyRequest(*inform);
-    } else {
+    } else if (inform_cache_ == nullptr) {
         PktPtr resp = genAckResponse(*inform, IOAddress(0), *subnet); 
         resp->pack();
         beforePktSent(inform.get(), resp.get());
-        out_queue_.blockingWrite(std::move(resp));
+        sendResponse(std::move(resp));
+    } else {
+        std::string inform_key = InformCache::getInformKey(config_->version_, subnet->getID(), *inform);
+        std::vector<uint8_t> options;
+        PktPtr resp;
+        if (inform_cache_->get(inform_key, options)) {
+            resp = genInformResponse(*inform, *subnet, options);
+        } else {
+            resp = genAckResponse(*inform, IOAddress(0), *subnet);
+            resp->pack();
+            inform_cache_->put(inform_key, *resp);
+        }
+        beforePktSent(inform.get(), resp.get());
+        sendResponse(std::move(resp));
     }
 }
 
@@ -422,7 +790,7 @@ Dhcpv4Srv::classifyByVendor(Pkt& pkt, std::string& classes) {
 
 void 
 Dhcpv4Srv::classifyPacket(Pkt& pkt) {
-    std::vector<std::string> pkt_meet_classes = ClientClassManager::instance().getMatchedClass(pkt);
+    std::vector<std::string> pkt_meet_classes = config_->client_classes_->getMatchedClass(pkt);
     for (auto& client_class : pkt_meet_classes)  {
         pkt.addClass(client_class);
     }
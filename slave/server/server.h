@@ -6,20 +6,29 @@
 #include <kea/dhcp++/option4_client_fqdn.h>
 #include <kea/dhcp++/option_custom.h>
 #include <kea/dhcp++/subnet.h>
-#include <kea/server/subnet_mgr.h>
-#include <kea/server/base_host_data_source.h>
-#include <folly/MPMCQueue.h>
+#include <kea/server/config_snapshot.h>
+#include <kea/server/lease_cache.h>
+#include <kea/server/offer_cache.h>
+#include <kea/server/inflight_table.h>
+#include <kea/server/response_cache.h>
+#include <kea/server/inform_cache.h>
+#include <kea/server/addr_block_mgr.h>
+#include <kea/server/pkt_queue.h>
+#include <kea/hooks/callout_handle.h>
 #include <kea/util/io_address.h>
 #include <kea/client/client_context.h>
+#include <kea/client/completion_queue.h>
 
 using namespace kea::dhcp;
 
 namespace kea {
 namespace server {
 
-typedef folly::MPMCQueue<PktPtr> PktQueue;
 using kea::client::ClientContextPtr;
 using kea::client::ClientContext;
+using kea::client::CompletionQueue;
+using kea::client::Completion;
+using kea::client::Continuation;
 
 class Dhcpv4Srv {
 public:
@@ -29,21 +38,63 @@ public:
         OPTIONAL
     } RequirementLevel;
 
-    Dhcpv4Srv(SubnetMgr* subnet_mgr, BaseHostDataSource* host_mgr, PktQueue& out_queue);
+    Dhcpv4Srv(const ConfigHolder& config_holder, LeaseCache* lease_cache,
+              OfferCache* offer_cache, AddrBlockMgr* addr_block_mgr,
+              std::shared_ptr<InflightTable> inflight_table, ResponseCache* response_cache,
+              InformCache* inform_cache, PktQueue& out_queue);
 
     void stop();
     void processPacket(PktPtr query);
+    // queries taken off the input queue together. hooks and log level are
+    // looked up once, received queries are counted once and responses are
+    // handed to the send thread together at the end
+    void processBatch(PktPtr* queries, size_t count);
+    // continue contexts back from rpc and ping, returns how many were resumed
+    size_t resumeCompleted();
+    bool hasCompleted() const { return !completion_queue_.isEmpty(); }
+    // wakes the worker on completions, and on queries if its input queue
+    // is given the same notifier
+    kea::util::EventNotifier& getNotifier() { return notifier_; }
     uint16_t getPort() const { return (port_); }
     bool useBroadcast() const { return (false); }
 
 private:
+    // the snapshot queries of the batch are handled with, or the one the
+    // resumed context started on
+    void useConfig(ConfigSnapshotPtr config) { config_ = std::move(config); }
+    const SubnetMgr& subnetMgr() const { return config_->subnet_mgr_; }
+
+    // what stays the same for every query of a batch
+    struct BatchState {
+        bool recv_hooks_;
+        bool log_queries_;
+        uint32_t discovers_;
+        uint32_t requests_;
+        std::unique_ptr<kea::hooks::CalloutHandle> callout_handle_;
+    };
+
+    void processQuery(PktPtr query, BatchState& batch);
+    // responses are queued here until the batch or resumption is done
+    void sendResponse(PktPtr rsp);
+    void flushResponses();
+
     bool accept(const Pkt&) const;
     bool acceptDirectRequest(const Pkt& ) const;
     bool acceptMessageType(const Pkt& ) const;
     bool acceptServerId(const Pkt& ) const;
     static void sanityCheck(const Pkt& , RequirementLevel);
 
+    bool replayResponse(Pkt& query);
     void processRequest(PktPtr);
+    bool requestOffered(PktPtr& query, InflightTable::Token& inflight_token);
+    const Host* findHost(const Pkt& query, const Subnet& subnet) const;
+    bool renewLocally(PktPtr& query, const Subnet& subnet);
+    // reserved clients are offered their address without asking master,
+    // master arbitrates when the request commits it
+    bool offerReserved(ClientContextPtr& client_ctx);
+    bool offerLocally(ClientContextPtr& client_ctx);
+    bool commitLocally(PktPtr& query, const Subnet& subnet);
+    void ackLocally(PktPtr query, const IOAddress& addr, const Subnet& subnet);
     void processRelease(PktPtr);
     void processDecline(PktPtr);
     void processInform(PktPtr);
@@ -63,9 +114,18 @@ private:
 
     uint16_t port_;  
     bool use_bcast_;
-    SubnetMgr* subnet_mgr_;
-    BaseHostDataSource* host_mgr_;
+    const ConfigHolder& config_holder_;
+    ConfigSnapshotPtr config_;
+    LeaseCache* lease_cache_;
+    OfferCache* offer_cache_;
+    AddrBlockMgr* addr_block_mgr_;
+    std::shared_ptr<InflightTable> inflight_table_;
+    ResponseCache* response_cache_;
+    InformCache* inform_cache_;
     PktQueue& out_queue_;
+    std::vector<PktPtr> responses_;
+    kea::util::EventNotifier notifier_;
+    CompletionQueue completion_queue_;
 };
 }; 
 };
@@ -7,6 +7,9 @@ using namespace kea::nic;
 namespace kea {
 namespace server {
 
+SubnetMgr::SubnetMgr() : prefix_trie_(1) {
+}
+
 bool
 SubnetMgr::add(Subnet4Ptr subnet) {
     if (isDuplicate(*subnet)) {
@@ -14,10 +17,120 @@ SubnetMgr::add(Subnet4Ptr subnet) {
         return false;
     }else {
         subnets_.push_back(std::move(subnet));
+        index(subnets_.size() - 1);
         return true;
     }
 }
 
+bool
+SubnetMgr::update(Subnet4Ptr subnet) {
+    auto id = ids_.find(subnet->getID());
+    if (id == ids_.end()) {
+        return false;
+    }
+
+    size_t pos = id->second;
+    unindex(pos);
+    subnets_[pos] = std::move(subnet);
+    index(pos);
+    return true;
+}
+
+bool
+SubnetMgr::del(SubnetID id) {
+    auto subnet = ids_.find(id);
+    if (subnet == ids_.end()) {
+        return false;
+    }
+
+    size_t pos = subnet->second;
+    unindex(pos);
+    subnets_[pos].reset();
+    return true;
+}
+
+static void
+insertPosition(std::vector<size_t>& positions, size_t pos) {
+    positions.insert(std::lower_bound(positions.begin(), positions.end(), pos), pos);
+}
+
+static void
+erasePosition(std::vector<size_t>& positions, size_t pos) {
+    auto it = std::lower_bound(positions.begin(), positions.end(), pos);
+    if (it != positions.end() && *it == pos) {
+        positions.erase(it);
+    }
+}
+
+void
+SubnetMgr::index(size_t pos) {
+    Subnet& subnet = *subnets_[pos];
+    auto prefix = subnet.get();
+    insertPosition(prefixNode(static_cast<uint32_t>(prefix.first.toV4().to_ulong()), prefix.second), pos);
+    ids_[subnet.getID()] = pos;
+
+    IOAddress relay = subnet.getRelayInfo().addr_;
+    if (!relay.isV4Zero()) {
+        insertPosition(relays_[static_cast<uint32_t>(relay.toV4().to_ulong())], pos);
+    }
+    if (!subnet.getIface().empty()) {
+        insertPosition(ifaces_[subnet.getIface()], pos);
+    }
+}
+
+void
+SubnetMgr::unindex(size_t pos) {
+    Subnet& subnet = *subnets_[pos];
+    auto prefix = subnet.get();
+    erasePosition(prefixNode(static_cast<uint32_t>(prefix.first.toV4().to_ulong()), prefix.second), pos);
+    ids_.erase(subnet.getID());
+
+    IOAddress relay = subnet.getRelayInfo().addr_;
+    auto relay_subnets = relays_.find(static_cast<uint32_t>(relay.toV4().to_ulong()));
+    if (!relay.isV4Zero() && relay_subnets != relays_.end()) {
+        erasePosition(relay_subnets->second, pos);
+        if (relay_subnets->second.empty()) {
+            relays_.erase(relay_subnets);
+        }
+    }
+    auto iface_subnets = ifaces_.find(subnet.getIface());
+    if (iface_subnets != ifaces_.end()) {
+        erasePosition(iface_subnets->second, pos);
+        if (iface_subnets->second.empty()) {
+            ifaces_.erase(iface_subnets);
+        }
+    }
+}
+
+SubnetMgr::Positions&
+SubnetMgr::prefixNode(uint32_t prefix, uint8_t len) {
+    uint32_t node = 0;
+    for (uint8_t i = 0; i < len && i < 32; i++) {
+        uint32_t bit = (prefix >> (31 - i)) & 1;
+        if (prefix_trie_[node].children_[bit] == 0) {
+            prefix_trie_[node].children_[bit] = static_cast<uint32_t>(prefix_trie_.size());
+            prefix_trie_.push_back(PrefixNode());
+        }
+        node = prefix_trie_[node].children_[bit];
+    }
+    return prefix_trie_[node].subnets_;
+}
+
+size_t
+SubnetMgr::firstSupported(const Positions& positions, const ClientClasses& client_classes,
+        size_t before) const {
+    // positions are in configuration order
+    for (size_t pos : positions) {
+        if (pos >= before) {
+            break;
+        }
+        if (subnets_[pos]->clientSupported(client_classes)) {
+            return pos;
+        }
+    }
+    return before;
+}
+
 const Subnet*
 SubnetMgr::selectSubnet(const SubnetSelector& selector) const {
     // First use RAI link select sub-option or subnet select option
@@ -32,15 +145,12 @@ SubnetMgr::selectSubnet(const SubnetSelector& selector) const {
     // subnets, but we need to verify that for all subnets before we can try
     // to use the giaddr to match with the subnet prefix.
     if (!selector.giaddr_.isV4Zero()) {
-        for(auto& subnet : subnets_) {
-            // Check if the giaddr is equal to the one defined for the subnet.
-            if (selector.giaddr_ != subnet->getRelayInfo().addr_) {
-                continue;
-            }
-
+        auto relay = relays_.find(static_cast<uint32_t>(selector.giaddr_.toV4().to_ulong()));
+        if (relay != relays_.end()) {
             // If a subnet meets the client class criteria return it.
-            if (subnet->clientSupported(selector.client_classes_)) {
-                return (subnet.get());
+            size_t pos = firstSupported(relay->second, selector.client_classes_, subnets_.size());
+            if (pos < subnets_.size()) {
+                return (subnets_[pos].get());
             }
         }
     }
@@ -87,20 +197,14 @@ SubnetMgr::selectSubnet(const SubnetSelector& selector) const {
 
 const Subnet* 
 SubnetMgr::selectSubnet(const std::string& iface, const ClientClasses& client_classes) const {
-    for(auto& subnet : subnets_) {
-        // If there's no interface specified for this subnet, proceed to
-        // the next subnet.
-        if (subnet->getIface() != iface) {
-            continue;
-        }
-
-        // If a subnet meets the client class criteria return it.
-        if (subnet->clientSupported(client_classes)) {
-            return (subnet.get());
-        }
+    auto subnets = ifaces_.find(iface);
+    if (subnets == ifaces_.end()) {
+        return (nullptr);
     }
 
-    return (nullptr);
+    // If a subnet meets the client class criteria return it.
+    size_t pos = firstSupported(subnets->second, client_classes, subnets_.size());
+    return (pos < subnets_.size() ? subnets_[pos].get() : nullptr);
 }
 
 const Subnet*
@@ -110,35 +214,35 @@ SubnetMgr::selectSubnet(const IOAddress& address) const {
 
 const Subnet*
 SubnetMgr::selectSubnet(const IOAddress& address, const ClientClasses& client_classes) const {
-    for(auto& subnet : subnets_) {
-        if (!subnet->inRange(address)) {
-            continue;
+    // every prefix covering the address lies on the path to it, the first
+    // configured one of them that supports the client wins
+    uint32_t addr = static_cast<uint32_t>(address.toV4().to_ulong());
+    size_t found = subnets_.size();
+    uint32_t node = 0;
+    for (int i = 0; ; i++) {
+        found = firstSupported(prefix_trie_[node].subnets_, client_classes, found);
+        if (i == 32) {
+            break;
         }
-
-        if (subnet->clientSupported(client_classes)) {
-            return (subnet.get());
+        node = prefix_trie_[node].children_[(addr >> (31 - i)) & 1];
+        if (node == 0) {
+            break;
         }
     }
 
-    return (nullptr);
+    return (found < subnets_.size() ? subnets_[found].get() : nullptr);
 }
 
 bool 
 SubnetMgr::isDuplicate(const Subnet& subnet) const {
-    for(auto& subnet_ : subnets_) {
-        if (subnet_->getID() == subnet.getID()) {
-            return (true);
-        }
-    }
-    return (false);
+    return (ids_.find(subnet.getID()) != ids_.end());
 }
 
 const Subnet*
 SubnetMgr::getSubnet(SubnetID id) const {
-    for (auto& subnet_ : subnets_) {
-        if (subnet_->getID() == id) {
-            return (subnet_.get());
-        }
+    auto subnet = ids_.find(id);
+    if (subnet != ids_.end()) {
+        return (subnets_[subnet->second].get());
     }
     logWarning("SubnetMgr ", "ID of subnet $0 is no exist", id);
     return nullptr;
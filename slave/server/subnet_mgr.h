@@ -2,19 +2,30 @@
 
 #include <kea/dhcp++/subnet.h>
 #include <kea/server/subnet_selector.h>
+#include <unordered_map>
 
 namespace kea {
 namespace server {
 
 using kea::dhcp::Subnet;
 using kea::dhcp::SubnetID;
-using kea::dhcp::Subnet4Collection;
 
+//subnets are indexed as they are added. when several subnets match, the one
+//configured first that supports the client classes wins, the same as
+//scanning them in order. a copy shares the subnets and copies the indexes,
+//so a change to a few subnets is made on a copy while the original is read
 class SubnetMgr{
 public:
     typedef std::unique_ptr<Subnet> Subnet4Ptr;
 
+    SubnetMgr();
+
     bool add(Subnet4Ptr);
+    // replaces the subnet with the same id, it keeps its place in the
+    // configured order. false if there is none
+    bool update(Subnet4Ptr);
+    bool del(SubnetID id);
+    size_t size() const { return ids_.size(); }
 
     const Subnet* selectSubnet(const SubnetSelector&) const;
     const Subnet* selectSubnet(const IOAddress&) const;
@@ -22,10 +33,30 @@ public:
     const Subnet* selectSubnet(const IOAddress&, const ClientClasses&) const;
 
 private:
+    typedef std::vector<size_t> Positions;
+
+    //binary trie over the prefix bits, a node holds the subnets whose
+    //prefix ends at it
+    struct PrefixNode {
+        uint32_t children_[2];
+        Positions subnets_;
+
+        PrefixNode() : children_{0, 0} {}
+    };
+
     bool isDuplicate(const Subnet& subnet) const;
     const Subnet* selectSubnet(const std::string&, const ClientClasses&) const;
-
-    Subnet4Collection subnets_;
+    Positions& prefixNode(uint32_t prefix, uint8_t len);
+    void index(size_t pos);
+    void unindex(size_t pos);
+    size_t firstSupported(const Positions& positions, const ClientClasses&, size_t before) const;
+
+    // a deleted subnet leaves nullptr behind, so positions don't move
+    std::vector<std::shared_ptr<Subnet>> subnets_;
+    std::vector<PrefixNode> prefix_trie_;
+    std::unordered_map<SubnetID, size_t> ids_;
+    std::unordered_map<uint32_t, Positions> relays_;
+    std::unordered_map<std::string, Positions> ifaces_;
 };
 
 };
@@ -0,0 +1,223 @@
+#include <kea/server/admission_queue.h>
+#include <kea/dhcp++/dhcp4.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace kea;
+using namespace kea::dhcp;
+using namespace kea::server;
+
+namespace {
+
+PktPtr makeQuery(uint8_t type, uint32_t xid, uint16_t secs = 0, const char* relay = "0.0.0.0") {
+    Pkt query(type, xid);
+    query.setSecs(secs);
+    query.setGiaddr(IOAddress(relay));
+    query.pack();
+    PktPtr received(new Pkt(static_cast<const uint8_t*>(query.getBuffer().getData()),
+                query.getBuffer().getLength()));
+    received->updateTimestamp();
+    return received;
+}
+
+AdmissionConf makeConf(size_t capacity, size_t discover_limit) {
+    AdmissionConf conf;
+    conf.capacity_ = capacity;
+    conf.discover_limit_ = discover_limit;
+    conf.max_age_ = std::chrono::milliseconds(0);
+    conf.secs_threshold_ = 0;
+    conf.max_buckets_ = 16;
+    return conf;
+}
+
+TEST(PktHeaderTest, peek) {
+    PktPtr query = makeQuery(DHCPREQUEST, 0x12345678, 7);
+    PktHeader header;
+    ASSERT_TRUE(peekPktHeader(&query->getData()[0], query->getData().size(), header));
+    EXPECT_EQ(DHCPREQUEST, header.msg_type_);
+    EXPECT_EQ(0x12345678, header.xid_);
+    EXPECT_EQ(7, header.secs_);
+    EXPECT_EQ(0, header.giaddr_);
+    EXPECT_FALSE(peekPktHeader(&query->getData()[0], 100, header));
+}
+
+TEST(AdmissionQueueTest, requestsFirst) {
+    AdmissionQueue queue(makeConf(10, 10));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 1)));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPREQUEST, 2)));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 3)));
+
+    PktPtr pkt;
+    ASSERT_TRUE(queue.read(pkt));
+    pkt->unpack();
+    EXPECT_EQ(2, pkt->getTransid());
+    ASSERT_TRUE(queue.read(pkt));
+    pkt->unpack();
+    EXPECT_EQ(1, pkt->getTransid());
+    ASSERT_TRUE(queue.read(pkt));
+    pkt->unpack();
+    EXPECT_EQ(3, pkt->getTransid());
+    EXPECT_FALSE(queue.read(pkt));
+}
+
+TEST(AdmissionQueueTest, shed) {
+    AdmissionQueue queue(makeConf(3, 2));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 1)));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 2)));
+    // discovers can't take the room left for requests
+    EXPECT_FALSE(queue.write(makeQuery(DHCPDISCOVER, 3)));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPREQUEST, 4)));
+    // a request pushes out the oldest discover
+    EXPECT_TRUE(queue.write(makeQuery(DHCPREQUEST, 5)));
+
+    AdmissionStats stats = queue.getStats();
+    EXPECT_EQ(3, stats.depth_);
+    EXPECT_EQ(1, stats.discover_depth_);
+    EXPECT_EQ(1, stats.shed_full_);
+    EXPECT_EQ(1, stats.shed_evicted_);
+
+    PktPtr pkt;
+    ASSERT_TRUE(queue.read(pkt));
+    ASSERT_TRUE(queue.read(pkt));
+    ASSERT_TRUE(queue.read(pkt));
+    pkt->unpack();
+    EXPECT_EQ(2, pkt->getTransid());
+}
+
+TEST(AdmissionQueueTest, stale) {
+    AdmissionConf conf = makeConf(10, 10);
+    conf.max_age_ = std::chrono::milliseconds(50);
+    AdmissionQueue queue(conf);
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 1)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 2)));
+
+    PktPtr pkt;
+    ASSERT_TRUE(queue.read(pkt));
+    pkt->unpack();
+    EXPECT_EQ(2, pkt->getTransid());
+    EXPECT_EQ(1, queue.getStats().shed_stale_);
+}
+
+TEST(AdmissionQueueTest, secs) {
+    AdmissionConf conf = makeConf(2, 1);
+    conf.secs_threshold_ = 10;
+    AdmissionQueue queue(conf);
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 1)));
+    EXPECT_FALSE(queue.write(makeQuery(DHCPDISCOVER, 2, 3)));
+    // a client retrying for long is queued like a request
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 3, 12)));
+    EXPECT_EQ(1, queue.getStats().promoted_);
+
+    PktPtr pkt;
+    ASSERT_TRUE(queue.read(pkt));
+    pkt->unpack();
+    EXPECT_EQ(3, pkt->getTransid());
+}
+
+TEST(AdmissionQueueTest, stopMarker) {
+    AdmissionQueue queue(makeConf(1, 1));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPREQUEST, 1)));
+    EXPECT_TRUE(queue.write(nullptr));
+    queue.clear();
+    EXPECT_TRUE(queue.write(nullptr));
+
+    kea::util::EventNotifier notifier;
+    queue.setNotifier(&notifier);
+    PktPtr pkt = makeQuery(DHCPREQUEST, 2);
+    std::thread worker([&]() {
+        while (!queue.read(pkt)) {
+            notifier.wait([&]() { return queue.hasQueued(); });
+        }
+    });
+    worker.join();
+    EXPECT_EQ(nullptr, pkt);
+}
+
+uint32_t readXid(AdmissionQueue& queue) {
+    PktPtr pkt;
+    EXPECT_TRUE(queue.read(pkt));
+    pkt->unpack();
+    return pkt->getTransid();
+}
+
+TEST(AdmissionQueueTest, fairShare) {
+    AdmissionConf conf = makeConf(100, 100);
+    conf.weights_[BucketKey{IOAddress::toLong(IOAddress("10.0.0.2")), 0}] = 2;
+    AdmissionQueue queue(conf);
+    for (uint32_t xid = 1; xid <= 6; xid++) {
+        EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, xid, 0, "10.0.0.1")));
+    }
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 11, 0, "10.0.0.2")));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 12, 0, "10.0.0.2")));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 13, 0, "10.0.0.2")));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 21, 0, "10.0.0.3")));
+
+    // each bucket hands out its weight per round
+    std::vector<uint32_t> expected = {1, 11, 12, 21, 2, 13, 3, 4, 5, 6};
+    for (auto xid : expected) {
+        EXPECT_EQ(xid, readXid(queue));
+    }
+}
+
+TEST(AdmissionQueueTest, longestBucketPays) {
+    AdmissionQueue queue(makeConf(4, 4));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPREQUEST, 1, 0, "10.0.0.1")));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPREQUEST, 2, 0, "10.0.0.1")));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPREQUEST, 3, 0, "10.0.0.1")));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 11, 0, "10.0.0.2")));
+
+    // a discover can't push out a request, a request can
+    EXPECT_FALSE(queue.write(makeQuery(DHCPDISCOVER, 21, 0, "10.0.0.3")));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPREQUEST, 22, 0, "10.0.0.3")));
+
+    AdmissionStats stats = queue.getStats();
+    ASSERT_EQ(3, stats.buckets_.size());
+    EXPECT_EQ(IOAddress::toLong(IOAddress("10.0.0.1")), stats.buckets_[0].key_.relay_);
+    EXPECT_EQ(2, stats.buckets_[0].depth_);
+    EXPECT_EQ(1, stats.buckets_[0].dropped_);
+    EXPECT_EQ(1, stats.buckets_[1].depth_);
+    EXPECT_EQ(0, stats.buckets_[1].dropped_);
+    EXPECT_EQ(1, stats.buckets_[2].depth_);
+    EXPECT_EQ(1, stats.buckets_[2].dropped_);
+
+    std::vector<uint32_t> expected = {2, 11, 22, 3};
+    for (auto xid : expected) {
+        EXPECT_EQ(xid, readXid(queue));
+    }
+}
+
+TEST(AdmissionQueueTest, overflowBucket) {
+    AdmissionConf conf = makeConf(10, 10);
+    conf.max_buckets_ = 1;
+    AdmissionQueue queue(conf);
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 1, 0, "10.0.0.1")));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 2, 0, "10.0.0.2")));
+    EXPECT_TRUE(queue.write(makeQuery(DHCPDISCOVER, 3, 0, "10.0.0.3")));
+    EXPECT_EQ(2, queue.getStats().buckets_.size());
+}
+
+TEST(AdmissionQueueTest, readBatch) {
+    AdmissionQueue queue(makeConf(10, 10));
+    for (uint32_t xid = 1; xid <= 5; xid++) {
+        EXPECT_TRUE(queue.write(makeQuery(DHCPREQUEST, xid)));
+    }
+
+    PktPtr pkts[4];
+    ASSERT_EQ(4, queue.readBatch(pkts, 4));
+    pkts[3]->unpack();
+    EXPECT_EQ(4, pkts[3]->getTransid());
+    EXPECT_EQ(4, queue.getStats().served_);
+
+    // a stop marker ends the batch
+    EXPECT_TRUE(queue.write(nullptr));
+    ASSERT_EQ(1, queue.readBatch(pkts, 4));
+    EXPECT_EQ(nullptr, pkts[0]);
+    ASSERT_EQ(1, queue.readBatch(pkts, 4));
+    pkts[0]->unpack();
+    EXPECT_EQ(5, pkts[0]->getTransid());
+    EXPECT_EQ(0, queue.readBatch(pkts, 4));
+}
+
+};
+
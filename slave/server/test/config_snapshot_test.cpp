@@ -0,0 +1,103 @@
+#include <kea/server/config_snapshot.h>
+#include <kea/server/hosts_in_mem.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+
+using namespace kea;
+using namespace kea::server;
+using namespace kea::configure;
+
+namespace {
+
+std::unique_ptr<ConfigSnapshot> makeSnapshot(SubnetID id) {
+    std::unique_ptr<ConfigSnapshot> snapshot(new ConfigSnapshot());
+    snapshot->host_mgr_.reset(new HostsInMem());
+    snapshot->subnet_mgr_.add(SubnetMgr::Subnet4Ptr(new Subnet(IOAddress("192.0.2.0"), 24, 1, 2, 3, id)));
+    snapshot->client_classes_.reset(new ClientClassManager());
+    return snapshot;
+}
+
+TEST(ConfigSnapshotTest, publish) {
+    ConfigHolder holder;
+    EXPECT_TRUE(holder.acquire() == nullptr);
+    EXPECT_EQ(0, holder.getVersion());
+
+    holder.publish(makeSnapshot(1));
+    ConfigSnapshotPtr old_config = holder.acquire();
+    EXPECT_EQ(1, holder.getVersion());
+
+    holder.publish(makeSnapshot(2));
+    EXPECT_EQ(2, holder.getVersion());
+    EXPECT_TRUE(holder.acquire()->subnet_mgr_.getSubnet(2) != nullptr);
+
+    // a reader still holding the old snapshot keeps using it
+    EXPECT_EQ(1, old_config->version_);
+    EXPECT_TRUE(old_config->subnet_mgr_.getSubnet(1) != nullptr);
+    EXPECT_TRUE(old_config->subnet_mgr_.selectSubnet(IOAddress("192.0.2.1")) != nullptr);
+}
+
+TEST(ConfigSnapshotTest, swapWhileReading) {
+    ConfigHolder holder;
+    holder.publish(makeSnapshot(1));
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; i++) {
+        readers.push_back(std::thread([&]() {
+            uint64_t last_version = 0;
+            while (!stop.load()) {
+                ConfigSnapshotPtr config = holder.acquire();
+                // versions only move forward and always match the subnets
+                ASSERT_LE(last_version, config->version_);
+                last_version = config->version_;
+                ASSERT_TRUE(config->subnet_mgr_.getSubnet(static_cast<SubnetID>(last_version)) != nullptr);
+            }
+        }));
+    }
+
+    for (SubnetID id = 2; id < 200; id++) {
+        holder.publish(makeSnapshot(id));
+    }
+    stop.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(199, holder.getVersion());
+}
+
+TEST(ConfigSnapshotTest, copy) {
+    ConfigHolder holder;
+    holder.publish(makeSnapshot(1));
+    ConfigSnapshotPtr running = holder.acquire();
+
+    // a subnet change is published as a copy, readers of the running
+    // snapshot don't see it
+    std::unique_ptr<ConfigSnapshot> changed(new ConfigSnapshot(*running));
+    ASSERT_TRUE(changed->subnet_mgr_.add(SubnetMgr::Subnet4Ptr(new Subnet(IOAddress("198.51.100.0"), 24, 1, 2, 3, 2))));
+    ASSERT_TRUE(changed->subnet_mgr_.del(1));
+    EXPECT_EQ(running->host_mgr_, changed->host_mgr_);
+    EXPECT_EQ(running->client_classes_, changed->client_classes_);
+    holder.publish(std::move(changed));
+
+    EXPECT_TRUE(running->subnet_mgr_.getSubnet(1) != nullptr);
+    EXPECT_TRUE(running->subnet_mgr_.getSubnet(2) == nullptr);
+    EXPECT_TRUE(holder.acquire()->subnet_mgr_.getSubnet(1) == nullptr);
+    EXPECT_TRUE(holder.acquire()->subnet_mgr_.selectSubnet(IOAddress("198.51.100.1")) != nullptr);
+    EXPECT_EQ(2, holder.getVersion());
+}
+
+TEST(ConfigSnapshotTest, swappable) {
+    auto running = JsonConf::parseString(R"({"dhcp4": {"worker-count": 4, "subnet4": [{"subnet": "192.0.2.0/24"}]}})");
+    auto subnets = JsonConf::parseString(R"({"dhcp4": {"worker-count": 4, "subnet4": [], "client-classes": [{"name": "a", "test": "true"}]}})");
+    auto workers = JsonConf::parseString(R"({"dhcp4": {"worker-count": 8, "subnet4": [{"subnet": "192.0.2.0/24"}]}})");
+    auto option_def = JsonConf::parseString(R"({"dhcp4": {"worker-count": 4, "option-def": []}})");
+    auto local = JsonConf::parseString(R"({"dhcp4": {"worker-count": 4, "allocate-engine": {"type": "local"}}})");
+
+    EXPECT_TRUE(isSnapshotSwappable(*running, *running));
+    EXPECT_TRUE(isSnapshotSwappable(*running, *subnets));
+    EXPECT_FALSE(isSnapshotSwappable(*running, *workers));
+    EXPECT_FALSE(isSnapshotSwappable(*running, *option_def));
+    EXPECT_FALSE(isSnapshotSwappable(*local, *local));
+}
+
+};
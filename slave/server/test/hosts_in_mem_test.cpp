@@ -22,12 +22,12 @@ class HostsInMemTest : public ::testing::Test {
 public:
     HostsInMemTest();
 
-    IPAddress increase(const IPAddress& address, const uint8_t num) const;
+    IOAddress increase(const IOAddress& address, const uint8_t num) const;
 
     std::vector<HWAddrPtr> hwaddrs_;
     std::vector<DuidPtr> duids_;
-    std::vector<IPAddress> addressesa_;
-    std::vector<IPAddress> addressesb_;
+    std::vector<IOAddress> addressesa_;
+    std::vector<IOAddress> addressesb_;
 };
 
 HostsInMemTest::HostsInMemTest() {
@@ -54,16 +54,16 @@ HostsInMemTest::HostsInMemTest() {
     const uint32_t addra_template = 0xc0000205; // 192.0.2.5
     const uint32_t addrb_template = 0xc00a020a; // 192.10.2.10
     for (int i = 0; i < 50; ++i) {
-        IPAddress addra = IPAddress::fromLong(addra_template + i);
+        IOAddress addra = IOAddress(addra_template + i);
         addressesa_.push_back(addra);
-        IPAddress addrb = IPAddress::fromLong(addrb_template + i);
+        IOAddress addrb = IOAddress(addrb_template + i);
         addressesb_.push_back(addrb);
     }
 }
 
-IPAddress
-HostsInMemTest::increase(const IPAddress& address, const uint8_t num) const {
-    return (IPAddress::fromLongHBO(address.asV4().toLongHBO() + num));
+IOAddress
+HostsInMemTest::increase(const IOAddress& address, const uint8_t num) const {
+    return (IOAddress(static_cast<uint32_t>(address.toV4().to_ulong()) + num));
 }
 
 TEST_F(HostsInMemTest, getAllNonRepeatingHosts) {
@@ -84,14 +84,14 @@ TEST_F(HostsInMemTest, getAllNonRepeatingHosts) {
         HostCollection hosts = cfg.getAll(hwaddrs_[i].get(), duids_[i + 25].get());
         ASSERT_EQ(1, hosts.size());
         EXPECT_EQ(i % 10 + 1, hosts[0]->getIPv4SubnetID());
-        EXPECT_EQ(addressesa_[i].str(),
-                  hosts[0]->getIPv4Reservation().str());
+        EXPECT_EQ(addressesa_[i].toText(),
+                  hosts[0]->getIPv4Reservation().toText());
 
         hosts = cfg.getAll(hwaddrs_[i + 25].get(), duids_[i].get());
         ASSERT_EQ(1, hosts.size());
         EXPECT_EQ(i % 5 + 1, hosts[0]->getIPv4SubnetID());
-        EXPECT_EQ(addressesb_[i].str(),
-                  hosts[0]->getIPv4Reservation().str());
+        EXPECT_EQ(addressesb_[i].toText(),
+                  hosts[0]->getIPv4Reservation().toText());
     }
 
     for (int i = 49; i >= 25; --i) {
@@ -124,9 +124,9 @@ TEST_F(HostsInMemTest, getAllRepeatingHosts) {
         HostCollection hosts = cfg.getAll(hwaddrs_[i].get(), duids_[i + 25].get());
         ASSERT_EQ(2, hosts.size());
         EXPECT_EQ(1, hosts[0]->getIPv4SubnetID());
-        EXPECT_EQ(addressesa_[i].str(), hosts[0]->getIPv4Reservation().str());
+        EXPECT_EQ(addressesa_[i].toText(), hosts[0]->getIPv4Reservation().toText());
         EXPECT_EQ(2, hosts[1]->getIPv4SubnetID());
-        EXPECT_EQ(addressesb_[i].str(), hosts[1]->getIPv4Reservation().str());
+        EXPECT_EQ(addressesb_[i].toText(), hosts[1]->getIPv4Reservation().toText());
 
         hosts = cfg.getAll(hwaddrs_[i + 25].get(), duids_[i].get());
         ASSERT_EQ(2, hosts.size());
@@ -146,14 +146,14 @@ TEST_F(HostsInMemTest, getAll4ByAddress) {
         cfg.add(HostPtr(new Host(hwaddrs_[i]->toText(false),
                                  "hw-address",
                                  SubnetID(1 + i),
-                                 IPAddress("192.0.2.5"))));
+                                 IOAddress("192.0.2.5"))));
         cfg.add(HostPtr(new Host(duids_[i]->toText(),
                                  "duid",
                                  SubnetID(1 + i),
-                                 IPAddress("192.0.2.10"))));
+                                 IOAddress("192.0.2.10"))));
     }
 
-    HostCollection hosts = cfg.getAll4(IPAddress("192.0.2.10"));
+    HostCollection hosts = cfg.getAll4(IOAddress("192.0.2.10"));
     std::set<uint32_t> subnet_ids;
     for (auto host : hosts) {
         subnet_ids.insert(host->getIPv4SubnetID());
@@ -169,11 +169,11 @@ TEST_F(HostsInMemTest, get4) {
         cfg.add(HostPtr(new Host(hwaddrs_[i]->toText(false),
                                  "hw-address",
                                  SubnetID(1 + i % 2),
-                                 increase(IPAddress("192.0.2.5"), i))));
+                                 increase(IOAddress("192.0.2.5"), i))));
 
         cfg.add(HostPtr(new Host(duids_[i]->toText(), "duid",
                                  SubnetID(1 + i % 2),
-                                 increase(IPAddress("192.0.2.100"), i))));
+                                 increase(IOAddress("192.0.2.100"), i))));
     }
 
     for (unsigned i = 0; i < 25; ++i) {
@@ -181,13 +181,13 @@ TEST_F(HostsInMemTest, get4) {
                                 duids_[i + 25].get());
         ASSERT_TRUE(host);
         EXPECT_EQ(1 + i % 2, host->getIPv4SubnetID());
-        EXPECT_EQ(increase(IPAddress("192.0.2.5"), i),
+        EXPECT_EQ(increase(IOAddress("192.0.2.5"), i),
                   host->getIPv4Reservation());
 
         host = cfg.get4(SubnetID(1 + i % 2), hwaddrs_[i + 25].get(), duids_[i].get());
         ASSERT_TRUE(host);
         EXPECT_EQ(1 + i % 2, host->getIPv4SubnetID());
-        EXPECT_EQ(increase(IPAddress("192.0.2.100"), i),
+        EXPECT_EQ(increase(IOAddress("192.0.2.100"), i),
                   host->getIPv4Reservation());
 
     }
@@ -201,13 +201,13 @@ TEST_F(HostsInMemTest, add4AlreadyReserved) {
     HostPtr host1 = HostPtr(new Host(hwaddrs_[0]->toText(false),
                                      "hw-address",
                                      SubnetID(1),
-                                     IPAddress("192.0.2.1")));
+                                     IOAddress("192.0.2.1")));
     EXPECT_NO_THROW(cfg.add(std::move(host1)));
 
     HostPtr host2 = HostPtr(new Host(hwaddrs_[1]->toText(false),
                                      "hw-address",
                                      SubnetID(1),
-                                     IPAddress("192.0.2.1")));
+                                     IOAddress("192.0.2.1")));
 
     EXPECT_THROW(cfg.add(std::move(host2)), ReservedAddress);
 }
@@ -217,7 +217,7 @@ TEST_F(HostsInMemTest, zeroSubnetIDs) {
     ASSERT_THROW(cfg.add(HostPtr(new Host(hwaddrs_[0]->toText(false),
                                           "hw-address",
                                           SubnetID(0),
-                                          IPAddress("10.0.0.1")))),
+                                          IOAddress("10.0.0.1")))),
                  BadValue);
 }
 
@@ -226,18 +226,18 @@ TEST_F(HostsInMemTest, duplicatesSubnet4HWAddr) {
     ASSERT_NO_THROW(cfg.add(HostPtr(new Host(hwaddrs_[0]->toText(false),
                                              "hw-address",
                                              SubnetID(10),
-                                             IPAddress("10.0.0.1")))));
+                                             IOAddress("10.0.0.1")))));
 
     EXPECT_THROW(cfg.add(HostPtr(new Host(hwaddrs_[0]->toText(false),
                                           "hw-address",
                                           SubnetID(10),
-                                          IPAddress("10.0.0.10")))),
+                                          IOAddress("10.0.0.10")))),
                  DuplicateHost);
 
     EXPECT_NO_THROW(cfg.add(HostPtr(new Host(hwaddrs_[0]->toText(false),
                                              "hw-address",
                                              SubnetID(11),
-                                             IPAddress("10.0.0.10")))));
+                                             IOAddress("10.0.0.10")))));
 }
 
 TEST_F(HostsInMemTest, duplicatesSubnet4DUID) {
@@ -245,17 +245,103 @@ TEST_F(HostsInMemTest, duplicatesSubnet4DUID) {
     ASSERT_NO_THROW(cfg.add(HostPtr(new Host(duids_[0]->toText(),
                                              "duid",
                                              SubnetID(10),
-                                             IPAddress("10.0.0.1")))));
+                                             IOAddress("10.0.0.1")))));
 
     EXPECT_THROW(cfg.add(HostPtr(new Host(duids_[0]->toText(),
                                           "duid",
                                           SubnetID(10),
-                                          IPAddress("10.0.0.10")))),
+                                          IOAddress("10.0.0.10")))),
                  DuplicateHost);
 
     EXPECT_NO_THROW(cfg.add(HostPtr(new Host(duids_[0]->toText(),
                                              "duid",
                                              SubnetID(11),
-                                             IPAddress("10.0.0.10")))));
+                                             IOAddress("10.0.0.10")))));
 }
+
+TEST_F(HostsInMemTest, getByIndex) {
+    HostsInMem cfg;
+    cfg.add(HostPtr(new Host(hwaddrs_[0]->toText(false), "hw-address",
+                             SubnetID(1), IOAddress("10.0.0.1"))));
+    cfg.add(HostPtr(new Host(duids_[0]->toText(), "duid",
+                             SubnetID(1), IOAddress("10.0.0.2"))));
+    cfg.add(HostPtr(new Host(hwaddrs_[0]->toText(false), "hw-address",
+                             SubnetID(2), IOAddress("10.0.0.1"))));
+
+    const Host* host = cfg.get4(SubnetID(1), Host::IDENT_HWADDR,
+                                &hwaddrs_[0]->hwaddr_[0], hwaddrs_[0]->hwaddr_.size());
+    ASSERT_TRUE(host);
+    EXPECT_EQ(IOAddress("10.0.0.1"), host->getIPv4Reservation());
+    // same bytes as another identifier type don't match
+    EXPECT_FALSE(cfg.get4(SubnetID(1), Host::IDENT_DUID,
+                          &hwaddrs_[0]->hwaddr_[0], hwaddrs_[0]->hwaddr_.size()));
+    host = cfg.get4(SubnetID(1), Host::IDENT_DUID,
+                    &duids_[0]->getDuid()[0], duids_[0]->getDuid().size());
+    ASSERT_TRUE(host);
+    EXPECT_EQ(IOAddress("10.0.0.2"), host->getIPv4Reservation());
+
+    host = cfg.get4(SubnetID(2), IOAddress("10.0.0.1"));
+    ASSERT_TRUE(host);
+    EXPECT_EQ(2, host->getIPv4SubnetID());
+    EXPECT_FALSE(cfg.get4(SubnetID(2), IOAddress("10.0.0.2")));
+
+    // address only lookups return hosts in the order they were added
+    HostCollection hosts = cfg.getAll4(IOAddress("10.0.0.1"));
+    ASSERT_EQ(2, hosts.size());
+    EXPECT_EQ(1, hosts[0]->getIPv4SubnetID());
+    EXPECT_EQ(2, hosts[1]->getIPv4SubnetID());
+    EXPECT_TRUE(cfg.getAll4(IOAddress("10.0.0.3")).empty());
+}
+
+TEST_F(HostsInMemTest, delAndCopy) {
+    HostsInMem cfg;
+    for (unsigned i = 0; i < 20; ++i) {
+        cfg.add(HostPtr(new Host(hwaddrs_[i]->toText(false), "hw-address",
+                                 SubnetID(1 + i % 2), IOAddress(0x0a000001 + i))));
+    }
+
+    HostsInMem copy(cfg);
+    copy.del(SubnetID(1));
+    EXPECT_EQ(10, copy.size());
+    EXPECT_FALSE(copy.get4(SubnetID(1), hwaddrs_[0].get(), nullptr));
+    EXPECT_FALSE(copy.get4(SubnetID(1), IOAddress(0x0a000001)));
+    EXPECT_TRUE(copy.getAll4(IOAddress(0x0a000001)).empty());
+    EXPECT_TRUE(copy.get4(SubnetID(2), hwaddrs_[1].get(), nullptr));
+
+    // the original keeps its hosts
+    EXPECT_EQ(20, cfg.size());
+    EXPECT_TRUE(cfg.get4(SubnetID(1), hwaddrs_[0].get(), nullptr));
+
+    // a freed address can be reserved again
+    EXPECT_NO_THROW(copy.add(HostPtr(new Host(hwaddrs_[0]->toText(false), "hw-address",
+                                              SubnetID(1), IOAddress(0x0a000001)))));
+    EXPECT_EQ(1, copy.getAll4(IOAddress(0x0a000001)).size());
+}
+
+TEST_F(HostsInMemTest, getMany) {
+    const uint32_t count = 200000;
+    HostsInMem cfg;
+    std::vector<uint8_t> mac(6, 0);
+    for (uint32_t i = 0; i < count; ++i) {
+        mac[2] = i >> 24;
+        mac[3] = i >> 16;
+        mac[4] = i >> 8;
+        mac[5] = i;
+        cfg.add(HostPtr(new Host(&mac[0], mac.size(), Host::IDENT_HWADDR,
+                                 SubnetID(1 + i % 100), IOAddress(0x0a000000 + i))));
+    }
+    EXPECT_EQ(count, cfg.size());
+
+    for (uint32_t i = 0; i < count; i += 997) {
+        mac[2] = i >> 24;
+        mac[3] = i >> 16;
+        mac[4] = i >> 8;
+        mac[5] = i;
+        const Host* host = cfg.get4(SubnetID(1 + i % 100), Host::IDENT_HWADDR, &mac[0], mac.size());
+        ASSERT_TRUE(host);
+        EXPECT_EQ(IOAddress(0x0a000000 + i), host->getIPv4Reservation());
+        EXPECT_EQ(host, cfg.get4(SubnetID(1 + i % 100), IOAddress(0x0a000000 + i)));
+    }
+}
+
 } // end of anonymous namespace
@@ -0,0 +1,64 @@
+#include <kea/server/inflight_table.h>
+#include <gtest/gtest.h>
+
+using namespace kea;
+using namespace kea::server;
+
+namespace {
+
+TEST(InflightTableTest, suppress) {
+    std::shared_ptr<InflightTable> table(new InflightTable(10));
+    std::string discover_key = InflightTable::getExchangeKey("client1", 1, 1);
+    std::string request_key = InflightTable::getExchangeKey("client1", 1, 3);
+
+    InflightTable::Token token = table->begin(discover_key);
+    ASSERT_NE(nullptr, token);
+    EXPECT_EQ(nullptr, table->begin(discover_key));
+    EXPECT_EQ(1, table->getSuppressedCount());
+
+    // another message type or transaction is another exchange
+    InflightTable::Token request_token = table->begin(request_key);
+    EXPECT_NE(nullptr, request_token);
+    EXPECT_NE(nullptr, table->begin(InflightTable::getExchangeKey("client1", 2, 1)));
+    EXPECT_EQ(1, table->getSuppressedCount());
+
+    token.reset();
+    EXPECT_EQ(1, table->size());
+    EXPECT_NE(nullptr, table->begin(discover_key));
+}
+
+TEST(InflightTableTest, lost) {
+    std::shared_ptr<InflightTable> table(new InflightTable(0));
+    std::string key = InflightTable::getExchangeKey("client1", 1, 1);
+
+    InflightTable::Token lost_token = table->begin(key);
+    InflightTable::Token token = table->begin(key);
+    ASSERT_NE(nullptr, token);
+    EXPECT_EQ(0, table->getSuppressedCount());
+
+    // the lost exchange finishing late doesn't end the new one
+    lost_token.reset();
+    EXPECT_EQ(1, table->size());
+    token.reset();
+    EXPECT_EQ(0, table->size());
+}
+
+TEST(InflightTableTest, noClientKey) {
+    std::shared_ptr<InflightTable> table(new InflightTable(10));
+    std::string key = InflightTable::getExchangeKey("", 1, 1);
+    InflightTable::Token token = table->begin(key);
+    EXPECT_NE(nullptr, token);
+    EXPECT_NE(nullptr, table->begin(key));
+    EXPECT_EQ(0, table->size());
+}
+
+TEST(InflightTableTest, outliveTable) {
+    InflightTable::Token token;
+    {
+        std::shared_ptr<InflightTable> table(new InflightTable(10));
+        token = table->begin(InflightTable::getExchangeKey("client1", 1, 1));
+    }
+    token.reset();
+}
+
+};
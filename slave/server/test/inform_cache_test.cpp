@@ -0,0 +1,81 @@
+#include <kea/server/inform_cache.h>
+#include <kea/dhcp++/dhcp4.h>
+#include <kea/dhcp++/option.h>
+#include <kea/dhcp++/option_int_array.h>
+#include <gtest/gtest.h>
+
+using namespace kea;
+using namespace kea::dhcp;
+using namespace kea::server;
+
+namespace {
+
+PktPtr makeInform(const std::vector<uint8_t>& prl) {
+    PktPtr query(new Pkt(DHCPINFORM, 1));
+    query->setLocalAddr(IOAddress("10.0.0.254"));
+    query->setIface("eth0");
+    query->addOption(std::unique_ptr<Option>(new OptionUint8Array(DHO_DHCP_PARAMETER_REQUEST_LIST, prl)));
+    return query;
+}
+
+PktPtr makeAck() {
+    PktPtr rsp(new Pkt(DHCPACK, 1));
+    rsp->addOption(std::unique_ptr<Option>(new Option(DHO_DHCP_CLIENT_IDENTIFIER, OptionBuffer(6, 1))));
+    rsp->addOption(std::unique_ptr<Option>(new Option(DHO_SUBNET_MASK, OptionBuffer(4, 255))));
+    rsp->addOption(std::unique_ptr<Option>(new Option(DHO_DHCP_SERVER_IDENTIFIER, OptionBuffer(4, 10))));
+    rsp->pack();
+    return rsp;
+}
+
+TEST(InformCacheTest, sharedOptions) {
+    InformCache cache(100);
+    std::string key = InformCache::getInformKey(1, 1, *makeInform({1, 3}));
+    std::vector<uint8_t> options;
+    EXPECT_FALSE(cache.get(key, options));
+
+    cache.put(key, *makeAck());
+    EXPECT_EQ(1, cache.size());
+    ASSERT_TRUE(cache.get(key, options));
+
+    // message type and client identifier are packed per response
+    std::vector<uint8_t> expected = {DHO_SUBNET_MASK, 4, 255, 255, 255, 255,
+        DHO_DHCP_SERVER_IDENTIFIER, 4, 10, 10, 10, 10};
+    EXPECT_EQ(expected, options);
+}
+
+TEST(InformCacheTest, key) {
+    std::string key = InformCache::getInformKey(1, 1, *makeInform({1, 3}));
+    EXPECT_EQ(key, InformCache::getInformKey(1, 1, *makeInform({1, 3})));
+    EXPECT_NE(key, InformCache::getInformKey(1, 2, *makeInform({1, 3})));
+    EXPECT_NE(key, InformCache::getInformKey(1, 1, *makeInform({1, 3, 6})));
+    EXPECT_NE(key, InformCache::getInformKey(2, 1, *makeInform({1, 3})));
+
+    PktPtr query = makeInform({1, 3});
+    query->setLocalAddr(IOAddress("10.0.1.254"));
+    EXPECT_NE(key, InformCache::getInformKey(1, 1, *query));
+}
+
+TEST(InformCacheTest, packCachedOptions) {
+    InformCache cache(100);
+    std::string key = InformCache::getInformKey(1, 1, *makeInform({1, 3}));
+    PktPtr ack = makeAck();
+    cache.put(key, *ack);
+
+    std::vector<uint8_t> options;
+    ASSERT_TRUE(cache.get(key, options));
+    PktPtr rsp(new Pkt(DHCPACK, 1));
+    rsp->addOption(std::unique_ptr<Option>(new Option(DHO_DHCP_CLIENT_IDENTIFIER, OptionBuffer(6, 1))));
+    rsp->pack(options.data(), options.size());
+    EXPECT_EQ(ack->getBuffer().getLength(), rsp->getBuffer().getLength());
+}
+
+TEST(InformCacheTest, clear) {
+    InformCache cache(100);
+    cache.put(InformCache::getInformKey(1, 1, *makeInform({1})), *makeAck());
+    cache.put(InformCache::getInformKey(1, 2, *makeInform({1})), *makeAck());
+    EXPECT_EQ(2, cache.size());
+    cache.clear();
+    EXPECT_EQ(0, cache.size());
+}
+
+};
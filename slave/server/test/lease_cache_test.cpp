@@ -0,0 +1,100 @@
+#include <kea/server/lease_cache.h>
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace kea;
+using namespace kea::server;
+
+namespace {
+
+const uint32_t ADDR1 = 0x0a000001;
+const uint32_t ADDR2 = 0x0a000002;
+
+TEST(LeaseCacheTest, renew) {
+    LeaseCache cache(100, 600);
+    EXPECT_FALSE(cache.renew("client1", ADDR1, 1, 3600));
+
+    cache.put("client1", ADDR1, 1, 3600);
+    EXPECT_EQ(1, cache.size());
+    EXPECT_TRUE(cache.renew("client1", ADDR1, 1, 3600));
+    EXPECT_FALSE(cache.renew("client1", ADDR2, 1, 3600));
+    EXPECT_FALSE(cache.renew("client1", ADDR1, 2, 3600));
+    EXPECT_FALSE(cache.renew("client2", ADDR1, 1, 3600));
+    EXPECT_FALSE(cache.renew("", ADDR1, 1, 3600));
+}
+
+TEST(LeaseCacheTest, stale) {
+    LeaseCache cache(100, 0);
+    cache.put("client1", ADDR1, 1, 3600);
+    EXPECT_FALSE(cache.renew("client1", ADDR1, 1, 3600));
+
+    LeaseCache expired_cache(100, 600);
+    expired_cache.put("client1", ADDR1, 1, 0);
+    EXPECT_FALSE(expired_cache.renew("client1", ADDR1, 1, 3600));
+}
+
+TEST(LeaseCacheTest, erase) {
+    LeaseCache cache(100, 600);
+    cache.put("client1", ADDR1, 1, 3600);
+    cache.put("client2", ADDR2, 1, 3600);
+
+    cache.erase("client1");
+    EXPECT_FALSE(cache.renew("client1", ADDR1, 1, 3600));
+    EXPECT_EQ(1, cache.size());
+
+    EXPECT_EQ(0, cache.eraseAddr(ADDR1));
+    EXPECT_EQ(1, cache.eraseAddr(ADDR2));
+    EXPECT_FALSE(cache.renew("client2", ADDR2, 1, 3600));
+    EXPECT_EQ(0, cache.size());
+
+    cache.put("client1", ADDR1, 1, 3600);
+    cache.clear();
+    EXPECT_EQ(0, cache.size());
+}
+
+TEST(LeaseCacheTest, addrMoved) {
+    LeaseCache cache(100, 600);
+    cache.put("client1", ADDR1, 1, 3600);
+    cache.put("client1", ADDR2, 1, 3600);
+    EXPECT_FALSE(cache.renew("client1", ADDR1, 1, 3600));
+    EXPECT_EQ(0, cache.eraseAddr(ADDR1));
+    EXPECT_TRUE(cache.renew("client1", ADDR2, 1, 3600));
+}
+
+TEST(LeaseCacheTest, addrReassigned) {
+    // most of the pairs land in different shards
+    LeaseCache cache(1000, 600);
+    for (uint32_t i = 0; i < 64; i++) {
+        cache.put("old" + std::to_string(i), ADDR1 + i, 1, 3600);
+        cache.put("new" + std::to_string(i), ADDR1 + i, 1, 3600);
+    }
+    EXPECT_EQ(64, cache.size());
+    for (uint32_t i = 0; i < 64; i++) {
+        EXPECT_FALSE(cache.renew("old" + std::to_string(i), ADDR1 + i, 1, 3600));
+        EXPECT_TRUE(cache.renew("new" + std::to_string(i), ADDR1 + i, 1, 3600));
+    }
+
+    // released by the new owner, the old one still can't have it
+    cache.erase("new0");
+    EXPECT_FALSE(cache.renew("old0", ADDR1, 1, 3600));
+    EXPECT_EQ(1, cache.eraseAddr(ADDR1 + 1));
+    EXPECT_EQ(0, cache.eraseAddr(ADDR1 + 1));
+    EXPECT_EQ(62, cache.size());
+}
+
+TEST(LeaseCacheTest, evicted) {
+    LeaseCache cache(16, 600);
+    for (uint32_t i = 0; i < 1000; i++) {
+        cache.put("client" + std::to_string(i), ADDR1 + i, 1, 3600);
+    }
+    EXPECT_GE(32, cache.size());
+    // an evicted lease leaves no owner behind
+    size_t erased = 0;
+    for (uint32_t i = 0; i < 1000; i++) {
+        erased += cache.eraseAddr(ADDR1 + i);
+    }
+    EXPECT_EQ(0, cache.size());
+    EXPECT_GE(32, erased);
+}
+
+};
@@ -0,0 +1,149 @@
+#include <kea/server/lease_journal.h>
+#include <kea/exceptions/exceptions.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace kea;
+using namespace kea::server;
+
+namespace {
+
+const char* JOURNAL_PATH = "lease_journal_test.journal";
+
+class LeaseJournalTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        unlink(JOURNAL_PATH);
+    }
+
+    virtual void TearDown() {
+        unlink(JOURNAL_PATH);
+    }
+
+    static LeaseRecord makeLease(uint32_t addr, const char* mac) {
+        LeaseRecord lease;
+        lease.addr_ = addr;
+        lease.subnet_id_ = 1;
+        lease.expire_ = 1000;
+        lease.mac_len_ = strlen(mac);
+        memcpy(lease.mac_, mac, lease.mac_len_);
+        return lease;
+    }
+
+    static std::vector<std::pair<bool, uint32_t>> replayAll(LeaseJournal& journal) {
+        std::vector<std::pair<bool, uint32_t>> records;
+        journal.replay([&records](bool put, const LeaseRecord& record) {
+            records.push_back(std::make_pair(put, record.addr_));
+        });
+        return records;
+    }
+};
+
+TEST_F(LeaseJournalTest, replay) {
+    {
+        LeaseJournal journal(JOURNAL_PATH, 16, false);
+        EXPECT_EQ(0, journal.size());
+        EXPECT_TRUE(journal.appendPut(makeLease(1, "mac1")));
+        EXPECT_TRUE(journal.appendPut(makeLease(2, "mac2")));
+        EXPECT_TRUE(journal.appendDelete(makeLease(1, "mac1")));
+    }
+
+    LeaseJournal journal(JOURNAL_PATH, 16, false);
+    EXPECT_EQ(3, journal.size());
+    std::vector<std::pair<bool, uint32_t>> records = replayAll(journal);
+    ASSERT_EQ(3, records.size());
+    EXPECT_EQ(std::make_pair(true, uint32_t(1)), records[0]);
+    EXPECT_EQ(std::make_pair(true, uint32_t(2)), records[1]);
+    EXPECT_EQ(std::make_pair(false, uint32_t(1)), records[2]);
+
+    journal.replay([](bool, const LeaseRecord& record) {
+        EXPECT_EQ(4, record.mac_len_);
+        EXPECT_EQ(1, record.subnet_id_);
+        EXPECT_EQ(1000, record.expire_);
+    });
+}
+
+TEST_F(LeaseJournalTest, full) {
+    LeaseJournal journal(JOURNAL_PATH, 2, false);
+    EXPECT_TRUE(journal.appendPut(makeLease(1, "mac1")));
+    EXPECT_TRUE(journal.appendPut(makeLease(2, "mac2")));
+    EXPECT_FALSE(journal.appendPut(makeLease(3, "mac3")));
+    EXPECT_EQ(2, journal.size());
+}
+
+TEST_F(LeaseJournalTest, compact) {
+    {
+        LeaseJournal journal(JOURNAL_PATH, 2, false);
+        EXPECT_TRUE(journal.appendPut(makeLease(1, "mac1")));
+        EXPECT_TRUE(journal.appendPut(makeLease(2, "mac2")));
+
+        std::vector<LeaseRecord> leases;
+        leases.push_back(makeLease(2, "mac2"));
+        leases.push_back(makeLease(3, "mac3"));
+        journal.compact(leases);
+        EXPECT_EQ(2, journal.size());
+        EXPECT_EQ(4, journal.capacity());
+        EXPECT_TRUE(journal.appendDelete(makeLease(2, "mac2")));
+    }
+
+    LeaseJournal journal(JOURNAL_PATH, 2, false);
+    EXPECT_EQ(4, journal.capacity());
+    std::vector<std::pair<bool, uint32_t>> records = replayAll(journal);
+    ASSERT_EQ(3, records.size());
+    EXPECT_EQ(std::make_pair(true, uint32_t(2)), records[0]);
+    EXPECT_EQ(std::make_pair(true, uint32_t(3)), records[1]);
+    EXPECT_EQ(std::make_pair(false, uint32_t(2)), records[2]);
+}
+
+TEST_F(LeaseJournalTest, tornRecord) {
+    {
+        LeaseJournal journal(JOURNAL_PATH, 16, true);
+        EXPECT_TRUE(journal.appendPut(makeLease(1, "mac1")));
+        EXPECT_TRUE(journal.appendPut(makeLease(2, "mac2")));
+        EXPECT_TRUE(journal.appendPut(makeLease(3, "mac3")));
+    }
+
+    // flip the last byte of the second record as a crash in the middle
+    // of writing it would
+    {
+        LeaseJournal journal(JOURNAL_PATH, 16, false);
+        ASSERT_EQ(3, journal.size());
+    }
+    off_t file_len = 0;
+    {
+        int fd = open(JOURNAL_PATH, O_RDWR);
+        ASSERT_LE(0, fd);
+        file_len = lseek(fd, 0, SEEK_END);
+        size_t slot_len = (file_len - 64) / 16;
+        off_t offset = 64 + 2 * slot_len - 1;
+        uint8_t byte = 0;
+        ASSERT_EQ(1, pread(fd, &byte, 1, offset));
+        byte ^= 0xff;
+        ASSERT_EQ(1, pwrite(fd, &byte, 1, offset));
+        close(fd);
+    }
+
+    LeaseJournal journal(JOURNAL_PATH, 16, false);
+    EXPECT_EQ(1, journal.size());
+    std::vector<std::pair<bool, uint32_t>> records = replayAll(journal);
+    ASSERT_EQ(1, records.size());
+    EXPECT_EQ(std::make_pair(true, uint32_t(1)), records[0]);
+
+    // appending goes on right behind the last good record
+    EXPECT_TRUE(journal.appendPut(makeLease(4, "mac4")));
+    EXPECT_EQ(2, journal.size());
+}
+
+TEST_F(LeaseJournalTest, brokenFile) {
+    int fd = open(JOURNAL_PATH, O_RDWR | O_CREAT, 0644);
+    ASSERT_LE(0, fd);
+    ASSERT_EQ(5, write(fd, "hello", 5));
+    close(fd);
+
+    EXPECT_THROW(LeaseJournal(JOURNAL_PATH, 16, false), BadValue);
+}
+
+}
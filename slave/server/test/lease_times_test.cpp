@@ -0,0 +1,97 @@
+#include <kea/server/lease_times.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+using namespace kea;
+using namespace kea::server;
+
+namespace {
+
+TEST(LeaseTimesTest, noJitter) {
+    Subnet::LeaseJitter jitter;
+    LeaseTimes times = jitterLeaseTimes(4000, 0, jitter, 12345, 67890);
+    EXPECT_EQ(4000, times.valid_);
+    EXPECT_EQ(2000, times.t1_);
+    EXPECT_EQ(3000, times.t2_);
+}
+
+TEST(LeaseTimesTest, renewJitter) {
+    Subnet::LeaseJitter jitter;
+    jitter.renew_jitter_ = 10;
+    uint32_t min_t1 = 4000;
+    uint32_t max_t1 = 0;
+    for (uint64_t random = 0; random < 1000; random++) {
+        LeaseTimes times = jitterLeaseTimes(4000, 0, jitter, 0, random * 7919);
+        EXPECT_EQ(4000, times.valid_);
+        EXPECT_EQ(1000, times.t2_ - times.t1_);
+        min_t1 = std::min(min_t1, times.t1_);
+        max_t1 = std::max(max_t1, times.t1_);
+    }
+    EXPECT_LE(1800, min_t1);
+    EXPECT_GE(2200, max_t1);
+    EXPECT_GT(max_t1, min_t1);
+}
+
+TEST(LeaseTimesTest, smoothingWindow) {
+    Subnet::LeaseJitter jitter;
+    jitter.smoothing_window_ = 200;
+    LeaseTimes times = jitterLeaseTimes(4000, 0, jitter, 150, 0);
+    EXPECT_EQ(2050, times.t1_);
+    EXPECT_EQ(3050, times.t2_);
+
+    // the same client always lands on the same place
+    LeaseTimes again = jitterLeaseTimes(4000, 0, jitter, 150, 12345);
+    EXPECT_EQ(times.t1_, again.t1_);
+
+    // a window wider than valid/4 is scaled into it, T2 stays before valid
+    jitter.smoothing_window_ = 4000;
+    times = jitterLeaseTimes(4000, 0, jitter, 3999, 0);
+    EXPECT_EQ(2499, times.t1_);
+    EXPECT_EQ(3499, times.t2_);
+    times = jitterLeaseTimes(4000, 0, jitter, 0, 0);
+    EXPECT_EQ(1500, times.t1_);
+    EXPECT_EQ(2500, times.t2_);
+}
+
+TEST(LeaseTimesTest, wideWindowDistribution) {
+    Subnet::LeaseJitter jitter;
+    jitter.smoothing_window_ = 40000;
+    jitter.renew_jitter_ = 50;
+    std::vector<uint32_t> buckets(10, 0);
+    uint32_t at_edge = 0;
+    for (uint64_t client = 0; client < 40000; client++) {
+        LeaseTimes times = jitterLeaseTimes(4000, 0, jitter, client, client * 7919);
+        ASSERT_LE(1500, times.t1_);
+        ASSERT_GE(2500, times.t1_);
+        ASSERT_LT(times.t2_, times.valid_);
+        if (times.t1_ == 1500 || times.t1_ == 2500) {
+            at_edge++;
+        }
+        buckets[std::min<uint32_t>((times.t1_ - 1500) / 100, 9)]++;
+    }
+
+    // nobody is pushed onto the limits, and the middle of the range isn't
+    // emptier than the rest
+    EXPECT_GT(100, at_edge);
+    for (size_t i = 2; i < 8; i++) {
+        EXPECT_LT(3000, buckets[i]);
+    }
+}
+
+TEST(LeaseTimesTest, lifetimeJitter) {
+    Subnet::LeaseJitter jitter;
+    jitter.lifetime_jitter_ = 10;
+    for (uint64_t random = 0; random < 1000; random++) {
+        LeaseTimes times = jitterLeaseTimes(4000, 3900, jitter, 0, random * 7919);
+        EXPECT_LE(3900, times.valid_);
+        EXPECT_GE(4000, times.valid_);
+        EXPECT_LT(times.t1_, times.t2_);
+        EXPECT_LT(times.t2_, times.valid_);
+    }
+
+    LeaseTimes times = jitterLeaseTimes(4000, 4000, jitter, 0, 7919);
+    EXPECT_EQ(4000, times.valid_);
+}
+
+};
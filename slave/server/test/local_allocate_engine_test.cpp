@@ -0,0 +1,79 @@
+#include <kea/server/local_allocate_engine.h>
+#include <kea/server/hosts_in_mem.h>
+#include <gtest/gtest.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+using namespace kea;
+using namespace kea::server;
+using namespace kea::rpc;
+
+namespace {
+
+const char* JOURNAL_PATH = "local_allocate_engine_test.journal";
+const uint8_t MAC[] = {0x00, 0x0c, 0x01, 0x02, 0x03, 0x04};
+
+class LocalAllocateEngineTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        unlink(JOURNAL_PATH);
+        std::unique_ptr<Subnet> subnet(new Subnet(IOAddress("10.0.0.0"), 24, 1, 2, 3600, 1));
+        subnet->addPool(std::unique_ptr<Pool>(new Pool(IOAddress("10.0.0.1"), IOAddress("10.0.0.10"))));
+        subnet_mgr_.add(std::move(subnet));
+
+        LocalAllocateConf conf;
+        conf.journal_path_ = JOURNAL_PATH;
+        conf.journal_capacity_ = 1024;
+        engine_.reset(new LocalAllocateEngine(conf, subnet_mgr_, hosts_));
+    }
+
+    virtual void TearDown() {
+        engine_.reset();
+        unlink(JOURNAL_PATH);
+    }
+
+    static RequestFields makeRequest(RequestType type, uint32_t addr) {
+        RequestFields fields;
+        fields.request_type_ = type;
+        fields.subnet_id_ = 1;
+        fields.mac_ = MAC;
+        fields.mac_len_ = sizeof(MAC);
+        fields.request_addr_ = htonl(addr);
+        return fields;
+    }
+
+    SubnetMgr subnet_mgr_;
+    HostsInMem hosts_;
+    std::unique_ptr<LocalAllocateEngine> engine_;
+};
+
+TEST_F(LocalAllocateEngineTest, rapidCommitConflictRetry) {
+    RequestFields fields = makeRequest(RT_RAPID_COMMIT, 0);
+    LeaseResultMsg result;
+    ASSERT_TRUE(engine_->handle(fields, result));
+    uint32_t first_addr = ntohl(result.addr_);
+    EXPECT_EQ(0, result.addr_count_);
+    EXPECT_EQ(1, engine_->getLeaseCount());
+
+    // the committed address answered the ping, the retry asks for
+    // candidates like a discover does
+    ASSERT_TRUE(engine_->handle(makeRequest(RT_CONFLICT_IP, first_addr), result));
+    fields.candidate_count_ = 4;
+    LeaseResultMsg retry_result;
+    ASSERT_TRUE(engine_->handle(fields, retry_result));
+    EXPECT_NE(first_addr, ntohl(retry_result.addr_));
+    // one address committed and nothing else to pick from
+    EXPECT_EQ(0, retry_result.addr_count_);
+    EXPECT_EQ(2, engine_->getLeaseCount());
+
+    // a discover still gets its candidates
+    RequestFields discover = makeRequest(RT_DISCOVER, 0);
+    discover.mac_len_ = 5;
+    discover.candidate_count_ = 4;
+    LeaseResultMsg discover_result;
+    ASSERT_TRUE(engine_->handle(discover, discover_result));
+    EXPECT_EQ(4, discover_result.addr_count_);
+    EXPECT_EQ(2, engine_->getLeaseCount());
+}
+
+};
@@ -0,0 +1,68 @@
+#include <kea/server/offer_cache.h>
+#include <gtest/gtest.h>
+
+using namespace kea;
+using namespace kea::server;
+
+namespace {
+
+const uint32_t ADDR1 = 0x0a000001;
+const uint32_t ADDR2 = 0x0a000002;
+
+OfferedLease makeOffer(uint32_t addr, uint32_t subnet_id, uint32_t shared_subnet_id) {
+    OfferedLease offer;
+    offer.addr_ = addr;
+    offer.subnet_id_ = subnet_id;
+    offer.shared_subnet_id_ = shared_subnet_id;
+    offer.config_version_ = 1;
+    return offer;
+}
+
+TEST(OfferCacheTest, take) {
+    OfferCache cache(100, 60);
+    OfferedLease offer;
+    EXPECT_FALSE(cache.take("client1", 1, ADDR1, offer));
+
+    cache.put("client1", 1, makeOffer(ADDR1, 1, 2));
+    EXPECT_EQ(1, cache.size());
+    EXPECT_FALSE(cache.take("client1", 2, ADDR1, offer));
+    EXPECT_FALSE(cache.take("client2", 1, ADDR1, offer));
+    EXPECT_TRUE(cache.take("client1", 1, ADDR1, offer));
+    EXPECT_EQ(ADDR1, offer.addr_);
+    EXPECT_EQ(1, offer.subnet_id_);
+    EXPECT_EQ(2, offer.shared_subnet_id_);
+
+    // an offer is only used once
+    EXPECT_FALSE(cache.take("client1", 1, ADDR1, offer));
+    EXPECT_EQ(0, cache.size());
+}
+
+TEST(OfferCacheTest, otherAddr) {
+    OfferCache cache(100, 60);
+    OfferedLease offer;
+    cache.put("client1", 1, makeOffer(ADDR1, 1, 0));
+    EXPECT_FALSE(cache.take("client1", 1, ADDR2, offer));
+    EXPECT_FALSE(cache.take("client1", 1, ADDR1, offer));
+    EXPECT_FALSE(cache.take("", 1, ADDR1, offer));
+}
+
+TEST(OfferCacheTest, timeout) {
+    OfferCache cache(100, 0);
+    OfferedLease offer;
+    cache.put("client1", 1, makeOffer(ADDR1, 1, 0));
+    EXPECT_FALSE(cache.take("client1", 1, ADDR1, offer));
+    EXPECT_EQ(0, cache.size());
+}
+
+TEST(OfferCacheTest, bounded) {
+    OfferCache cache(16, 60);
+    for (uint32_t xid = 0; xid < 1000; xid++) {
+        cache.put("client1", xid, makeOffer(ADDR1, 1, 0));
+    }
+    EXPECT_GE(32, cache.size());
+
+    cache.clear();
+    EXPECT_EQ(0, cache.size());
+}
+
+};
@@ -0,0 +1,136 @@
+#include <kea/server/pkt_dispatcher.h>
+#include <kea/dhcp++/dhcp4.h>
+#include <kea/dhcp++/option.h>
+#include <gtest/gtest.h>
+
+using namespace kea;
+using namespace kea::dhcp;
+using namespace kea::server;
+
+namespace {
+
+PktPtr makeQuery(uint8_t type, uint32_t xid, uint8_t mac, uint8_t client_id = 0) {
+    Pkt query(type, xid);
+    query.setHWAddr(HTYPE_ETHER, 6, std::vector<uint8_t>(6, mac));
+    if (client_id != 0) {
+        query.addOption(std::unique_ptr<Option>(new Option(DHO_DHCP_CLIENT_IDENTIFIER,
+                        OptionBuffer(7, client_id))));
+    }
+    query.pack();
+    return PktPtr(new Pkt(static_cast<const uint8_t*>(query.getBuffer().getData()),
+                query.getBuffer().getLength()));
+}
+
+PktHeader peek(const PktPtr& query) {
+    PktHeader header;
+    EXPECT_TRUE(peekPktHeader(&query->getData()[0], query->getData().size(), header));
+    return header;
+}
+
+AdmissionConf makeConf() {
+    AdmissionConf conf;
+    conf.capacity_ = 100;
+    conf.discover_limit_ = 100;
+    conf.max_age_ = std::chrono::milliseconds(0);
+    conf.secs_threshold_ = 0;
+    conf.max_buckets_ = 16;
+    return conf;
+}
+
+TEST(PktDispatcherTest, peekClient) {
+    PktPtr query = makeQuery(DHCPDISCOVER, 1, 0xa, 0xb);
+    PktHeader header = peek(query);
+    EXPECT_EQ(DHCPDISCOVER, header.msg_type_);
+    EXPECT_EQ(HTYPE_ETHER, header.htype_);
+    EXPECT_EQ(6, header.hlen_);
+    EXPECT_EQ(0xa, header.chaddr_[5]);
+    ASSERT_NE(nullptr, header.client_id_);
+    EXPECT_EQ(7, header.client_id_len_);
+
+    // the client identifier wins over the hardware address, as in client key
+    EXPECT_EQ(getClientHash(header), getClientHash(peek(makeQuery(DHCPREQUEST, 2, 0xc, 0xb))));
+    EXPECT_NE(getClientHash(header), getClientHash(peek(makeQuery(DHCPREQUEST, 2, 0xa))));
+    EXPECT_EQ(getClientHash(peek(makeQuery(DHCPDISCOVER, 3, 0xa))),
+            getClientHash(peek(makeQuery(DHCPREQUEST, 4, 0xa))));
+}
+
+TEST(PktDispatcherTest, clientAffinity) {
+    std::vector<std::unique_ptr<AdmissionQueue>> queues;
+    std::vector<AdmissionQueue*> queue_ptrs;
+    for (int i = 0; i < 4; i++) {
+        queues.push_back(std::unique_ptr<AdmissionQueue>(new AdmissionQueue(makeConf())));
+        queue_ptrs.push_back(queues.back().get());
+    }
+    PktDispatcher dispatcher(queue_ptrs);
+
+    for (uint8_t mac = 1; mac <= 32; mac++) {
+        size_t worker = dispatcher.getWorker(peek(makeQuery(DHCPDISCOVER, 1, mac)));
+        ASSERT_LT(worker, 4);
+        size_t depth = queues[worker]->getStats().depth_;
+        EXPECT_TRUE(dispatcher.dispatch(makeQuery(DHCPDISCOVER, 1, mac)));
+        EXPECT_TRUE(dispatcher.dispatch(makeQuery(DHCPREQUEST, 2, mac)));
+        EXPECT_EQ(depth + 2, queues[worker]->getStats().depth_);
+    }
+
+    size_t total = 0;
+    for (auto& queue : queues) {
+        // 32 clients spread over every worker
+        EXPECT_NE(0, queue->getStats().depth_);
+        total += queue->getStats().depth_;
+    }
+    EXPECT_EQ(64, total);
+}
+
+TEST(PktDispatcherTest, resizeKeepsClients) {
+    std::vector<std::unique_ptr<AdmissionQueue>> queues;
+    std::vector<AdmissionQueue*> queue_ptrs;
+    for (int i = 0; i < 4; i++) {
+        queues.push_back(std::unique_ptr<AdmissionQueue>(new AdmissionQueue(makeConf())));
+        queue_ptrs.push_back(queues.back().get());
+    }
+    PktDispatcher dispatcher(queue_ptrs);
+
+    std::vector<PktHeader> headers;
+    std::vector<PktPtr> queries;
+    for (uint8_t mac = 1; mac <= 200; mac++) {
+        queries.push_back(makeQuery(DHCPDISCOVER, 1, mac));
+        headers.push_back(peek(queries.back()));
+    }
+
+    std::vector<size_t> on_four;
+    for (auto& header : headers) {
+        on_four.push_back(dispatcher.getWorker(header));
+    }
+
+    // parking the last worker only moves its own clients
+    dispatcher.setActiveCount(3);
+    size_t moved = 0;
+    for (size_t i = 0; i < headers.size(); i++) {
+        size_t worker = dispatcher.getWorker(headers[i]);
+        ASSERT_LT(worker, 3);
+        if (on_four[i] != 3) {
+            EXPECT_EQ(on_four[i], worker);
+        } else {
+            moved++;
+        }
+    }
+    EXPECT_LT(0, moved);
+    EXPECT_GT(100, moved);
+
+    // and activating it again brings back exactly those
+    dispatcher.setActiveCount(4);
+    for (size_t i = 0; i < headers.size(); i++) {
+        EXPECT_EQ(on_four[i], dispatcher.getWorker(headers[i]));
+    }
+}
+
+TEST(PktDispatcherTest, truncated) {
+    AdmissionQueue queue(makeConf());
+    PktDispatcher dispatcher({&queue});
+    // no magic cookie
+    uint8_t data[Pkt::DHCPV4_PKT_HDR_LEN + 4] = {0};
+    EXPECT_TRUE(dispatcher.dispatch(PktPtr(new Pkt(data, sizeof(data)))));
+    EXPECT_EQ(1, queue.getStats().depth_);
+}
+
+};
@@ -0,0 +1,44 @@
+#include <kea/server/pkt_queue.h>
+#include <kea/dhcp++/dhcp4.h>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using namespace kea;
+using namespace kea::dhcp;
+using namespace kea::server;
+
+namespace {
+
+TEST(PktQueueTest, batchLargerThanRing) {
+    PktQueue queue(8);
+    size_t received = 0;
+    // the send thread is asleep on the empty queue before the batch starts
+    std::thread sender([&queue, &received]() {
+        PktPtr pkts[4];
+        bool stop = false;
+        while (!stop) {
+            size_t count = queue.blockingReadBatch(pkts, 4);
+            for (size_t i = 0; i < count; i++) {
+                if (pkts[i] == nullptr) {
+                    stop = true;
+                    break;
+                }
+                received++;
+                pkts[i].reset();
+            }
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    std::vector<PktPtr> batch;
+    for (uint32_t i = 0; i < 100; i++) {
+        batch.push_back(PktPtr(new Pkt(DHCPOFFER, i)));
+    }
+    queue.blockingWriteBatch(&batch[0], batch.size());
+    queue.blockingWrite(nullptr);
+    sender.join();
+    EXPECT_EQ(100, received);
+}
+
+};
@@ -0,0 +1,71 @@
+#include <kea/server/response_cache.h>
+#include <kea/dhcp++/dhcp4.h>
+#include <gtest/gtest.h>
+
+using namespace kea;
+using namespace kea::dhcp;
+using namespace kea::server;
+
+namespace {
+
+PktPtr makeResponse(uint8_t type, uint32_t xid) {
+    PktPtr rsp(new Pkt(type, xid));
+    rsp->setRemoteAddr(IOAddress("10.0.0.1"));
+    rsp->setLocalAddr(IOAddress("10.0.0.254"));
+    rsp->setRemotePort(DHCP4_SERVER_PORT);
+    rsp->setIface("eth0");
+    rsp->setIfaceIndex(2);
+    rsp->pack();
+    return rsp;
+}
+
+TEST(ResponseCacheTest, replay) {
+    ResponseCache cache(100, 10);
+    std::string key = ResponseCache::getResponseKey("client1", 1, DHCPREQUEST, 1);
+    EXPECT_EQ(nullptr, cache.get(key));
+
+    PktPtr rsp = makeResponse(DHCPACK, 1);
+    cache.put(key, *rsp);
+    EXPECT_EQ(1, cache.size());
+
+    PktPtr replay = cache.get(key);
+    ASSERT_NE(nullptr, replay);
+    EXPECT_EQ(DHCPACK, replay->getType());
+    EXPECT_EQ(1, replay->getTransid());
+    EXPECT_EQ("10.0.0.1", replay->getRemoteAddr().toText());
+    EXPECT_EQ("10.0.0.254", replay->getLocalAddr().toText());
+    EXPECT_EQ(DHCP4_SERVER_PORT, replay->getRemotePort());
+    EXPECT_EQ("eth0", replay->getIface());
+    EXPECT_EQ(2, replay->getIfaceIndex());
+    ASSERT_EQ(rsp->getBuffer().getLength(), replay->getBuffer().getLength());
+    EXPECT_EQ(0, memcmp(rsp->getBuffer().getData(), replay->getBuffer().getData(),
+                rsp->getBuffer().getLength()));
+
+    // a retransmission may be lost again, the entry stays for the window
+    EXPECT_NE(nullptr, cache.get(key));
+}
+
+TEST(ResponseCacheTest, otherExchange) {
+    ResponseCache cache(100, 10);
+    PktPtr rsp = makeResponse(DHCPOFFER, 1);
+    cache.put(ResponseCache::getResponseKey("client1", 1, DHCPDISCOVER, 1), *rsp);
+    EXPECT_EQ(nullptr, cache.get(ResponseCache::getResponseKey("client1", 1, DHCPREQUEST, 1)));
+    EXPECT_EQ(nullptr, cache.get(ResponseCache::getResponseKey("client1", 2, DHCPDISCOVER, 1)));
+    EXPECT_EQ(nullptr, cache.get(ResponseCache::getResponseKey("client2", 1, DHCPDISCOVER, 1)));
+    // answered on an older configure
+    EXPECT_EQ(nullptr, cache.get(ResponseCache::getResponseKey("client1", 1, DHCPDISCOVER, 2)));
+
+    cache.put(ResponseCache::getResponseKey("", 1, DHCPDISCOVER, 1), *rsp);
+    EXPECT_EQ(1, cache.size());
+}
+
+TEST(ResponseCacheTest, expire) {
+    ResponseCache cache(100, 0);
+    std::string key = ResponseCache::getResponseKey("client1", 1, DHCPREQUEST, 1);
+    PktPtr rsp = makeResponse(DHCPACK, 1);
+    cache.put(key, *rsp);
+    EXPECT_EQ(nullptr, cache.get(key));
+    EXPECT_EQ(0, cache.size());
+}
+
+};
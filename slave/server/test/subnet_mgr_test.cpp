@@ -1,6 +1,6 @@
 #include <kea/dhcp++/classify.h>
 #include <kea/server/subnet_mgr.h>
-#include <kea/server/subnet.h>
+#include <kea/dhcp++/subnet.h>
 #include <kea/server/subnet_id.h>
 #include <gtest/gtest.h>
 
@@ -14,17 +14,17 @@ using Subnet4Ptr = kea::server::SubnetMgr::Subnet4Ptr;
 
 TEST(SubnetMgrTest, selectSubnetByCiaddr) {
     SubnetMgr mgr;
-    Subnet4* subnet1 = new Subnet4(IPAddress("192.0.2.0"), 26, 1, 2, 3);
-    Subnet4* subnet2 = new Subnet4(IPAddress("192.0.2.64"), 26, 1, 2, 3);
-    Subnet4* subnet3 = new Subnet4(IPAddress("192.0.2.128"), 26, 1, 2, 3);
+    Subnet* subnet1 = new Subnet(IOAddress("192.0.2.0"), 26, 1, 2, 3, 1);
+    Subnet* subnet2 = new Subnet(IOAddress("192.0.2.64"), 26, 1, 2, 3, 2);
+    Subnet* subnet3 = new Subnet(IOAddress("192.0.2.128"), 26, 1, 2, 3, 3);
 
     SubnetSelector selector;
-    selector.ciaddr_ = IPAddress("192.0.2.0");
-    selector.local_address_ = IPAddress("10.0.0.100");
+    selector.ciaddr_ = IOAddress("192.0.2.0");
+    selector.local_address_ = IOAddress("10.0.0.100");
     ASSERT_FALSE(mgr.selectSubnet(selector));
 
     mgr.add(Subnet4Ptr(subnet1));
-    selector.ciaddr_ = IPAddress("192.0.2.63");
+    selector.ciaddr_ = IOAddress("192.0.2.63");
     EXPECT_EQ(subnet1, mgr.selectSubnet(selector));
 
     // Add all other subnets.
@@ -32,23 +32,23 @@ TEST(SubnetMgrTest, selectSubnetByCiaddr) {
     mgr.add(Subnet4Ptr(subnet3));
 
     // Make sure they are returned for the appropriate addresses.
-    selector.ciaddr_ = IPAddress("192.0.2.15");
+    selector.ciaddr_ = IOAddress("192.0.2.15");
     EXPECT_EQ(subnet1, mgr.selectSubnet(selector));
-    selector.ciaddr_ = IPAddress("192.0.2.85");
+    selector.ciaddr_ = IOAddress("192.0.2.85");
     EXPECT_EQ(subnet2, mgr.selectSubnet(selector));
-    selector.ciaddr_ = IPAddress("192.0.2.191");
+    selector.ciaddr_ = IOAddress("192.0.2.191");
     EXPECT_EQ(subnet3, mgr.selectSubnet(selector));
 
-    selector.ciaddr_ = IPAddress("192.0.2.192");
+    selector.ciaddr_ = IOAddress("192.0.2.192");
     EXPECT_FALSE(mgr.selectSubnet(selector));
 }
 
 
 TEST(SubnetMgrTest, selectSubnetByClasses) {
     SubnetMgr mgr;
-    Subnet4* subnet1 = new Subnet4(IPAddress("192.0.2.0"), 26, 1, 2, 3);
-    Subnet4* subnet2 = new Subnet4(IPAddress("192.0.2.64"), 26, 1, 2, 3);
-    Subnet4* subnet3 = new Subnet4(IPAddress("192.0.2.128"), 26, 1, 2, 3);
+    Subnet* subnet1 = new Subnet(IOAddress("192.0.2.0"), 26, 1, 2, 3, 1);
+    Subnet* subnet2 = new Subnet(IOAddress("192.0.2.64"), 26, 1, 2, 3, 2);
+    Subnet* subnet3 = new Subnet(IOAddress("192.0.2.128"), 26, 1, 2, 3, 3);
 
     mgr.add(Subnet4Ptr(subnet1));
     mgr.add(Subnet4Ptr(subnet2));     
@@ -56,63 +56,65 @@ TEST(SubnetMgrTest, selectSubnetByClasses) {
 
     SubnetSelector selector;
 
-    selector.local_address_ = IPAddress("10.0.0.10");
+    selector.local_address_ = IOAddress("10.0.0.10");
 
-    selector.ciaddr_ = IPAddress("192.0.2.5");
+    selector.ciaddr_ = IOAddress("192.0.2.5");
     EXPECT_EQ(subnet1, mgr.selectSubnet(selector));
-    selector.ciaddr_ = IPAddress("192.0.2.70");
+    selector.ciaddr_ = IOAddress("192.0.2.70");
     EXPECT_EQ(subnet2, mgr.selectSubnet(selector));
-    selector.ciaddr_ = IPAddress("192.0.2.130");
+    selector.ciaddr_ = IOAddress("192.0.2.130");
     EXPECT_EQ(subnet3, mgr.selectSubnet(selector));
 
     ClientClasses client_classes;
     client_classes.insert("bar");
     selector.client_classes_ = client_classes;
 
-    selector.ciaddr_ = IPAddress("192.0.2.5");
+    selector.ciaddr_ = IOAddress("192.0.2.5");
     EXPECT_EQ(subnet1, mgr.selectSubnet(selector));
-    selector.ciaddr_ = IPAddress("192.0.2.70");
+    selector.ciaddr_ = IOAddress("192.0.2.70");
     EXPECT_EQ(subnet2, mgr.selectSubnet(selector));
-    selector.ciaddr_ = IPAddress("192.0.2.130");
+    selector.ciaddr_ = IOAddress("192.0.2.130");
     EXPECT_EQ(subnet3, mgr.selectSubnet(selector));
 
     subnet1->allowClientClass("foo"); // Serve here only clients from foo class
     subnet2->allowClientClass("bar"); // Serve here only clients from bar class
     subnet3->allowClientClass("baz"); // Serve here only clients from baz class
 
-    selector.ciaddr_ = IPAddress("192.0.2.5");
+    selector.ciaddr_ = IOAddress("192.0.2.5");
     EXPECT_FALSE(mgr.selectSubnet(selector));
-    selector.ciaddr_ = IPAddress("192.0.2.70");
+    selector.ciaddr_ = IOAddress("192.0.2.70");
     EXPECT_EQ(subnet2, mgr.selectSubnet(selector));
-    selector.ciaddr_ = IPAddress("192.0.2.130");
+    selector.ciaddr_ = IOAddress("192.0.2.130");
     EXPECT_FALSE(mgr.selectSubnet(selector));
 
     client_classes.clear();
     client_classes.insert("some_other_class");
     selector.client_classes_ = client_classes;
-    selector.ciaddr_ = IPAddress("192.0.2.5");
+    selector.ciaddr_ = IOAddress("192.0.2.5");
     EXPECT_FALSE(mgr.selectSubnet(selector));
-    selector.ciaddr_ = IPAddress("192.0.2.70");
+    selector.ciaddr_ = IOAddress("192.0.2.70");
     EXPECT_FALSE(mgr.selectSubnet(selector));
-    selector.ciaddr_ = IPAddress("192.0.2.130");
+    selector.ciaddr_ = IOAddress("192.0.2.130");
     EXPECT_FALSE(mgr.selectSubnet(selector));
 
     client_classes.clear();
-    selector.ciaddr_ = IPAddress("192.0.2.5");
+    selector.ciaddr_ = IOAddress("192.0.2.5");
     EXPECT_FALSE(mgr.selectSubnet(selector));
-    selector.ciaddr_ = IPAddress("192.0.2.70");
+    selector.ciaddr_ = IOAddress("192.0.2.70");
     EXPECT_FALSE(mgr.selectSubnet(selector));
-    selector.ciaddr_ = IPAddress("192.0.2.130");
+    selector.ciaddr_ = IOAddress("192.0.2.130");
     EXPECT_FALSE(mgr.selectSubnet(selector));
 }
 
 TEST(SubnetMgrTest, selectSubnetByOptionSelect) {
     SubnetMgr mgr;
 
-    Subnet4* subnet1 = new Subnet4(IPAddress("192.0.2.0"), 26, 1, 2, 3);
-    Subnet4* subnet2 = new Subnet4(IPAddress("192.0.2.64"), 26, 1, 2, 3);
-    Subnet4* subnet3 = new Subnet4(IPAddress("192.0.2.128"), 26, 1, 2, 3);
+    Subnet* subnet1 = new Subnet(IOAddress("192.0.2.0"), 26, 1, 2, 3, 1);
+    Subnet* subnet2 = new Subnet(IOAddress("192.0.2.64"), 26, 1, 2, 3, 2);
+    Subnet* subnet3 = new Subnet(IOAddress("192.0.2.128"), 26, 1, 2, 3, 3);
 
+    // relay info is indexed when the subnet is added
+    subnet2->setRelayInfo(IOAddress("10.0.0.1"));
     mgr.add(Subnet4Ptr(subnet1));
     mgr.add(Subnet4Ptr(subnet2));     
     mgr.add(Subnet4Ptr(subnet3));   
@@ -120,22 +122,21 @@ TEST(SubnetMgrTest, selectSubnetByOptionSelect) {
     SubnetSelector selector;
 
     // Check that without option selection something else is used
-    selector.ciaddr_ = IPAddress("192.0.2.5");
+    selector.ciaddr_ = IOAddress("192.0.2.5");
     EXPECT_EQ(subnet1, mgr.selectSubnet(selector));
 
     // The option selection has precedence
-    selector.option_select_ = IPAddress("192.0.2.130");
+    selector.option_select_ = IOAddress("192.0.2.130");
     EXPECT_EQ(subnet3, mgr.selectSubnet(selector));
 
     // Over relay-info too
-    selector.giaddr_ = IPAddress("10.0.0.1");
-    subnet2->setRelayInfo(IPAddress("10.0.0.1"));
+    selector.giaddr_ = IOAddress("10.0.0.1");
     EXPECT_EQ(subnet3, mgr.selectSubnet(selector));
-    selector.option_select_ = IPAddress("0.0.0.0");
+    selector.option_select_ = IOAddress("0.0.0.0");
     EXPECT_EQ(subnet2, mgr.selectSubnet(selector));
 
     // Check that a not matching option selection it shall fail
-    selector.option_select_ = IPAddress("10.0.0.1");
+    selector.option_select_ = IOAddress("10.0.0.1");
     EXPECT_FALSE(mgr.selectSubnet(selector));
 }
 
@@ -143,9 +144,9 @@ TEST(SubnetMgrTest, selectSubnetByOptionSelect) {
 // subnet.
 TEST(SubnetMgrTest, selectSubnetByRelayAddress) {
     SubnetMgr mgr;
-    Subnet4* subnet1 = new Subnet4(IPAddress("192.0.2.0"), 26, 1, 2, 3);
-    Subnet4* subnet2 = new Subnet4(IPAddress("192.0.2.64"), 26, 1, 2, 3);
-    Subnet4* subnet3 = new Subnet4(IPAddress("192.0.2.128"), 26, 1, 2, 3);
+    Subnet* subnet1 = new Subnet(IOAddress("192.0.2.0"), 26, 1, 2, 3, 1);
+    Subnet* subnet2 = new Subnet(IOAddress("192.0.2.64"), 26, 1, 2, 3, 2);
+    Subnet* subnet3 = new Subnet(IOAddress("192.0.2.128"), 26, 1, 2, 3, 3);
     mgr.add(Subnet4Ptr(subnet1));
     mgr.add(Subnet4Ptr(subnet2));     
     mgr.add(Subnet4Ptr(subnet3));   
@@ -153,55 +154,62 @@ TEST(SubnetMgrTest, selectSubnetByRelayAddress) {
     SubnetSelector selector;
 
     // Check that without relay-info specified, subnets are not selected
-    selector.giaddr_ = IPAddress("10.0.0.1");
+    selector.giaddr_ = IOAddress("10.0.0.1");
     EXPECT_FALSE(mgr.selectSubnet(selector));
-    selector.giaddr_ = IPAddress("10.0.0.2");
+    selector.giaddr_ = IOAddress("10.0.0.2");
     EXPECT_FALSE(mgr.selectSubnet(selector));
-    selector.giaddr_ = IPAddress("10.0.0.3");
+    selector.giaddr_ = IOAddress("10.0.0.3");
     EXPECT_FALSE(mgr.selectSubnet(selector));
 
-    // Now specify relay info
-    subnet1->setRelayInfo(IPAddress("10.0.0.1"));
-    subnet2->setRelayInfo(IPAddress("10.0.0.2"));
-    subnet3->setRelayInfo(IPAddress("10.0.0.3"));
+    // Now specify relay info, it's indexed when the subnets are added
+    SubnetMgr relay_mgr;
+    Subnet* relay_subnet1 = new Subnet(IOAddress("192.0.2.0"), 26, 1, 2, 3, 1);
+    Subnet* relay_subnet2 = new Subnet(IOAddress("192.0.2.64"), 26, 1, 2, 3, 2);
+    Subnet* relay_subnet3 = new Subnet(IOAddress("192.0.2.128"), 26, 1, 2, 3, 3);
+    relay_subnet1->setRelayInfo(IOAddress("10.0.0.1"));
+    relay_subnet2->setRelayInfo(IOAddress("10.0.0.2"));
+    relay_subnet3->setRelayInfo(IOAddress("10.0.0.3"));
+    relay_mgr.add(Subnet4Ptr(relay_subnet1));
+    relay_mgr.add(Subnet4Ptr(relay_subnet2));
+    relay_mgr.add(Subnet4Ptr(relay_subnet3));
 
     // And try again. This time relay-info is there and should match.
-    selector.giaddr_ = IPAddress("10.0.0.1");
-    EXPECT_EQ(subnet1, mgr.selectSubnet(selector));
-    selector.giaddr_ = IPAddress("10.0.0.2");
-    EXPECT_EQ(subnet2, mgr.selectSubnet(selector));
-    selector.giaddr_ = IPAddress("10.0.0.3");
-    EXPECT_EQ(subnet3, mgr.selectSubnet(selector));
+    selector.giaddr_ = IOAddress("10.0.0.1");
+    EXPECT_EQ(relay_subnet1, relay_mgr.selectSubnet(selector));
+    selector.giaddr_ = IOAddress("10.0.0.2");
+    EXPECT_EQ(relay_subnet2, relay_mgr.selectSubnet(selector));
+    selector.giaddr_ = IOAddress("10.0.0.3");
+    EXPECT_EQ(relay_subnet3, relay_mgr.selectSubnet(selector));
 }
 
 TEST(SubnetMgrTest, selectSubnetNoCiaddr) {
     SubnetMgr mgr;
 
     // Create 3 subnets.
-    Subnet4* subnet1 = new Subnet4(IPAddress("192.0.2.0"), 26, 1, 2, 3);
-    Subnet4* subnet2 = new Subnet4(IPAddress("192.0.2.64"), 26, 1, 2, 3);
-    Subnet4* subnet3 = new Subnet4(IPAddress("192.0.2.128"), 26, 1, 2, 3);
+    Subnet* subnet1 = new Subnet(IOAddress("192.0.2.0"), 26, 1, 2, 3, 1);
+    Subnet* subnet2 = new Subnet(IOAddress("192.0.2.64"), 26, 1, 2, 3, 2);
+    Subnet* subnet3 = new Subnet(IOAddress("192.0.2.128"), 26, 1, 2, 3, 3);
 
     SubnetSelector selector;
-    selector.remote_address_ = IPAddress("192.0.2.0");
-    selector.local_address_ = IPAddress("10.0.0.100");
+    selector.remote_address_ = IOAddress("192.0.2.0");
+    selector.local_address_ = IOAddress("10.0.0.100");
     ASSERT_FALSE(mgr.selectSubnet(selector));
 
     mgr.add(Subnet4Ptr(subnet1));     
-    selector.remote_address_ = IPAddress("192.0.2.63");
+    selector.remote_address_ = IOAddress("192.0.2.63");
     EXPECT_EQ(subnet1, mgr.selectSubnet(selector));
 
     mgr.add(Subnet4Ptr(subnet2));   
     mgr.add(Subnet4Ptr(subnet3));   
 
-    selector.remote_address_ = IPAddress("192.0.2.15");
+    selector.remote_address_ = IOAddress("192.0.2.15");
     EXPECT_EQ(subnet1, mgr.selectSubnet(selector));
-    selector.remote_address_ = IPAddress("192.0.2.85");
+    selector.remote_address_ = IOAddress("192.0.2.85");
     EXPECT_EQ(subnet2, mgr.selectSubnet(selector));
-    selector.remote_address_ = IPAddress("192.0.2.191");
+    selector.remote_address_ = IOAddress("192.0.2.191");
     EXPECT_EQ(subnet3, mgr.selectSubnet(selector));
 
-    selector.remote_address_ = IPAddress("192.0.2.192");
+    selector.remote_address_ = IOAddress("192.0.2.192");
     EXPECT_FALSE(mgr.selectSubnet(selector));
 }
 
@@ -217,7 +225,7 @@ TEST(SubnetMgrTest, selectSubnetInterface) {
     selector.iface_name_ = "eth1";
     EXPECT_FALSE(mgr.selectSubnet(selector));
 
-    Subnet4Ptr subnet1(new Subnet4(IPAddress("10.0.0.1"), 24, 1, 2, 3));
+    Subnet4Ptr subnet1(new Subnet(IOAddress("10.0.0.1"), 24, 1, 2, 3));
     mgr.add(subnet1);
 
     selector.iface_name_ = "eth0";
@@ -227,7 +235,7 @@ TEST(SubnetMgrTest, selectSubnetInterface) {
     selector.iface_name_ = "eth1";
     EXPECT_FALSE(mgr.selectSubnet(selector));
 
-    Subnet4Ptr subnet2(new Subnet4(IPAddress("192.0.2.1"), 24, 1, 2, 3));
+    Subnet4Ptr subnet2(new Subnet(IOAddress("192.0.2.1"), 24, 1, 2, 3));
     mgr.add(subnet2);
 
     selector.iface_name_ = "eth0";
@@ -244,15 +252,115 @@ TEST(SubnetMgrTest, selectSubnetInterface) {
     */
 }
 
+// Overlapping prefixes are matched in configuration order, not by the
+// longest one, the same as a linear scan over the subnets.
+TEST(SubnetMgrTest, selectSubnetOverlapping) {
+    SubnetMgr mgr;
+    Subnet* wide = new Subnet(IOAddress("10.0.0.0"), 8, 1, 2, 3, 1);
+    Subnet* narrow = new Subnet(IOAddress("10.1.2.0"), 24, 1, 2, 3, 2);
+    Subnet* host = new Subnet(IOAddress("10.1.2.3"), 32, 1, 2, 3, 3);
+    wide->allowClientClass("foo");
+    mgr.add(SubnetMgr::Subnet4Ptr(wide));
+    mgr.add(SubnetMgr::Subnet4Ptr(narrow));
+    mgr.add(SubnetMgr::Subnet4Ptr(host));
+
+    ClientClasses foo;
+    foo.insert("foo");
+    EXPECT_EQ(wide, mgr.selectSubnet(IOAddress("10.1.2.3"), foo));
+    EXPECT_EQ(wide, mgr.selectSubnet(IOAddress("10.200.0.1"), foo));
+
+    // clients not in foo fall through to the next configured subnet
+    EXPECT_EQ(narrow, mgr.selectSubnet(IOAddress("10.1.2.3")));
+    EXPECT_EQ(narrow, mgr.selectSubnet(IOAddress("10.1.2.255")));
+    EXPECT_FALSE(mgr.selectSubnet(IOAddress("10.200.0.1")));
+    EXPECT_FALSE(mgr.selectSubnet(IOAddress("11.1.2.3")));
+
+    EXPECT_EQ(host, mgr.getSubnet(3));
+    EXPECT_FALSE(mgr.getSubnet(4));
+}
+
+TEST(SubnetMgrTest, selectSubnetMany) {
+    SubnetMgr mgr;
+    std::vector<Subnet*> subnets;
+    for (uint32_t i = 0; i < 40000; i++) {
+        // 10.0.0.0/24 upwards with host bits left in the configured prefix
+        Subnet* subnet = new Subnet(IOAddress((10 << 24) + (i << 8) + 1), 24, 1, 2, 3, i + 1);
+        subnet->setRelayInfo(Subnet::RelayInfo(IOAddress((172 << 24) + i + 1)));
+        subnets.push_back(subnet);
+        ASSERT_TRUE(mgr.add(SubnetMgr::Subnet4Ptr(subnet)));
+    }
+    EXPECT_FALSE(mgr.add(SubnetMgr::Subnet4Ptr(new Subnet(IOAddress("192.0.2.0"), 24, 1, 2, 3, 7))));
+
+    for (uint32_t i = 0; i < 40000; i += 997) {
+        EXPECT_EQ(subnets[i], mgr.selectSubnet(IOAddress((10 << 24) + (i << 8) + 200)));
+        EXPECT_EQ(subnets[i], mgr.getSubnet(i + 1));
+
+        SubnetSelector selector;
+        selector.giaddr_ = IOAddress((172 << 24) + i + 1);
+        EXPECT_EQ(subnets[i], mgr.selectSubnet(selector));
+    }
+    EXPECT_FALSE(mgr.selectSubnet(IOAddress("192.0.2.1")));
+}
+
+// Subnets updated or deleted on a copy leave the original alone, and an
+// updated subnet keeps its place in the configured order.
+TEST(SubnetMgrTest, updateAndDelete) {
+    SubnetMgr mgr;
+    Subnet* wide = new Subnet(IOAddress("10.0.0.0"), 8, 1, 2, 3, 1);
+    Subnet* narrow = new Subnet(IOAddress("10.1.2.0"), 24, 1, 2, 3, 2);
+    narrow->setRelayInfo(Subnet::RelayInfo(IOAddress("172.16.0.1")));
+    mgr.add(SubnetMgr::Subnet4Ptr(wide));
+    mgr.add(SubnetMgr::Subnet4Ptr(narrow));
+
+    SubnetMgr copy(mgr);
+    EXPECT_FALSE(copy.del(3));
+    EXPECT_TRUE(copy.del(1));
+    EXPECT_EQ(1, copy.size());
+    EXPECT_FALSE(copy.getSubnet(1));
+    EXPECT_EQ(narrow, copy.selectSubnet(IOAddress("10.1.2.3")));
+    EXPECT_FALSE(copy.selectSubnet(IOAddress("10.200.0.1")));
+    EXPECT_EQ(wide, mgr.selectSubnet(IOAddress("10.1.2.3")));
+    EXPECT_EQ(wide, mgr.getSubnet(1));
+
+    // a deleted id can be added again, at the end of the configured order
+    Subnet* readded = new Subnet(IOAddress("10.0.0.0"), 8, 1, 2, 3, 1);
+    EXPECT_TRUE(copy.add(SubnetMgr::Subnet4Ptr(readded)));
+    EXPECT_EQ(2, copy.size());
+    EXPECT_EQ(readded, copy.getSubnet(1));
+    EXPECT_EQ(narrow, copy.selectSubnet(IOAddress("10.1.2.3")));
+    EXPECT_EQ(readded, copy.selectSubnet(IOAddress("10.200.0.1")));
+
+    // the new subnet 1 takes the place of the old one, before subnet 2
+    Subnet* moved = new Subnet(IOAddress("10.1.0.0"), 16, 1, 2, 3, 1);
+    SubnetMgr updated(mgr);
+    EXPECT_FALSE(updated.update(SubnetMgr::Subnet4Ptr(new Subnet(IOAddress("10.0.0.0"), 8, 1, 2, 3, 3))));
+    EXPECT_TRUE(updated.update(SubnetMgr::Subnet4Ptr(moved)));
+    EXPECT_EQ(moved, updated.selectSubnet(IOAddress("10.1.2.3")));
+    EXPECT_FALSE(updated.selectSubnet(IOAddress("10.200.0.1")));
+    EXPECT_EQ(moved, updated.getSubnet(1));
+
+    SubnetSelector selector;
+    selector.giaddr_ = IOAddress("172.16.0.1");
+    EXPECT_EQ(narrow, updated.selectSubnet(selector));
+    // without relay info giaddr only matches by prefix
+    EXPECT_TRUE(updated.update(SubnetMgr::Subnet4Ptr(new Subnet(IOAddress("10.1.2.0"), 24, 1, 2, 3, 2))));
+    EXPECT_FALSE(updated.selectSubnet(selector));
+    selector.giaddr_ = IOAddress("10.1.2.1");
+    EXPECT_EQ(moved, updated.selectSubnet(selector));
+    selector.giaddr_ = IOAddress("172.16.0.1");
+    EXPECT_EQ(narrow, mgr.selectSubnet(selector));
+}
+
 TEST(SubnetMgrTest, duplication) {
     SubnetMgr mgr;
 
-    Subnet4Ptr subnet1(new Subnet4(IPAddress("192.0.2.0"), 26, 1, 2, 3, 123));
-    Subnet4Ptr subnet2(new Subnet4(IPAddress("192.0.2.64"), 26, 1, 2, 3, 124));
-    Subnet4Ptr subnet3(new Subnet4(IPAddress("192.0.2.128"), 26, 1, 2, 3, 123));
+    Subnet4Ptr subnet1(new Subnet(IOAddress("192.0.2.0"), 26, 1, 2, 3, 123));
+    Subnet4Ptr subnet2(new Subnet(IOAddress("192.0.2.64"), 26, 1, 2, 3, 124));
+    Subnet4Ptr subnet3(new Subnet(IOAddress("192.0.2.128"), 26, 1, 2, 3, 123));
 
-    ASSERT_NO_THROW(mgr.add(std::move(subnet1)));
-    EXPECT_NO_THROW(mgr.add(std::move(subnet2)));
-    EXPECT_THROW(mgr.add(std::move(subnet3)), kea::server::DuplicateSubnetID);
+    ASSERT_TRUE(mgr.add(std::move(subnet1)));
+    EXPECT_TRUE(mgr.add(std::move(subnet2)));
+    EXPECT_FALSE(mgr.add(std::move(subnet3)));
+    EXPECT_EQ(2, mgr.size());
 }
 };
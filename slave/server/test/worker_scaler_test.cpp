@@ -0,0 +1,102 @@
+#include <kea/server/worker_scaler.h>
+#include <kea/dhcp++/dhcp4.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace kea;
+using namespace kea::dhcp;
+using namespace kea::server;
+
+namespace {
+
+PktPtr makeQuery(uint32_t xid) {
+    Pkt query(DHCPREQUEST, xid);
+    query.setHWAddr(HTYPE_ETHER, 6, std::vector<uint8_t>(6, static_cast<uint8_t>(xid)));
+    query.pack();
+    return PktPtr(new Pkt(static_cast<const uint8_t*>(query.getBuffer().getData()),
+                query.getBuffer().getLength()));
+}
+
+AdmissionConf makeAdmissionConf() {
+    AdmissionConf conf;
+    conf.capacity_ = 100;
+    conf.discover_limit_ = 100;
+    conf.max_age_ = std::chrono::milliseconds(0);
+    conf.secs_threshold_ = 0;
+    conf.max_buckets_ = 16;
+    return conf;
+}
+
+WorkerScalerConf makeScalerConf() {
+    WorkerScalerConf conf;
+    conf.min_workers_ = 1;
+    conf.max_workers_ = 3;
+    conf.grow_wait_ = std::chrono::milliseconds(5);
+    conf.shrink_wait_ = std::chrono::milliseconds(1);
+    return conf;
+}
+
+class WorkerScalerTest : public ::testing::Test {
+public:
+    WorkerScalerTest() {
+        std::vector<AdmissionQueue*> queue_ptrs;
+        for (int i = 0; i < 3; i++) {
+            queues_.push_back(std::unique_ptr<AdmissionQueue>(new AdmissionQueue(makeAdmissionConf())));
+            queue_ptrs.push_back(queues_.back().get());
+        }
+        dispatcher_.reset(new PktDispatcher(queue_ptrs));
+        scaler_.reset(new WorkerScaler(makeScalerConf(), *dispatcher_, queue_ptrs));
+    }
+
+    std::vector<std::unique_ptr<AdmissionQueue>> queues_;
+    std::unique_ptr<PktDispatcher> dispatcher_;
+    std::unique_ptr<WorkerScaler> scaler_;
+};
+
+TEST_F(WorkerScalerTest, decide) {
+    // 10ms waited on average
+    EXPECT_EQ(2, scaler_->decide(1, 10, 100000));
+    EXPECT_EQ(3, scaler_->decide(3, 10, 100000));
+    EXPECT_EQ(2, scaler_->decide(2, 10, 30000));
+    EXPECT_EQ(1, scaler_->decide(2, 10, 5000));
+    EXPECT_EQ(1, scaler_->decide(1, 10, 5000));
+    // idle workers are parked
+    EXPECT_EQ(2, scaler_->decide(3, 0, 0));
+}
+
+TEST_F(WorkerScalerTest, activeCount) {
+    EXPECT_EQ(3, dispatcher_->getActiveCount());
+    dispatcher_->setActiveCount(0);
+    EXPECT_EQ(1, dispatcher_->getActiveCount());
+    dispatcher_->setActiveCount(10);
+    EXPECT_EQ(3, dispatcher_->getActiveCount());
+
+    // parked workers get nothing new
+    dispatcher_->setActiveCount(1);
+    for (uint32_t xid = 1; xid < 32; xid++) {
+        EXPECT_TRUE(dispatcher_->dispatch(makeQuery(xid)));
+    }
+    EXPECT_EQ(31, queues_[0]->getStats().depth_);
+    EXPECT_EQ(0, queues_[1]->getStats().depth_);
+    EXPECT_EQ(0, queues_[2]->getStats().depth_);
+    EXPECT_EQ(31, queues_[0]->getStats().high_water_);
+}
+
+TEST_F(WorkerScalerTest, adjust) {
+    dispatcher_->setActiveCount(1);
+    EXPECT_TRUE(dispatcher_->dispatch(makeQuery(1)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    PktPtr pkt;
+    ASSERT_TRUE(queues_[0]->read(pkt));
+    AdmissionStats stats = queues_[0]->getStats();
+    EXPECT_EQ(1, stats.served_);
+    EXPECT_LE(20000, stats.wait_us_);
+
+    EXPECT_EQ(2, scaler_->adjust());
+    EXPECT_EQ(2, dispatcher_->getActiveCount());
+    // only the last interval counts
+    EXPECT_EQ(1, scaler_->adjust());
+    EXPECT_EQ(1, dispatcher_->getActiveCount());
+}
+
+};
@@ -0,0 +1,96 @@
+#include <kea/server/worker_scaler.h>
+#include <kea/logging/logging.h>
+#include <kea/util/thread_affinity.h>
+
+using namespace kea::logging;
+
+namespace kea {
+namespace server {
+
+WorkerScaler::WorkerScaler(const WorkerScalerConf& conf, PktDispatcher& dispatcher,
+                           std::vector<AdmissionQueue*> queues)
+    : conf_(conf), dispatcher_(dispatcher), queues_(std::move(queues)),
+      last_served_(0), last_wait_us_(0), stop_(true) {
+}
+
+WorkerScaler::~WorkerScaler() {
+    stop();
+}
+
+void
+WorkerScaler::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!stop_) {
+        return;
+    }
+
+    stop_ = false;
+    std::thread scale_thread([this]() {
+        kea::util::ThreadAffinity::instance().pinCurrent(kea::util::TC_CONTROL);
+        this->scaleLoop();
+    });
+    scale_thread_ = std::move(scale_thread);
+}
+
+void
+WorkerScaler::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stop_) {
+            return;
+        }
+        stop_ = true;
+    }
+    cond_.notify_one();
+    scale_thread_.join();
+}
+
+size_t
+WorkerScaler::decide(size_t active, uint64_t served, uint64_t wait_us) const {
+    uint64_t average_wait_us = served != 0 ? wait_us / served : 0;
+    if (average_wait_us > static_cast<uint64_t>(conf_.grow_wait_.count()) && active < conf_.max_workers_) {
+        return active + 1;
+    }
+    if (average_wait_us < static_cast<uint64_t>(conf_.shrink_wait_.count()) && active > conf_.min_workers_) {
+        return active - 1;
+    }
+    return active;
+}
+
+size_t
+WorkerScaler::adjust() {
+    uint64_t served = 0;
+    uint64_t wait_us = 0;
+    for (auto queue : queues_) {
+        AdmissionStats stats = queue->getStats();
+        served += stats.served_;
+        wait_us += stats.wait_us_;
+    }
+
+    size_t active = dispatcher_.getActiveCount();
+    size_t next = decide(active, served - last_served_, wait_us - last_wait_us_);
+    last_served_ = served;
+    last_wait_us_ = wait_us;
+    if (next != active) {
+        dispatcher_.setActiveCount(next);
+        logInfo("WorkerScaler", "active workers $0 -> $1", active, next);
+    }
+    return next;
+}
+
+void
+WorkerScaler::scaleLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        cond_.wait_for(lock, conf_.interval_);
+        if (stop_) {
+            break;
+        }
+        lock.unlock();
+        adjust();
+        lock.lock();
+    }
+}
+
+};
+};
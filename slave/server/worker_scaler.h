@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <kea/server/admission_queue.h>
+#include <kea/server/pkt_dispatcher.h>
+
+namespace kea {
+namespace server {
+
+struct WorkerScalerConf {
+    uint32_t min_workers_;
+    uint32_t max_workers_;
+    // average wait in the input queues over one interval, above grow_wait_
+    // a worker is added, below shrink_wait_ one is parked
+    std::chrono::microseconds grow_wait_;
+    std::chrono::microseconds shrink_wait_;
+    std::chrono::milliseconds interval_;
+
+    WorkerScalerConf()
+        : min_workers_(1), max_workers_(1), grow_wait_(5000), shrink_wait_(500), interval_(1000) {}
+};
+
+//moves the number of active workers within bounds by how long queries
+//wait before a worker takes them. every worker up to max is started with
+//the server, so scaling only changes how many of them the dispatcher
+//spreads clients over, one step per interval
+class WorkerScaler {
+public:
+    WorkerScaler(const WorkerScalerConf& conf, PktDispatcher& dispatcher,
+                 std::vector<AdmissionQueue*> queues);
+    ~WorkerScaler();
+
+    void start();
+    void stop();
+
+    // active worker count for the next interval, given the queries served
+    // and the time they waited in total during the last one
+    size_t decide(size_t active, uint64_t served, uint64_t wait_us) const;
+    // sample the queues and apply decide, returns the new active count
+    size_t adjust();
+
+private:
+    void scaleLoop();
+
+    WorkerScalerConf conf_;
+    PktDispatcher& dispatcher_;
+    std::vector<AdmissionQueue*> queues_;
+    uint64_t last_served_;
+    uint64_t last_wait_us_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool stop_;
+    std::thread scale_thread_;
+};
+
+};
+};
@@ -1,5 +1,6 @@
 #include <kea/statistics/pkt_statistic.h>
 #include <kea/logging/logging.h>
+#include <kea/util/thread_affinity.h>
 
 using namespace kea::logging;
 
@@ -12,7 +13,10 @@ static Statistics *SingletonStatis = nullptr;
 Statistics::Statistics() : started_(true), discover_(0), offer_(0), request_(0), ack_(0), lps_("0 0 0 0") {
     try {
         fp_.open("/usr/local/zddi/dhcp/db/dhcpd.actives", ofstream::app);
-        output_thr_ = new thread(&Statistics::count_proc, this);
+        output_thr_ = new thread([this]() {
+            kea::util::ThreadAffinity::instance().pinCurrent(kea::util::TC_STATISTICS);
+            this->count_proc();
+        });
     }
     catch (const std::exception& ex) {
         started_ = false;
@@ -76,6 +80,16 @@ Statistics::count_recv(Pkt* query) {
     return 0;
 }
 
+void
+Statistics::count_recv(uint32_t discovers, uint32_t requests) {
+    if (discovers != 0) {
+        discover_ += discovers;
+    }
+    if (requests != 0) {
+        request_ += requests;
+    }
+}
+
 int 
 Statistics::count_send(Pkt* query, Pkt* rsp) {
     try {
@@ -27,6 +27,8 @@ class Statistics : public kea::controller::CmdHandler{
 
         void stop(); 
         int count_recv(Pkt* query);
+        // counts of a batch of queries at once
+        void count_recv(uint32_t discovers, uint32_t requests);
         int count_send(Pkt* query, Pkt* rsp);
         static Statistics& instance();
         static void init();
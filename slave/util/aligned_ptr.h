@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace kea {
+namespace util {
+
+//operator new of c++11 only guarantees alignof(max_align_t), a type with
+//cache line aligned members put on the heap has to go through here
+template<typename T>
+struct AlignedDelete {
+    void operator()(T* ptr) const {
+        ptr->~T();
+        free(ptr);
+    }
+};
+
+template<typename T>
+using AlignedPtr = std::unique_ptr<T, AlignedDelete<T>>;
+
+template<typename T, typename... Args>
+AlignedPtr<T> makeAligned(Args&&... args) {
+    size_t alignment = alignof(T) < sizeof(void*) ? sizeof(void*) : alignof(T);
+    void* mem = nullptr;
+    if (posix_memalign(&mem, alignment, sizeof(T)) != 0) {
+        throw std::bad_alloc();
+    }
+    try {
+        return AlignedPtr<T>(new (mem) T(std::forward<Args>(args)...));
+    } catch (...) {
+        free(mem);
+        throw;
+    }
+}
+
+};
+};
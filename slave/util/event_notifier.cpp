@@ -0,0 +1,49 @@
+#include <kea/util/event_notifier.h>
+#include <kea/exceptions/exceptions.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+namespace kea {
+namespace util {
+
+EventNotifier::EventNotifier() {
+    sleeping_.store(false);
+    fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd_ < 0) {
+        kea_throw(Unexpected, "create eventfd failed: " << strerror(errno));
+    }
+}
+
+EventNotifier::~EventNotifier() {
+    close(fd_);
+}
+
+void
+EventNotifier::notify() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping_.load(std::memory_order_relaxed)) {
+        uint64_t one = 1;
+        ssize_t n = write(fd_, &one, sizeof(one));
+        (void)n;
+    }
+}
+
+void
+EventNotifier::waitFd(int timeout_ms) {
+    struct pollfd pfd;
+    pfd.fd = fd_;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (poll(&pfd, 1, timeout_ms) > 0) {
+        uint64_t count;
+        ssize_t n = read(fd_, &count, sizeof(count));
+        (void)n;
+    }
+}
+
+};
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+
+namespace kea {
+namespace util {
+
+//wakes one consumer thread sleeping on an eventfd until any of the queues
+//it reads has work. the consumer announces it's going to sleep, checks its
+//queues once more and only then waits on the fd, so producers pay a
+//syscall only when the consumer really sleeps and no wakeup is lost
+class EventNotifier {
+public:
+    EventNotifier();
+    ~EventNotifier();
+
+    EventNotifier(const EventNotifier&) = delete;
+    EventNotifier& operator=(const EventNotifier&) = delete;
+
+    // producer side, after the work is published
+    void notify();
+
+    // consumer side, returns at once if ready() holds after the consumer is
+    // marked sleeping, otherwise once notified or after timeout_ms, -1
+    // waits forever. ready() may be true on return without a notify
+    template <typename Ready>
+    void wait(Ready ready, int timeout_ms = -1) {
+        sleeping_.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!ready()) {
+            waitFd(timeout_ms);
+        }
+        sleeping_.store(false, std::memory_order_relaxed);
+    }
+
+    int getFd() const { return fd_; }
+
+private:
+    void waitFd(int timeout_ms);
+
+    int fd_;
+    std::atomic<bool> sleeping_;
+};
+
+};
+};
@@ -60,6 +60,26 @@ public:
 		}
 	}
 	
+	bool erase(const key_t& key) {
+		auto it = cache_items_map_.find(key);
+		if (it == cache_items_map_.end()) {
+			return false;
+		}
+		cache_items_list_.erase(it->second);
+		cache_items_map_.erase(it);
+		return true;
+	}
+
+	void clear() {
+		cache_items_map_.clear();
+		cache_items_list_.clear();
+	}
+
+	// the item the next put of a new key pushes out once the cache is full
+	const key_value_pair_t* oldest() const {
+		return cache_items_list_.empty() ? nullptr : &cache_items_list_.back();
+	}
+
 	bool exists(const key_t& key) const {
 		return cache_items_map_.find(key) != cache_items_map_.end();
 	}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <kea/util/spsc_ring.h>
+
+namespace kea {
+namespace util {
+
+//bounded ring with any number of producer threads and one consumer thread.
+//every slot carries a sequence number telling whose turn it is, producers
+//claim a position with one compare and swap and publish the slot by
+//advancing its sequence, the consumer never writes a shared position
+template <typename T>
+class MpscRing {
+public:
+    // a single slot can't tell a filled slot from the next free one, so
+    // there are at least two
+    explicit MpscRing(size_t capacity)
+        : mask_(ringCapacity(capacity < 2 ? 2 : capacity) - 1),
+          slots_(new Slot[mask_ + 1]),
+          head_(0), tail_(0) {
+        for (size_t i = 0; i <= mask_; i++) {
+            slots_[i].seq_.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    // producer side, any thread
+    bool write(T&& item) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &slots_[pos & mask_];
+            size_t seq = slot->seq_.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->item_ = std::move(item);
+        slot->seq_.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer side
+    bool read(T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[head & mask_];
+        if (slot.seq_.load(std::memory_order_acquire) != head + 1) {
+            return false;
+        }
+        item = std::move(slot.item_);
+        slot.seq_.store(head + mask_ + 1, std::memory_order_release);
+        head_.store(head + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    size_t readBatch(T* items, size_t max_count) {
+        size_t count = 0;
+        while (count < max_count && read(items[count])) {
+            count++;
+        }
+        return count;
+    }
+
+    // a guess while producers are running
+    bool isEmpty() const {
+        size_t head = head_.load(std::memory_order_relaxed);
+        return slots_[head & mask_].seq_.load(std::memory_order_acquire) != head + 1;
+    }
+    // positions claimed by producers but not read yet, any thread
+    size_t size() const {
+        size_t head = head_.load(std::memory_order_relaxed);
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    struct Slot {
+        std::atomic<size_t> seq_;
+        T item_;
+    };
+
+    const size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    // only written by the consumer
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_;
+};
+
+};
+};
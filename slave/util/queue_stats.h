@@ -0,0 +1,35 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+namespace kea {
+namespace util {
+
+struct QueueStats {
+    std::string name_;
+    size_t depth_;
+    size_t high_water_;
+};
+
+//highest depth a queue reached, raised by producers after they queued
+//something. it only costs a compare and swap when the mark moves
+class HighWaterMark {
+public:
+    HighWaterMark() : mark_(0) {}
+
+    void update(size_t depth) {
+        size_t mark = mark_.load(std::memory_order_relaxed);
+        while (depth > mark && !mark_.compare_exchange_weak(mark, depth, std::memory_order_relaxed)) {
+        }
+    }
+
+    size_t get() const { return mark_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<size_t> mark_;
+};
+
+};
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace kea {
+namespace util {
+
+// rounded up to a power of two so positions wrap with a mask
+inline size_t ringCapacity(size_t capacity) {
+    size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+//bounded ring between exactly one producer thread and one consumer thread.
+//each side owns one position and only reads the other one when its cached
+//copy says the ring looks full or empty, so a push or pop is a plain store
+//in the common case
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity)
+        : mask_(ringCapacity(capacity) - 1),
+          slots_(new T[mask_ + 1]),
+          head_(0), cached_tail_(0),
+          tail_(0), cached_head_(0) {
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // producer side
+    bool write(T&& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = std::move(item);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // moves items out as long as there is room, returns how many
+    size_t writeBatch(T* items, size_t count) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (mask_ + 1 - (tail - cached_head_) < count) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+        }
+        size_t room = mask_ + 1 - (tail - cached_head_);
+        size_t written = count < room ? count : room;
+        for (size_t i = 0; i < written; i++) {
+            slots_[(tail + i) & mask_] = std::move(items[i]);
+        }
+        tail_.store(tail + written, std::memory_order_release);
+        return written;
+    }
+
+    // consumer side
+    bool read(T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        item = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t readBatch(T* items, size_t max_count) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (cached_tail_ - head < max_count) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+        }
+        size_t ready = cached_tail_ - head;
+        size_t count = max_count < ready ? max_count : ready;
+        for (size_t i = 0; i < count; i++) {
+            items[i] = std::move(slots_[(head + i) & mask_]);
+        }
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // either side, a guess while the other side is running
+    bool isEmpty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+    size_t size() const {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire);
+    }
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    const size_t mask_;
+    std::unique_ptr<T[]> slots_;
+    // written by the consumer
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_;
+    size_t cached_tail_;
+    // written by the producer
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_;
+    size_t cached_head_;
+};
+
+};
+};
@@ -18,6 +18,26 @@ TEST(LruCacheTest, MissingValue) {
     EXPECT_THROW(cache.get(7), std::range_error);
 }
 
+TEST(LruCacheTest, Erase) {
+    LruCache<int, int> cache(2);
+    cache.put(1, 111);
+    cache.put(2, 222);
+    EXPECT_TRUE(cache.erase(1));
+    EXPECT_FALSE(cache.erase(1));
+    EXPECT_FALSE(cache.exists(1));
+    EXPECT_EQ(1, cache.size());
+
+    cache.put(3, 333);
+    cache.put(4, 444);
+    EXPECT_FALSE(cache.exists(2));
+    EXPECT_TRUE(cache.exists(3));
+    EXPECT_TRUE(cache.exists(4));
+
+    cache.clear();
+    EXPECT_EQ(0, cache.size());
+    EXPECT_FALSE(cache.exists(3));
+}
+
 TEST(LruCacheTest1, KeepsAllValuesWithinCapacity) {
     int cap = 100;
     LruCache<int, int> cache(cap);
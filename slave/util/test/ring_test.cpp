@@ -0,0 +1,165 @@
+#include <kea/util/spsc_ring.h>
+#include <kea/util/mpsc_ring.h>
+#include <kea/util/event_notifier.h>
+#include <kea/util/aligned_ptr.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace kea{
+
+using namespace kea::util;
+
+TEST(RingTest, capacity) {
+    EXPECT_EQ(1, ringCapacity(1));
+    EXPECT_EQ(8, ringCapacity(5));
+    EXPECT_EQ(1024, ringCapacity(1000));
+    EXPECT_EQ(1024, ringCapacity(1024));
+}
+
+TEST(RingTest, alignedHeap) {
+    std::vector<AlignedPtr<SpscRing<int>>> rings;
+    for (int i = 0; i < 16; i++) {
+        rings.push_back(makeAligned<SpscRing<int>>(4));
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(rings.back().get()) % alignof(SpscRing<int>));
+        EXPECT_EQ(4, rings.back()->capacity());
+    }
+}
+
+TEST(RingTest, spscFull) {
+    SpscRing<std::unique_ptr<int>> ring(4);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(ring.write(std::unique_ptr<int>(new int(i))));
+    }
+    std::unique_ptr<int> item(new int(4));
+    EXPECT_FALSE(ring.write(std::move(item)));
+    // a failed write leaves the item to the caller
+    ASSERT_TRUE(item != nullptr);
+    EXPECT_EQ(4, ring.size());
+
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(ring.read(item));
+        EXPECT_EQ(i, *item);
+    }
+    EXPECT_FALSE(ring.read(item));
+    EXPECT_TRUE(ring.isEmpty());
+}
+
+TEST(RingTest, spscBatch) {
+    SpscRing<int> ring(8);
+    int items[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    EXPECT_EQ(8, ring.writeBatch(items, 10));
+
+    int out[10];
+    EXPECT_EQ(3, ring.readBatch(out, 3));
+    EXPECT_EQ(2, out[2]);
+    // wraps around the end of the ring
+    EXPECT_EQ(2, ring.writeBatch(items + 8, 2));
+    EXPECT_EQ(7, ring.readBatch(out, 10));
+    EXPECT_EQ(3, out[0]);
+    EXPECT_EQ(9, out[6]);
+}
+
+TEST(RingTest, spscThreads) {
+    const size_t count = 20000;
+    SpscRing<size_t> ring(64);
+    std::thread producer([&]() {
+        for (size_t i = 0; i < count; i++) {
+            size_t item = i;
+            while (!ring.write(std::move(item))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    size_t expected = 0;
+    size_t items[16];
+    while (expected < count) {
+        size_t read = ring.readBatch(items, 16);
+        for (size_t i = 0; i < read; i++) {
+            ASSERT_EQ(expected++, items[i]);
+        }
+    }
+    producer.join();
+}
+
+TEST(RingTest, mpscFull) {
+    MpscRing<int> ring(1);
+    EXPECT_EQ(2, ring.capacity());
+    EXPECT_TRUE(ring.write(1));
+    EXPECT_TRUE(ring.write(2));
+    EXPECT_FALSE(ring.write(3));
+
+    int item;
+    ASSERT_TRUE(ring.read(item));
+    EXPECT_EQ(1, item);
+    EXPECT_TRUE(ring.write(3));
+    ASSERT_TRUE(ring.read(item));
+    ASSERT_TRUE(ring.read(item));
+    EXPECT_EQ(3, item);
+    EXPECT_FALSE(ring.read(item));
+}
+
+TEST(RingTest, mpscThreads) {
+    const size_t producer_count = 4;
+    const size_t count = 10000;
+    MpscRing<size_t> ring(128);
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p < producer_count; p++) {
+        producers.push_back(std::thread([&ring, p, count]() {
+            for (size_t i = 0; i < count; i++) {
+                size_t item = p * count + i;
+                while (!ring.write(std::move(item))) {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+
+    // every producer's items come out in the order it wrote them
+    std::vector<size_t> next(producer_count, 0);
+    size_t total = 0;
+    size_t items[16];
+    while (total < producer_count * count) {
+        size_t read = ring.readBatch(items, 16);
+        for (size_t i = 0; i < read; i++) {
+            size_t p = items[i] / count;
+            ASSERT_EQ(next[p]++, items[i] % count);
+        }
+        total += read;
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(ring.isEmpty());
+}
+
+TEST(RingTest, notifier) {
+    const size_t count = 10000;
+    MpscRing<size_t> ring(16);
+    EventNotifier notifier;
+    std::thread producer([&]() {
+        for (size_t i = 0; i < count; i++) {
+            size_t item = i;
+            while (!ring.write(std::move(item))) {
+                std::this_thread::yield();
+            }
+            notifier.notify();
+        }
+    });
+
+    // no wakeup is lost while the consumer sleeps between items
+    size_t expected = 0;
+    size_t item;
+    while (expected < count) {
+        if (ring.read(item)) {
+            ASSERT_EQ(expected++, item);
+        } else {
+            notifier.wait([&]() { return !ring.isEmpty(); });
+        }
+    }
+    producer.join();
+}
+
+};
@@ -0,0 +1,78 @@
+#include <kea/util/thread_affinity.h>
+#include <kea/exceptions/exceptions.h>
+#include <gtest/gtest.h>
+#include <sched.h>
+#include <thread>
+
+namespace kea{
+
+using namespace kea::util;
+
+std::vector<int> getCurrentCpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    sched_getaffinity(0, sizeof(set), &set);
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &set)) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+TEST(ThreadAffinityTest, parseCpuList) {
+    EXPECT_EQ(std::vector<int>({3}), parseCpuList("3"));
+    EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 8}), parseCpuList("8, 0-3"));
+    EXPECT_EQ(std::vector<int>({1, 2}), parseCpuList("1,1-2"));
+
+    EXPECT_THROW(parseCpuList(""), BadValue);
+    EXPECT_THROW(parseCpuList("a"), BadValue);
+    EXPECT_THROW(parseCpuList("3-1"), BadValue);
+    EXPECT_THROW(parseCpuList("1-2-3"), BadValue);
+    EXPECT_THROW(parseCpuList("-1"), BadValue);
+    EXPECT_THROW(parseCpuList("100000"), BadValue);
+}
+
+TEST(ThreadAffinityTest, pin) {
+    ThreadAffinity& affinity = ThreadAffinity::instance();
+    std::vector<int> process_cpus = getCurrentCpus();
+    ASSERT_FALSE(process_cpus.empty());
+    int last_cpu = process_cpus.back();
+
+    // nothing configured leaves threads alone
+    affinity.clear();
+    std::thread([&]() {
+        affinity.pinCurrent(TC_RX);
+        EXPECT_EQ(process_cpus, getCurrentCpus());
+    }).join();
+
+    affinity.setCpus(TC_WORKER, process_cpus);
+    affinity.setCpus(TC_RX, std::vector<int>(1, last_cpu));
+    std::thread([&]() {
+        affinity.pinCurrent(TC_WORKER, static_cast<int>(process_cpus.size()) - 1);
+        EXPECT_EQ(std::vector<int>(1, last_cpu), getCurrentCpus());
+        // a class without a set floats over every cpu again
+        affinity.pinCurrent(TC_TX);
+        EXPECT_EQ(process_cpus, getCurrentCpus());
+        affinity.pinCurrent(TC_RX);
+        EXPECT_EQ(std::vector<int>(1, last_cpu), getCurrentCpus());
+    }).join();
+
+    EXPECT_EQ(-1, affinity.getNumaNode(TC_TX));
+    EXPECT_EQ(ThreadAffinity::getCpuNode(last_cpu), affinity.getNumaNode(TC_RX));
+    affinity.clear();
+}
+
+TEST(ThreadAffinityTest, numaPreferred) {
+    int node = ThreadAffinity::getCpuNode(getCurrentCpus().front());
+    std::thread([node]() {
+        NumaPreferred no_node(-1);
+        NumaPreferred local(node);
+        std::unique_ptr<char[]> buf(new char[4096]);
+        buf[0] = 1;
+        EXPECT_EQ(1, buf[0]);
+    }).join();
+}
+
+};
@@ -0,0 +1,200 @@
+#include <kea/util/thread_affinity.h>
+#include <kea/util/strutil.h>
+#include <kea/exceptions/exceptions.h>
+#include <kea/logging/logging.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+using namespace kea::logging;
+
+namespace kea {
+namespace util {
+
+// from linux/mempolicy.h, which libc doesn't wrap
+static const int MPOL_DEFAULT_POLICY = 0;
+static const int MPOL_PREFERRED_POLICY = 1;
+
+static int
+parseCpu(const std::string& text) {
+    if (text.empty() || text.size() > 4 ||
+        std::find_if(text.begin(), text.end(), [](char c) { return !isdigit(c); }) != text.end()) {
+        kea_throw(BadValue, "invalid cpu: \"" << text << "\"");
+    }
+    int cpu = std::stoi(text);
+    if (cpu >= CPU_SETSIZE) {
+        kea_throw(BadValue, "cpu " << cpu << " is out of range");
+    }
+    return cpu;
+}
+
+std::vector<int>
+parseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    for (auto& token : str::tokens(text, ",")) {
+        std::string range = str::trim(token);
+        size_t dash = range.find('-');
+        if (dash == std::string::npos) {
+            cpus.push_back(parseCpu(range));
+            continue;
+        }
+
+        int first = parseCpu(range.substr(0, dash));
+        int last = parseCpu(range.substr(dash + 1));
+        if (first > last) {
+            kea_throw(BadValue, "invalid cpu range: \"" << range << "\"");
+        }
+        for (int cpu = first; cpu <= last; cpu++) {
+            cpus.push_back(cpu);
+        }
+    }
+
+    if (cpus.empty()) {
+        kea_throw(BadValue, "empty cpu list");
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+ThreadAffinity&
+ThreadAffinity::instance() {
+    static ThreadAffinity affinity;
+    return affinity;
+}
+
+ThreadAffinity::ThreadAffinity() {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &set)) {
+                process_cpus_.push_back(cpu);
+            }
+        }
+    }
+}
+
+void
+ThreadAffinity::setCpus(ThreadClass thread_class, const std::vector<int>& cpus) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cpus_[thread_class] = cpus;
+}
+
+std::vector<int>
+ThreadAffinity::getCpus(ThreadClass thread_class) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cpus_[thread_class];
+}
+
+void
+ThreadAffinity::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& cpus : cpus_) {
+        cpus.clear();
+    }
+}
+
+bool
+ThreadAffinity::hasAnySet() const {
+    for (auto& cpus : cpus_) {
+        if (!cpus.empty()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+ThreadAffinity::pinCurrent(ThreadClass thread_class, int index) const {
+    std::vector<int> cpus;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!hasAnySet()) {
+            return;
+        }
+        cpus = cpus_[thread_class].empty() ? process_cpus_ : cpus_[thread_class];
+        if (index >= 0 && thread_class == TC_WORKER && !cpus_[thread_class].empty()) {
+            cpus = std::vector<int>(1, cpus[index % cpus.size()]);
+        }
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (err != 0) {
+        logError("Affinity  ", "!!!pin thread of class $0 failed: $1", static_cast<int>(thread_class), strerror(err));
+    }
+}
+
+int
+ThreadAffinity::getNumaNode(ThreadClass thread_class, int index) const {
+    std::vector<int> cpus = getCpus(thread_class);
+    if (cpus.empty()) {
+        return -1;
+    }
+    if (index >= 0 && thread_class == TC_WORKER) {
+        return getCpuNode(cpus[index % cpus.size()]);
+    }
+
+    int node = getCpuNode(cpus[0]);
+    for (int cpu : cpus) {
+        if (getCpuNode(cpu) != node) {
+            return -1;
+        }
+    }
+    return node;
+}
+
+int
+ThreadAffinity::getCpuNode(int cpu) {
+    std::string path = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    DIR* dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        return -1;
+    }
+
+    int node = -1;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (strncmp(entry->d_name, "node", 4) == 0 && isdigit(entry->d_name[4])) {
+            node = atoi(entry->d_name + 4);
+            break;
+        }
+    }
+    closedir(dir);
+    return node;
+}
+
+NumaPreferred::NumaPreferred(int node) : applied_(false) {
+    unsigned long mask = 1;
+    if (node < 0 || node >= static_cast<int>(sizeof(mask) * 8)) {
+        return;
+    }
+
+    mask <<= node;
+    if (syscall(SYS_set_mempolicy, MPOL_PREFERRED_POLICY, &mask, sizeof(mask) * 8 + 1) == 0) {
+        applied_ = true;
+    } else {
+        logError("Affinity  ", "!!!prefer numa node $0 failed: $1", node, strerror(errno));
+    }
+}
+
+NumaPreferred::~NumaPreferred() {
+    if (applied_) {
+        syscall(SYS_set_mempolicy, MPOL_DEFAULT_POLICY, nullptr, 0);
+    }
+}
+
+};
+};
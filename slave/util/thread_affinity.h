@@ -0,0 +1,68 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace kea {
+namespace util {
+
+enum ThreadClass {
+    TC_RX,
+    TC_TX,
+    TC_WORKER,
+    TC_RPC,
+    TC_PING,
+    TC_STATISTICS,
+    TC_CONTROL,
+    TC_COUNT
+};
+
+// "0-3,8,10-11" into sorted cpu ids, throws BadValue on a malformed list
+std::vector<int> parseCpuList(const std::string& text);
+
+//cpu sets every class of slave threads is placed on. each thread pins
+//itself when it starts, a class without a set floats over the cpus the
+//process started with, so it doesn't inherit the set of whoever created it
+class ThreadAffinity {
+public:
+    static ThreadAffinity& instance();
+
+    void setCpus(ThreadClass thread_class, const std::vector<int>& cpus);
+    std::vector<int> getCpus(ThreadClass thread_class) const;
+    void clear();
+
+    // workers go to one cpu each round robin by index, other classes take
+    // their whole set
+    void pinCurrent(ThreadClass thread_class, int index = -1) const;
+    // numa node the thread with index is placed on, -1 if it floats
+    int getNumaNode(ThreadClass thread_class, int index = -1) const;
+
+    static int getCpuNode(int cpu);
+
+private:
+    ThreadAffinity();
+    bool hasAnySet() const;
+
+    mutable std::mutex mutex_;
+    std::vector<int> cpus_[TC_COUNT];
+    std::vector<int> process_cpus_;
+};
+
+//allocations of the calling thread prefer node while it lives, so memory a
+//worker owns can be built on its node before the worker starts. a negative
+//node does nothing
+class NumaPreferred {
+public:
+    explicit NumaPreferred(int node);
+    ~NumaPreferred();
+
+    NumaPreferred(const NumaPreferred&) = delete;
+    NumaPreferred& operator=(const NumaPreferred&) = delete;
+
+private:
+    bool applied_;
+};
+
+};
+};